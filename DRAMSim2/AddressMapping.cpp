@@ -33,18 +33,18 @@
 namespace DRAMSim
 {
 
-void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsigned &newTransactionRank, unsigned &newTransactionBank, unsigned &newTransactionRow, unsigned &newTransactionColumn)
+void addressMapping(const Config &config, uint64_t physicalAddress, unsigned &newTransactionChan, unsigned &newTransactionRank, unsigned &newTransactionBank, unsigned &newTransactionRow, unsigned &newTransactionColumn)
 {
 	uint64_t tempA, tempB;
-	unsigned transactionSize = TRANSACTION_SIZE;
+	unsigned transactionSize = config.TRANSACTION_SIZE;
 	uint64_t transactionMask =  transactionSize - 1; //ex: (64 bit bus width) x (8 Burst Length) - 1 = 64 bytes - 1 = 63 = 0x3f mask
-	unsigned channelBitWidth = NUM_CHANS_LOG;
-	unsigned rankBitWidth = NUM_RANKS_LOG;
-	unsigned bankBitWidth = NUM_BANKS_LOG;
-	unsigned rowBitWidth = NUM_ROWS_LOG;
-	unsigned colBitWidth = NUM_COLS_LOG;
+	unsigned channelBitWidth = config.NUM_CHANS_LOG;
+	unsigned rankBitWidth = config.NUM_RANKS_LOG;
+	unsigned bankBitWidth = config.NUM_BANKS_LOG;
+	unsigned rowBitWidth = config.NUM_ROWS_LOG;
+	unsigned colBitWidth = config.NUM_COLS_LOG;
 	// this forces the alignment to the width of a single burst (64 bits = 8 bytes = 3 address bits for DDR parts)
-	unsigned byteOffsetWidth = BYTE_OFFSET_WIDTH;
+	unsigned byteOffsetWidth = config.BYTE_OFFSET_WIDTH;
 	// Since we're assuming that a request is for BL*BUS_WIDTH, the bottom bits
 	// of this address *should* be all zeros if it's not, issue a warning
 
@@ -74,11 +74,11 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 	// from the bottom bits of the column 
 	// 
 	// For example: cowLowBits = log2(64bytes) - 3 bits = 3 bits 
-	unsigned colLowBitWidth = COL_LOW_BIT_WIDTH;
+	unsigned colLowBitWidth = config.COL_LOW_BIT_WIDTH;
 
 	physicalAddress >>= colLowBitWidth;
 	unsigned colHighBitWidth = colBitWidth - colLowBitWidth; 
-	if (DEBUG_ADDR_MAP)
+	if (config.DEBUG_ADDR_MAP)
 	{
 		DEBUG("Bit widths: ch:"<<channelBitWidth<<" r:"<<rankBitWidth<<" b:"<<bankBitWidth
 				<<" row:"<<rowBitWidth<<" colLow:"<<colLowBitWidth
@@ -87,7 +87,7 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 	}
 
 	//perform various address mapping schemes
-	if (addressMappingScheme == Scheme1)
+	if (config.addressMappingScheme == Scheme1)
 	{
 		//chan:rank:row:col:bank
 		tempA = physicalAddress;
@@ -116,7 +116,7 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 		newTransactionChan = tempA ^ tempB;
 
 	}
-	else if (addressMappingScheme == Scheme2)
+	else if (config.addressMappingScheme == Scheme2)
 	{
 		//chan:row:col:bank:rank
 		tempA = physicalAddress;
@@ -145,7 +145,7 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 		newTransactionChan = tempA ^ tempB;
 
 	}
-	else if (addressMappingScheme == Scheme3)
+	else if (config.addressMappingScheme == Scheme3)
 	{
 		//chan:rank:bank:col:row
 		tempA = physicalAddress;
@@ -174,7 +174,7 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 		newTransactionChan = tempA ^ tempB;
 
 	}
-	else if (addressMappingScheme == Scheme4)
+	else if (config.addressMappingScheme == Scheme4)
 	{
 		//chan:rank:bank:row:col
 		tempA = physicalAddress;
@@ -203,7 +203,7 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 		newTransactionChan = tempA ^ tempB;
 
 	}
-	else if (addressMappingScheme == Scheme5)
+	else if (config.addressMappingScheme == Scheme5)
 	{
 		//chan:row:col:rank:bank
 
@@ -234,7 +234,7 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 
 
 	}
-	else if (addressMappingScheme == Scheme6)
+	else if (config.addressMappingScheme == Scheme6)
 	{
 		//chan:row:bank:rank:col
 
@@ -266,7 +266,7 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 
 	}
 	// clone of scheme 5, but channel moved to lower bits
-	else if (addressMappingScheme == Scheme7)
+	else if (config.addressMappingScheme == Scheme7)
 	{
 		//row:col:rank:bank:chan
 		tempA = physicalAddress;
@@ -301,7 +301,7 @@ void addressMapping(uint64_t physicalAddress, unsigned &newTransactionChan, unsi
 		ERROR("== Error - Unknown Address Mapping Scheme");
 		exit(-1);
 	}
-	if (DEBUG_ADDR_MAP)
+	if (config.DEBUG_ADDR_MAP)
 	{
 		DEBUG("Mapped Ch="<<newTransactionChan<<" Rank="<<newTransactionRank
 				<<" Bank="<<newTransactionBank<<" Row="<<newTransactionRow
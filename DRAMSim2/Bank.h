@@ -62,7 +62,7 @@ class Bank
 
 public:
 	//functions
-	Bank(ostream &dramsim_log_);
+	Bank(const Config &config_, ostream &dramsim_log_);
 	void read(BusPacket *busPacket);
 	void write(const BusPacket *busPacket);
 
@@ -71,6 +71,7 @@ public:
 
 private:
 	// private member
+	const Config &config;
 	std::vector<DataStruct *> rowEntries;
 	ostream &dramsim_log; 
 
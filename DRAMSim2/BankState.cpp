@@ -59,6 +59,20 @@ BankState::BankState(ostream &dramsim_log_):
 		stateChangeCountdown(0)
 {}
 
+//Back to the initial precharged state
+void BankState::reset()
+{
+	currentBankState = Idle;
+	openRowAddress = 0;
+	nextRead = 0;
+	nextWrite = 0;
+	nextActivate = 0;
+	nextPrecharge = 0;
+	nextPowerUp = 0;
+	lastCommand = READ;
+	stateChangeCountdown = 0;
+}
+
 void BankState::print()
 {
 	PRINT(" == Bank State ");
@@ -76,6 +76,7 @@ public:
 	//Functions
 	BankState(ostream &dramsim_log_);
 	void print();
+	void reset();
 };
 }
 
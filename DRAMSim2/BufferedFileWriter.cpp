@@ -0,0 +1,178 @@
+/*********************************************************************************
+*  Copyright (c) 2010-2011, Elliott Cooper-Balis
+*                             Paul Rosenfeld
+*                             Bruce Jacob
+*                             University of Maryland 
+*                             dramninjas [at] gmail [dot] com
+*  All rights reserved.
+*  
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*  
+*     * Redistributions of source code must retain the above copyright notice,
+*        this list of conditions and the following disclaimer.
+*  
+*     * Redistributions in binary form must reproduce the above copyright notice,
+*        this list of conditions and the following disclaimer in the documentation
+*        and/or other materials provided with the distribution.
+*  
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+*  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+*  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************************/
+
+//BufferedFileWriter.cpp
+//
+//Class file for the output file stream written by a background thread
+//
+
+#include "BufferedFileWriter.h"
+
+using namespace DRAMSim;
+
+AsyncFileBuffer::AsyncFileBuffer(size_t bufferSize_, size_t maxPending_) :
+	bufferSize(bufferSize_),
+	maxPending(maxPending_),
+	file(NULL),
+	stopping(false)
+{
+}
+
+AsyncFileBuffer::~AsyncFileBuffer()
+{
+	close();
+}
+
+bool AsyncFileBuffer::open(const char *path)
+{
+	close();
+	file = fopen(path, "w");
+	if (!file)
+		return false;
+
+	active.resize(bufferSize);
+	setp(active.data(), active.data() + active.size());
+	stopping = false;
+	writer = std::thread(&AsyncFileBuffer::writerLoop, this);
+	return true;
+}
+
+bool AsyncFileBuffer::is_open() const
+{
+	return file != NULL;
+}
+
+void AsyncFileBuffer::close()
+{
+	if (!file)
+		return;
+
+	handOff();
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	cond.notify_all();
+	writer.join();
+
+	fclose(file);
+	file = NULL;
+	setp(NULL, NULL);
+}
+
+//pass the filled part of the active buffer to the writer thread and continue on a spare one
+void AsyncFileBuffer::handOff()
+{
+	if (pptr() == pbase())
+		return;
+
+	active.resize(pptr() - pbase());
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		// the writer is behind, wait instead of holding more buffers
+		cond.wait(guard, [this] { return pending.size() < maxPending; });
+		pending.push_back(std::vector<char>());
+		pending.back().swap(active);
+		if (!spare.empty())
+		{
+			active.swap(spare.back());
+			spare.pop_back();
+		}
+	}
+	cond.notify_all();
+
+	active.resize(bufferSize);
+	setp(active.data(), active.data() + active.size());
+}
+
+void AsyncFileBuffer::writerLoop()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	while (true)
+	{
+		cond.wait(guard, [this] { return stopping || !pending.empty(); });
+		if (pending.empty())
+			return;
+
+		std::vector<char> data;
+		data.swap(pending.front());
+		pending.pop_front();
+		cond.notify_all();
+
+		guard.unlock();
+		fwrite(data.data(), 1, data.size(), file);
+		guard.lock();
+
+		spare.push_back(std::vector<char>());
+		spare.back().swap(data);
+	}
+}
+
+AsyncFileBuffer::int_type AsyncFileBuffer::overflow(int_type c)
+{
+	if (!file)
+		return traits_type::eof();
+
+	handOff();
+	if (!traits_type::eq_int_type(c, traits_type::eof()))
+	{
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+int AsyncFileBuffer::sync()
+{
+	// flushes are only hints, the buffers are written when full or on close
+	return 0;
+}
+
+BufferedFileWriter::BufferedFileWriter() : std::ostream(&buffer)
+{
+}
+
+void BufferedFileWriter::open(const char *path)
+{
+	if (buffer.open(path))
+		clear();
+	else
+		setstate(std::ios_base::failbit);
+}
+
+bool BufferedFileWriter::is_open() const
+{
+	return buffer.is_open();
+}
+
+void BufferedFileWriter::close()
+{
+	buffer.close();
+}
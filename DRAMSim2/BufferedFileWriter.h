@@ -0,0 +1,94 @@
+/*********************************************************************************
+*  Copyright (c) 2010-2011, Elliott Cooper-Balis
+*                             Paul Rosenfeld
+*                             Bruce Jacob
+*                             University of Maryland 
+*                             dramninjas [at] gmail [dot] com
+*  All rights reserved.
+*  
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*  
+*     * Redistributions of source code must retain the above copyright notice,
+*        this list of conditions and the following disclaimer.
+*  
+*     * Redistributions in binary form must reproduce the above copyright notice,
+*        this list of conditions and the following disclaimer in the documentation
+*        and/or other materials provided with the distribution.
+*  
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+*  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+*  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************************/
+
+#ifndef BUFFEREDFILEWRITER_H
+#define BUFFEREDFILEWRITER_H
+
+//BufferedFileWriter.h
+//
+//Header file for an output file stream written by a background thread
+//	The data is collected in large buffers that are handed to the writer thread
+//	when they fill up, so the simulation never waits for the disk. Flushes
+//	(i.e. std::endl) do not write anything, the rest is written on close()
+//
+
+#include <cstdio>
+#include <ostream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace DRAMSim
+{
+class AsyncFileBuffer : public std::streambuf
+{
+	size_t bufferSize;
+	size_t maxPending;
+	FILE *file;
+	std::vector<char> active;
+	std::deque<std::vector<char> > pending;
+	std::vector<std::vector<char> > spare;
+	bool stopping;
+	std::mutex lock;
+	std::condition_variable cond;
+	std::thread writer;
+
+	void handOff();
+	void writerLoop();
+
+protected:
+	int_type overflow(int_type c);
+	int sync();
+
+public:
+	AsyncFileBuffer(size_t bufferSize_ = 1 << 22, size_t maxPending_ = 4);
+	~AsyncFileBuffer();
+
+	bool open(const char *path);
+	bool is_open() const;
+	void close();
+};
+
+class BufferedFileWriter : public std::ostream
+{
+	AsyncFileBuffer buffer;
+
+public:
+	BufferedFileWriter();
+
+	void open(const char *path);
+	bool is_open() const;
+	void close();
+};
+}
+
+#endif
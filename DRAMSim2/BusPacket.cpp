@@ -45,6 +45,8 @@
 using namespace DRAMSim;
 using namespace std;
 
+thread_local ObjectPool BusPacket::pool(sizeof(BusPacket));
+
 BusPacket::BusPacket(BusPacketType packtype, uint64_t physicalAddr, 
 		unsigned col, unsigned rw, unsigned r, unsigned b, void *dat, 
 		ostream &dramsim_log_) :
@@ -65,38 +67,36 @@ void BusPacket::print(uint64_t currentClockCycle, bool dataStart)
 		return;
 	}
 
-	if (VERIFICATION_OUTPUT)
+	//only called by Rank when VERIFICATION_OUTPUT is set in its config
+	switch (busPacketType)
 	{
-		switch (busPacketType)
-		{
-		case READ:
-			cmd_verify_out << currentClockCycle << ": read ("<<rank<<","<<bank<<","<<column<<",0);"<<endl;
-			break;
-		case READ_P:
-			cmd_verify_out << currentClockCycle << ": read ("<<rank<<","<<bank<<","<<column<<",1);"<<endl;
-			break;
-		case WRITE:
-			cmd_verify_out << currentClockCycle << ": write ("<<rank<<","<<bank<<","<<column<<",0 , 0, 'h0);"<<endl;
-			break;
-		case WRITE_P:
-			cmd_verify_out << currentClockCycle << ": write ("<<rank<<","<<bank<<","<<column<<",1, 0, 'h0);"<<endl;
-			break;
-		case ACTIVATE:
-			cmd_verify_out << currentClockCycle <<": activate (" << rank << "," << bank << "," << row <<");"<<endl;
-			break;
-		case PRECHARGE:
-			cmd_verify_out << currentClockCycle <<": precharge (" << rank << "," << bank << "," << row <<");"<<endl;
-			break;
-		case REFRESH:
-			cmd_verify_out << currentClockCycle <<": refresh (" << rank << ");"<<endl;
-			break;
-		case DATA:
-			//TODO: data verification?
-			break;
-		default:
-			ERROR("Trying to print unknown kind of bus packet");
-			exit(-1);
-		}
+	case READ:
+		cmd_verify_out << currentClockCycle << ": read ("<<rank<<","<<bank<<","<<column<<",0);"<<endl;
+		break;
+	case READ_P:
+		cmd_verify_out << currentClockCycle << ": read ("<<rank<<","<<bank<<","<<column<<",1);"<<endl;
+		break;
+	case WRITE:
+		cmd_verify_out << currentClockCycle << ": write ("<<rank<<","<<bank<<","<<column<<",0 , 0, 'h0);"<<endl;
+		break;
+	case WRITE_P:
+		cmd_verify_out << currentClockCycle << ": write ("<<rank<<","<<bank<<","<<column<<",1, 0, 'h0);"<<endl;
+		break;
+	case ACTIVATE:
+		cmd_verify_out << currentClockCycle <<": activate (" << rank << "," << bank << "," << row <<");"<<endl;
+		break;
+	case PRECHARGE:
+		cmd_verify_out << currentClockCycle <<": precharge (" << rank << "," << bank << "," << row <<");"<<endl;
+		break;
+	case REFRESH:
+		cmd_verify_out << currentClockCycle <<": refresh (" << rank << ");"<<endl;
+		break;
+	case DATA:
+		//TODO: data verification?
+		break;
+	default:
+		ERROR("Trying to print unknown kind of bus packet");
+		exit(-1);
 	}
 }
 void BusPacket::print()
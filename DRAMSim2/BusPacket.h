@@ -36,6 +36,7 @@
 //
 
 #include "SystemConfiguration.h"
+#include "ObjectPool.h"
 
 namespace DRAMSim
 {
@@ -55,6 +56,8 @@ class BusPacket
 {
 	BusPacket();
 	ostream &dramsim_log; 
+	//one pool per thread so memory systems on different threads never share a free list
+	static thread_local ObjectPool pool;
 public:
 	//Fields
 	BusPacketType busPacketType;
@@ -68,6 +71,16 @@ public:
 	//Functions
 	BusPacket(BusPacketType packtype, uint64_t physicalAddr, unsigned col, unsigned rw, unsigned r, unsigned b, void *dat, ostream &dramsim_log_);
 
+	//bus packets are recycled through the pool
+	static void *operator new(size_t size)
+	{
+		return pool.allocate(size);
+	}
+	static void operator delete(void *object, size_t size)
+	{
+		pool.release(object, size);
+	}
+
 	void print();
 	void print(uint64_t currentClockCycle, bool dataStart);
 	void printData() const;
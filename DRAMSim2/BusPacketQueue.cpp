@@ -0,0 +1,135 @@
+/*********************************************************************************
+*  Copyright (c) 2010-2011, Elliott Cooper-Balis
+*                             Paul Rosenfeld
+*                             Bruce Jacob
+*                             University of Maryland 
+*                             dramninjas [at] gmail [dot] com
+*  All rights reserved.
+*  
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*  
+*     * Redistributions of source code must retain the above copyright notice,
+*        this list of conditions and the following disclaimer.
+*  
+*     * Redistributions in binary form must reproduce the above copyright notice,
+*        this list of conditions and the following disclaimer in the documentation
+*        and/or other materials provided with the distribution.
+*  
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+*  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+*  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************************/
+
+
+
+//BusPacketQueue.cpp
+//
+//Class file for the per rank/bank command queue storage
+//
+
+#include "BusPacketQueue.h"
+
+using namespace DRAMSim;
+
+BusPacketQueue::BusPacketQueue(size_t capacity) :
+	ring(capacity > 0 ? capacity : 1, NULL),
+	head(0),
+	count(0)
+{}
+
+void BusPacketQueue::addRow(const BusPacket *packet)
+{
+	RowCount &rowCount = rows[rowKey(packet->bank, packet->row)];
+	rowCount.packets++;
+	if (packet->busPacketType != ACTIVATE)
+	{
+		rowCount.columnAccesses++;
+	}
+}
+
+void BusPacketQueue::removeRow(const BusPacket *packet)
+{
+	std::unordered_map<uint64_t, RowCount>::iterator it = rows.find(rowKey(packet->bank, packet->row));
+	it->second.packets--;
+	if (packet->busPacketType != ACTIVATE)
+	{
+		it->second.columnAccesses--;
+	}
+	if (it->second.packets == 0)
+	{
+		rows.erase(it);
+	}
+}
+
+//append at the tail, the ring only grows if the queue depth is exceeded
+void BusPacketQueue::push_back(BusPacket *packet)
+{
+	if (count == ring.size())
+	{
+		std::vector<BusPacket *> grown(ring.size() * 2, NULL);
+		for (size_t i=0; i<count; i++)
+		{
+			grown[i] = (*this)[i];
+		}
+		ring.swap(grown);
+		head = 0;
+	}
+
+	ring[(head + count) % ring.size()] = packet;
+	count++;
+	addRow(packet);
+}
+
+//remove the i-th oldest packet keeping the order of the rest, the packet is not deleted
+//	only the shorter side of the ring is shifted
+void BusPacketQueue::erase(size_t i)
+{
+	removeRow((*this)[i]);
+
+	size_t capacity = ring.size();
+	if (i < count / 2)
+	{
+		for (size_t j=i; j>0; j--)
+		{
+			ring[(head + j) % capacity] = ring[(head + j - 1) % capacity];
+		}
+		head = (head + 1) % capacity;
+	}
+	else
+	{
+		for (size_t j=i; j+1<count; j++)
+		{
+			ring[(head + j) % capacity] = ring[(head + j + 1) % capacity];
+		}
+	}
+	count--;
+}
+
+void BusPacketQueue::clear()
+{
+	head = 0;
+	count = 0;
+	rows.clear();
+}
+
+//number of queued packets going to the given bank and row
+unsigned BusPacketQueue::rowPackets(unsigned bank, unsigned row) const
+{
+	std::unordered_map<uint64_t, RowCount>::const_iterator it = rows.find(rowKey(bank, row));
+	return it == rows.end() ? 0 : it->second.packets;
+}
+
+//number of queued reads and writes (not activates) going to the given bank and row
+unsigned BusPacketQueue::rowColumnAccesses(unsigned bank, unsigned row) const
+{
+	std::unordered_map<uint64_t, RowCount>::const_iterator it = rows.find(rowKey(bank, row));
+	return it == rows.end() ? 0 : it->second.columnAccesses;
+}
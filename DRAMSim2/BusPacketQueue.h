@@ -0,0 +1,94 @@
+/*********************************************************************************
+*  Copyright (c) 2010-2011, Elliott Cooper-Balis
+*                             Paul Rosenfeld
+*                             Bruce Jacob
+*                             University of Maryland 
+*                             dramninjas [at] gmail [dot] com
+*  All rights reserved.
+*  
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*  
+*     * Redistributions of source code must retain the above copyright notice,
+*        this list of conditions and the following disclaimer.
+*  
+*     * Redistributions in binary form must reproduce the above copyright notice,
+*        this list of conditions and the following disclaimer in the documentation
+*        and/or other materials provided with the distribution.
+*  
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+*  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+*  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************************/
+
+#ifndef BUSPACKETQUEUE_H
+#define BUSPACKETQUEUE_H
+
+//BusPacketQueue.h
+//
+//Header file for the per rank/bank command queue storage
+//	Commands are kept in arrival order in a ring buffer and the number of
+//	queued commands to each row is indexed, so the scheduler can tell if a
+//	row has pending accesses without scanning the queue
+//
+
+#include "BusPacket.h"
+#include <vector>
+#include <unordered_map>
+
+namespace DRAMSim
+{
+class BusPacketQueue
+{
+	//number of queued commands going to a row
+	struct RowCount
+	{
+		unsigned packets;
+		unsigned columnAccesses;
+	};
+
+	std::vector<BusPacket *> ring;
+	size_t head;
+	size_t count;
+	std::unordered_map<uint64_t, RowCount> rows;
+
+	static uint64_t rowKey(unsigned bank, unsigned row)
+	{
+		return ((uint64_t)bank << 32) | row;
+	}
+	void addRow(const BusPacket *packet);
+	void removeRow(const BusPacket *packet);
+
+public:
+	BusPacketQueue(size_t capacity = 0);
+
+	size_t size() const
+	{
+		return count;
+	}
+	bool empty() const
+	{
+		return count == 0;
+	}
+	BusPacket *operator[](size_t i) const
+	{
+		return ring[(head + i) % ring.size()];
+	}
+
+	void push_back(BusPacket *packet);
+	void erase(size_t i);
+	void clear();
+
+	unsigned rowPackets(unsigned bank, unsigned row) const;
+	unsigned rowColumnAccesses(unsigned bank, unsigned row) const;
+};
+}
+
+#endif
@@ -184,6 +184,14 @@ namespace DRAMSim {
 			return *this; 
 		}
 		
+		// Start over with a new header
+		void reset()
+		{
+			fieldNames.clear();
+			finalized=false;
+			idx=0;
+		}
+
 		bool isFinalized()
 		{
 //			printf("obj=%p", this); 
@@ -88,6 +88,37 @@ namespace ClockDomain
 	}
 
 
+	// Number of update() calls that trigger at most the given number of callbacks
+	uint64_t ClockDomainCrosser::updatesFor(uint64_t callbacks)
+	{
+		if (clock1 == clock2)
+		{
+			return callbacks;
+		}
+
+		// counter2 is never behind counter1 after an update
+		return (callbacks * clock2 + (counter2 - counter1)) / clock1;
+	}
+
+	// Advance the counters as if update() was called the given number of times
+	// without calling the callback, returns the number of callbacks skipped
+	uint64_t ClockDomainCrosser::skip(uint64_t updates)
+	{
+		if (clock1 == clock2)
+		{
+			return updates;
+		}
+
+		uint64_t ahead = counter2 - counter1;
+		uint64_t total = updates * clock1;
+		uint64_t callbacks = total > ahead ? (total - ahead + clock2 - 1) / clock2 : 0;
+
+		// only the difference between the counters matters, keep them small
+		counter1 = 0;
+		counter2 = ahead + callbacks * clock2 - total;
+		return callbacks;
+	}
+
 
 	void TestObj::cb()
 	{
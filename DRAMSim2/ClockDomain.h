@@ -48,6 +48,8 @@ namespace ClockDomain
 		ClockDomainCrosser(uint64_t _clock1, uint64_t _clock2, ClockUpdateCB *_callback);
 		ClockDomainCrosser(double ratio, ClockUpdateCB *_callback);
 		void update();
+		uint64_t updatesFor(uint64_t callbacks);
+		uint64_t skip(uint64_t updates);
 	};
 
 
@@ -46,7 +46,8 @@
 
 using namespace DRAMSim;
 
-CommandQueue::CommandQueue(vector< vector<BankState> > &states, ostream &dramsim_log_) :
+CommandQueue::CommandQueue(vector< vector<BankState> > &states, const Config &config_, ostream &dramsim_log_) :
+		config(config_),
 		dramsim_log(dramsim_log_),
 		bankStates(states),
 		nextBank(0),
@@ -62,13 +63,13 @@ CommandQueue::CommandQueue(vector< vector<BankState> > &states, ostream &dramsim
 
 	//use numBankQueus below to create queue structure
 	size_t numBankQueues;
-	if (queuingStructure==PerRank)
+	if (config.queuingStructure==PerRank)
 	{
 		numBankQueues = 1;
 	}
-	else if (queuingStructure==PerRankPerBank)
+	else if (config.queuingStructure==PerRankPerBank)
 	{
-		numBankQueues = NUM_BANKS;
+		numBankQueues = config.NUM_BANKS;
 	}
 	else
 	{
@@ -77,18 +78,18 @@ CommandQueue::CommandQueue(vector< vector<BankState> > &states, ostream &dramsim
 	}
 
 	//vector of counters used to ensure rows don't stay open too long
-	rowAccessCounters = vector< vector<unsigned> >(NUM_RANKS, vector<unsigned>(NUM_BANKS,0));
+	rowAccessCounters = vector< vector<unsigned> >(config.NUM_RANKS, vector<unsigned>(config.NUM_BANKS,0));
 
 	//create queue based on the structure we want
 	BusPacket1D actualQueue;
 	BusPacket2D perBankQueue = BusPacket2D();
 	queues = BusPacket3D();
-	for (size_t rank=0; rank<NUM_RANKS; rank++)
+	for (size_t rank=0; rank<config.NUM_RANKS; rank++)
 	{
 		//this loop will run only once for per-rank and NUM_BANKS times for per-rank-per-bank
 		for (size_t bank=0; bank<numBankQueues; bank++)
 		{
-			actualQueue	= BusPacket1D();
+			actualQueue	= BusPacket1D(config.CMD_QUEUE_DEPTH);
 			perBankQueue.push_back(actualQueue);
 		}
 		queues.push_back(perBankQueue);
@@ -101,21 +102,55 @@ CommandQueue::CommandQueue(vector< vector<BankState> > &states, ostream &dramsim
 	//
 	//countdown vector will have decrementing counters starting at tFAW
 	//  when the 0th element reaches 0, remove it
-	tFAWCountdown.reserve(NUM_RANKS);
-	for (size_t i=0;i<NUM_RANKS;i++)
+	tFAWCountdown.reserve(config.NUM_RANKS);
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
 		//init the empty vectors here so we don't seg fault later
 		tFAWCountdown.push_back(vector<unsigned>());
 	}
 }
+//Drop all the queued commands and go back to the initial state
+void CommandQueue::reset()
+{
+	for (size_t r=0; r<queues.size(); r++)
+	{
+		for (size_t b=0; b<queues[r].size(); b++)
+		{
+			for (size_t i=0; i<queues[r][b].size(); i++)
+			{
+				delete(queues[r][b][i]);
+			}
+			queues[r][b].clear();
+		}
+	}
+
+	nextBank = 0;
+	nextRank = 0;
+	nextBankPRE = 0;
+	nextRankPRE = 0;
+	refreshRank = 0;
+	refreshWaiting = false;
+	sendAct = true;
+	currentClockCycle = 0;
+
+	for (size_t r=0; r<config.NUM_RANKS; r++)
+	{
+		tFAWCountdown[r].clear();
+		for (size_t b=0; b<config.NUM_BANKS; b++)
+		{
+			rowAccessCounters[r][b] = 0;
+		}
+	}
+}
+
 CommandQueue::~CommandQueue()
 {
 	//ERROR("COMMAND QUEUE destructor");
-	size_t bankMax = NUM_RANKS;
-	if (queuingStructure == PerRank) {
+	size_t bankMax = config.NUM_RANKS;
+	if (config.queuingStructure == PerRank) {
 		bankMax = 1; 
 	}
-	for (size_t r=0; r< NUM_RANKS; r++)
+	for (size_t r=0; r< config.NUM_RANKS; r++)
 	{
 		for (size_t b=0; b<bankMax; b++) 
 		{
@@ -132,20 +167,20 @@ void CommandQueue::enqueue(BusPacket *newBusPacket)
 {
 	unsigned rank = newBusPacket->rank;
 	unsigned bank = newBusPacket->bank;
-	if (queuingStructure==PerRank)
+	if (config.queuingStructure==PerRank)
 	{
 		queues[rank][0].push_back(newBusPacket);
-		if (queues[rank][0].size()>CMD_QUEUE_DEPTH)
+		if (queues[rank][0].size()>config.CMD_QUEUE_DEPTH)
 		{
 			ERROR("== Error - Enqueued more than allowed in command queue");
 			ERROR("						Need to call .hasRoomFor(int numberToEnqueue, unsigned rank, unsigned bank) first");
 			exit(0);
 		}
 	}
-	else if (queuingStructure==PerRankPerBank)
+	else if (config.queuingStructure==PerRankPerBank)
 	{
 		queues[rank][bank].push_back(newBusPacket);
-		if (queues[rank][bank].size()>CMD_QUEUE_DEPTH)
+		if (queues[rank][bank].size()>config.CMD_QUEUE_DEPTH)
 		{
 			ERROR("== Error - Enqueued more than allowed in command queue");
 			ERROR("						Need to call .hasRoomFor(int numberToEnqueue, unsigned rank, unsigned bank) first");
@@ -168,7 +203,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 	//
 	//deal with tFAW book-keeping
 	//	each rank has it's own counter since the restriction is on a device level
-	for (size_t i=0;i<NUM_RANKS;i++)
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
 		//decrement all the counters we have going
 		for (size_t j=0;j<tFAWCountdown[i].size();j++)
@@ -191,7 +226,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 		 Otherwise, it starts looking for rows to close (in open page)
 	*/
 
-	if (rowBufferPolicy==ClosePage)
+	if (config.rowBufferPolicy==ClosePage)
 	{
 		bool sendingREF = false;
 		//if the memory controller set the flags signaling that we need to issue a refresh
@@ -199,16 +234,17 @@ bool CommandQueue::pop(BusPacket **busPacket)
 		{
 			bool foundActiveOrTooEarly = false;
 			//look for an open bank
-			for (size_t b=0;b<NUM_BANKS;b++)
+			for (size_t b=0;b<config.NUM_BANKS;b++)
 			{
-				vector<BusPacket *> &queue = getCommandQueue(refreshRank,b);
+				BusPacketQueue &queue = getCommandQueue(refreshRank,b);
 				//checks to make sure that all banks are idle
 				if (bankStates[refreshRank][b].currentBankState == RowActive)
 				{
 					foundActiveOrTooEarly = true;
 					//if the bank is open, make sure there is nothing else
 					// going there before we close it
-					for (size_t j=0;j<queue.size();j++)
+					bool rowPending = queue.rowPackets(b, bankStates[refreshRank][b].openRowAddress) > 0;
+					for (size_t j=0;rowPending && j<queue.size();j++)
 					{
 						BusPacket *packet = queue[j];
 						if (packet->row == bankStates[refreshRank][b].openRowAddress &&
@@ -217,7 +253,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 							if (packet->busPacketType != ACTIVATE && isIssuable(packet))
 							{
 								*busPacket = packet;
-								queue.erase(queue.begin() + j);
+								queue.erase(j);
 								sendingREF = true;
 							}
 							break;
@@ -256,14 +292,14 @@ bool CommandQueue::pop(BusPacket **busPacket)
 			unsigned startingBank = nextBank;
 			do
 			{
-				vector<BusPacket *> &queue = getCommandQueue(nextRank, nextBank);
+				BusPacketQueue &queue = getCommandQueue(nextRank, nextBank);
 				//make sure there is something in this queue first
 				//	also make sure a rank isn't waiting for a refresh
 				//	if a rank is waiting for a refesh, don't issue anything to it until the
 				//		refresh logic above has sent one out (ie, letting banks close)
 				if (!queue.empty() && !((nextRank == refreshRank) && refreshWaiting))
 				{
-					if (queuingStructure == PerRank)
+					if (config.queuingStructure == PerRank)
 					{
 
 						//search from beginning to find first issuable bus packet
@@ -277,7 +313,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 									continue;
 
 								*busPacket = queue[i];
-								queue.erase(queue.begin()+i);
+								queue.erase(i);
 								foundIssuable = true;
 								break;
 							}
@@ -291,7 +327,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 							//no need to search because if the front can't be sent,
 							// then no chance something behind it can go instead
 							*busPacket = queue[0];
-							queue.erase(queue.begin());
+							queue.erase(0);
 							foundIssuable = true;
 						}
 					}
@@ -302,9 +338,9 @@ bool CommandQueue::pop(BusPacket **busPacket)
 				if (foundIssuable) break;
 
 				//rank round robin
-				if (queuingStructure == PerRank)
+				if (config.queuingStructure == PerRank)
 				{
-					nextRank = (nextRank + 1) % NUM_RANKS;
+					nextRank = (nextRank + 1) % config.NUM_RANKS;
 					if (startingRank == nextRank)
 					{
 						break;
@@ -325,14 +361,14 @@ bool CommandQueue::pop(BusPacket **busPacket)
 			if (!foundIssuable) return false;
 		}
 	}
-	else if (rowBufferPolicy==OpenPage)
+	else if (config.rowBufferPolicy==OpenPage)
 	{
 		bool sendingREForPRE = false;
 		if (refreshWaiting)
 		{
 			bool sendREF = true;
 			//make sure all banks idle and timing met for a REF
-			for (size_t b=0;b<NUM_BANKS;b++)
+			for (size_t b=0;b<config.NUM_BANKS;b++)
 			{
 				//if a bank is active we can't send a REF yet
 				if (bankStates[refreshRank][b].currentBankState == RowActive)
@@ -340,9 +376,10 @@ bool CommandQueue::pop(BusPacket **busPacket)
 					sendREF = false;
 					bool closeRow = true;
 					//search for commands going to an open row
-					vector <BusPacket *> &refreshQueue = getCommandQueue(refreshRank,b);
+					BusPacketQueue &refreshQueue = getCommandQueue(refreshRank,b);
 
-					for (size_t j=0;j<refreshQueue.size();j++)
+					bool rowPending = refreshQueue.rowPackets(b, bankStates[refreshRank][b].openRowAddress) > 0;
+					for (size_t j=0;rowPending && j<refreshQueue.size();j++)
 					{
 						BusPacket *packet = refreshQueue[j];
 						//if a command in the queue is going to the same row . . .
@@ -358,7 +395,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 								{
 									//send it out
 									*busPacket = packet;
-									refreshQueue.erase(refreshQueue.begin()+j);
+									refreshQueue.erase(j);
 									sendingREForPRE = true;
 								}
 								break;
@@ -408,7 +445,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 			bool foundIssuable = false;
 			do // round robin over queues
 			{
-				vector<BusPacket *> &queue = getCommandQueue(nextRank,nextBank);
+				BusPacketQueue &queue = getCommandQueue(nextRank,nextBank);
 				//make sure there is something there first
 				if (!queue.empty() && !((nextRank == refreshRank) && refreshWaiting))
 				{
@@ -419,8 +456,14 @@ bool CommandQueue::pop(BusPacket **busPacket)
 						if (isIssuable(packet))
 						{
 							//check for dependencies
+							//	only scan if another read or write is queued for the same row
 							bool dependencyFound = false;
-							for (size_t j=0;j<i;j++)
+							unsigned rowAccesses = queue.rowColumnAccesses(packet->bank, packet->row);
+							if (packet->busPacketType != ACTIVATE)
+							{
+								rowAccesses--;
+							}
+							for (size_t j=0;rowAccesses > 0 && j<i;j++)
 							{
 								BusPacket *prevPacket = queue[j];
 								if (prevPacket->busPacketType != ACTIVATE &&
@@ -442,15 +485,17 @@ bool CommandQueue::pop(BusPacket **busPacket)
 							{
 								rowAccessCounters[(*busPacket)->rank][(*busPacket)->bank]++;
 								// i is being returned, but i-1 is being thrown away, so must delete it here 
-								delete (queue[i-1]);
+								BusPacket *activate = queue[i-1];
 
 								// remove both i-1 (the activate) and i (we've saved the pointer in *busPacket)
-								queue.erase(queue.begin()+i-1,queue.begin()+i+1);
+								queue.erase(i);
+								queue.erase(i-1);
+								delete (activate);
 							}
 							else // there's no activate before this packet
 							{
 								//or just remove the one bus packet
-								queue.erase(queue.begin()+i);
+								queue.erase(i);
 							}
 
 							foundIssuable = true;
@@ -463,9 +508,9 @@ bool CommandQueue::pop(BusPacket **busPacket)
 				if (foundIssuable) break;
 
 				//rank round robin
-				if (queuingStructure == PerRank)
+				if (config.queuingStructure == PerRank)
 				{
-					nextRank = (nextRank + 1) % NUM_RANKS;
+					nextRank = (nextRank + 1) % config.NUM_RANKS;
 					if (startingRank == nextRank)
 					{
 						break;
@@ -493,24 +538,16 @@ bool CommandQueue::pop(BusPacket **busPacket)
 
 				do // round robin over all ranks and banks
 				{
-					vector <BusPacket *> &queue = getCommandQueue(nextRankPRE, nextBankPRE);
+					BusPacketQueue &queue = getCommandQueue(nextRankPRE, nextBankPRE);
 					bool found = false;
 					//check if bank is open
 					if (bankStates[nextRankPRE][nextBankPRE].currentBankState == RowActive)
 					{
-						for (size_t i=0;i<queue.size();i++)
-						{
-							//if there is something going to that bank and row, then we don't want to send a PRE
-							if (queue[i]->bank == nextBankPRE &&
-									queue[i]->row == bankStates[nextRankPRE][nextBankPRE].openRowAddress)
-							{
-								found = true;
-								break;
-							}
-						}
+						//if there is something going to that bank and row, then we don't want to send a PRE
+						found = queue.rowPackets(nextBankPRE, bankStates[nextRankPRE][nextBankPRE].openRowAddress) > 0;
 
 						//if nothing found going to that bank and row or too many accesses have happend, close it
-						if (!found || rowAccessCounters[nextRankPRE][nextBankPRE]==TOTAL_ROW_ACCESSES)
+						if (!found || rowAccessCounters[nextRankPRE][nextBankPRE]==config.TOTAL_ROW_ACCESSES)
 						{
 							if (currentClockCycle >= bankStates[nextRankPRE][nextBankPRE].nextPrecharge)
 							{
@@ -535,7 +572,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 	//  posted-cas is enabled when AL>0
 	//  when sendAct is true, when don't want to increment our indexes
 	//  so we send the column access that is paid with this act
-	if (AL>0 && sendAct)
+	if (config.AL>0 && sendAct)
 	{
 		sendAct = false;
 	}
@@ -548,7 +585,7 @@ bool CommandQueue::pop(BusPacket **busPacket)
 	//if its an activate, add a tfaw counter
 	if ((*busPacket)->busPacketType==ACTIVATE)
 	{
-		tFAWCountdown[(*busPacket)->rank].push_back(tFAW);
+		tFAWCountdown[(*busPacket)->rank].push_back(config.tFAW);
 	}
 
 	return true;
@@ -557,17 +594,17 @@ bool CommandQueue::pop(BusPacket **busPacket)
 //check if a rank/bank queue has room for a certain number of bus packets
 bool CommandQueue::hasRoomFor(unsigned numberToEnqueue, unsigned rank, unsigned bank)
 {
-	vector<BusPacket *> &queue = getCommandQueue(rank, bank); 
-	return (CMD_QUEUE_DEPTH - queue.size() >= numberToEnqueue);
+	BusPacketQueue &queue = getCommandQueue(rank, bank); 
+	return (config.CMD_QUEUE_DEPTH - queue.size() >= numberToEnqueue);
 }
 
 //prints the contents of the command queue
 void CommandQueue::print()
 {
-	if (queuingStructure==PerRank)
+	if (config.queuingStructure==PerRank)
 	{
 		PRINT(endl << "== Printing Per Rank Queue" );
-		for (size_t i=0;i<NUM_RANKS;i++)
+		for (size_t i=0;i<config.NUM_RANKS;i++)
 		{
 			PRINT(" = Rank " << i << "  size : " << queues[i][0].size() );
 			for (size_t j=0;j<queues[i][0].size();j++)
@@ -577,14 +614,14 @@ void CommandQueue::print()
 			}
 		}
 	}
-	else if (queuingStructure==PerRankPerBank)
+	else if (config.queuingStructure==PerRankPerBank)
 	{
 		PRINT("\n== Printing Per Rank, Per Bank Queue" );
 
-		for (size_t i=0;i<NUM_RANKS;i++)
+		for (size_t i=0;i<config.NUM_RANKS;i++)
 		{
 			PRINT(" = Rank " << i );
-			for (size_t j=0;j<NUM_BANKS;j++)
+			for (size_t j=0;j<config.NUM_BANKS;j++)
 			{
 				PRINT("    Bank "<< j << "   size : " << queues[i][j].size() );
 
@@ -603,13 +640,13 @@ void CommandQueue::print()
  * don't always have a per bank queuing structure, sometimes the bank
  * argument is ignored (and the 0th index is returned 
  */
-vector<BusPacket *> &CommandQueue::getCommandQueue(unsigned rank, unsigned bank)
+BusPacketQueue &CommandQueue::getCommandQueue(unsigned rank, unsigned bank)
 {
-	if (queuingStructure == PerRankPerBank)
+	if (config.queuingStructure == PerRankPerBank)
 	{
 		return queues[rank][bank];
 	}
-	else if (queuingStructure == PerRank)
+	else if (config.queuingStructure == PerRank)
 	{
 		return queues[rank][0];
 	}
@@ -647,7 +684,7 @@ bool CommandQueue::isIssuable(BusPacket *busPacket)
 		if (bankStates[busPacket->rank][busPacket->bank].currentBankState == RowActive &&
 		        currentClockCycle >= bankStates[busPacket->rank][busPacket->bank].nextWrite &&
 		        busPacket->row == bankStates[busPacket->rank][busPacket->bank].openRowAddress &&
-		        rowAccessCounters[busPacket->rank][busPacket->bank] < TOTAL_ROW_ACCESSES)
+		        rowAccessCounters[busPacket->rank][busPacket->bank] < config.TOTAL_ROW_ACCESSES)
 		{
 			return true;
 		}
@@ -661,7 +698,7 @@ bool CommandQueue::isIssuable(BusPacket *busPacket)
 		if (bankStates[busPacket->rank][busPacket->bank].currentBankState == RowActive &&
 		        currentClockCycle >= bankStates[busPacket->rank][busPacket->bank].nextRead &&
 		        busPacket->row == bankStates[busPacket->rank][busPacket->bank].openRowAddress &&
-		        rowAccessCounters[busPacket->rank][busPacket->bank] < TOTAL_ROW_ACCESSES)
+		        rowAccessCounters[busPacket->rank][busPacket->bank] < config.TOTAL_ROW_ACCESSES)
 		{
 			return true;
 		}
@@ -692,13 +729,13 @@ bool CommandQueue::isIssuable(BusPacket *busPacket)
 //figures out if a rank's queue is empty
 bool CommandQueue::isEmpty(unsigned rank)
 {
-	if (queuingStructure == PerRank)
+	if (config.queuingStructure == PerRank)
 	{
 		return queues[rank][0].empty();
 	}
-	else if (queuingStructure == PerRankPerBank)
+	else if (config.queuingStructure == PerRankPerBank)
 	{
-		for (size_t i=0;i<NUM_BANKS;i++)
+		for (size_t i=0;i<config.NUM_BANKS;i++)
 		{
 			if (!queues[rank][i].empty()) return false;
 		}
@@ -711,6 +748,24 @@ bool CommandQueue::isEmpty(unsigned rank)
 	}
 }
 
+//figures out if pop() would leave every queue and counter untouched
+bool CommandQueue::isIdle()
+{
+	if (refreshWaiting)
+	{
+		return false;
+	}
+
+	for (size_t r=0; r<config.NUM_RANKS; r++)
+	{
+		if (!tFAWCountdown[r].empty() || !isEmpty(r))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 //tells the command queue that a particular rank is in need of a refresh
 void CommandQueue::needRefresh(unsigned rank)
 {
@@ -720,28 +775,28 @@ void CommandQueue::needRefresh(unsigned rank)
 
 void CommandQueue::nextRankAndBank(unsigned &rank, unsigned &bank)
 {
-	if (schedulingPolicy == RankThenBankRoundRobin)
+	if (config.schedulingPolicy == RankThenBankRoundRobin)
 	{
 		rank++;
-		if (rank == NUM_RANKS)
+		if (rank == config.NUM_RANKS)
 		{
 			rank = 0;
 			bank++;
-			if (bank == NUM_BANKS)
+			if (bank == config.NUM_BANKS)
 			{
 				bank = 0;
 			}
 		}
 	}
 	//bank-then-rank round robin
-	else if (schedulingPolicy == BankThenRankRoundRobin)
+	else if (config.schedulingPolicy == BankThenRankRoundRobin)
 	{
 		bank++;
-		if (bank == NUM_BANKS)
+		if (bank == config.NUM_BANKS)
 		{
 			bank = 0;
 			rank++;
-			if (rank == NUM_RANKS)
+			if (rank == config.NUM_RANKS)
 			{
 				rank = 0;
 			}
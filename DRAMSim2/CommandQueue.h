@@ -42,6 +42,7 @@
 //
 
 #include "BusPacket.h"
+#include "BusPacketQueue.h"
 #include "BankState.h"
 #include "Transaction.h"
 #include "SystemConfiguration.h"
@@ -54,15 +55,16 @@ namespace DRAMSim
 class CommandQueue : public SimulatorObject
 {
 	CommandQueue();
+	const Config &config;
 	ostream &dramsim_log;
 public:
 	//typedefs
-	typedef vector<BusPacket *> BusPacket1D;
+	typedef BusPacketQueue BusPacket1D;
 	typedef vector<BusPacket1D> BusPacket2D;
 	typedef vector<BusPacket2D> BusPacket3D;
 
 	//functions
-	CommandQueue(vector< vector<BankState> > &states, ostream &dramsim_log);
+	CommandQueue(vector< vector<BankState> > &states, const Config &config, ostream &dramsim_log);
 	virtual ~CommandQueue(); 
 
 	void enqueue(BusPacket *newBusPacket);
@@ -70,10 +72,12 @@ public:
 	bool hasRoomFor(unsigned numberToEnqueue, unsigned rank, unsigned bank);
 	bool isIssuable(BusPacket *busPacket);
 	bool isEmpty(unsigned rank);
+	bool isIdle();
 	void needRefresh(unsigned rank);
 	void print();
 	void update(); //SimulatorObject requirement
-	vector<BusPacket *> &getCommandQueue(unsigned rank, unsigned bank);
+	void reset();
+	BusPacketQueue &getCommandQueue(unsigned rank, unsigned bank);
 
 	//fields
 	
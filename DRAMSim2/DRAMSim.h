@@ -37,6 +37,7 @@
  */
 #include "Callback.h"
 #include <string>
+#include <map>
 using std::string;
 
 namespace DRAMSim 
@@ -47,6 +48,10 @@ namespace DRAMSim
 			bool addTransaction(bool isWrite, uint64_t addr);
 			void setCPUClockSpeed(uint64_t cpuClkFreqHz);
 			void update();
+			void reset();
+			void closeOutputFiles();
+			uint64_t getIdleCycles();
+			void skipIdleCycles(uint64_t cpuCycles);
 			void printStats(bool finalStats);
 			bool willAcceptTransaction(); 
 			bool willAcceptTransaction(uint64_t addr); 
@@ -61,7 +66,7 @@ namespace DRAMSim
 			int getIniUint64(const std::string &field, uint64_t *val);
 			int getIniFloat(const std::string &field, float *val);
 	};
-	MultiChannelMemorySystem *getMemorySystemInstance(const string &dev, const string &sys, const string &pwd, const string &trc, unsigned megsOfMemory, std::string *visfilename=NULL);
+	MultiChannelMemorySystem *getMemorySystemInstance(const string &dev, const string &sys, const string &pwd, const string &trc, unsigned megsOfMemory, std::string *visfilename=NULL, const std::map<std::string, std::string> *paramOverrides=NULL);
 }
 
 #endif
@@ -36,15 +36,17 @@
 #include <sstream>
 #include <string>
 #include <map> 
+#include <vector>
+#include <algorithm>
 #include "SystemConfiguration.h"
 
 using namespace std;
 
-#define DEFINE_UINT_PARAM(name, paramtype) {#name, &name, UINT, paramtype, false}
-#define DEFINE_STRING_PARAM(name, paramtype) {#name, &name, STRING, paramtype, false}
-#define DEFINE_FLOAT_PARAM(name,paramtype) {#name, &name, FLOAT, paramtype, false}
-#define DEFINE_BOOL_PARAM(name, paramtype) {#name, &name, BOOL, paramtype, false}
-#define DEFINE_UINT64_PARAM(name, paramtype) {#name, &name, UINT64, paramtype, false}
+#define DEFINE_UINT_PARAM(name, paramtype) {#name, &config.name, UINT, paramtype, false}
+#define DEFINE_STRING_PARAM(name, paramtype) {#name, &config.name, STRING, paramtype, false}
+#define DEFINE_FLOAT_PARAM(name,paramtype) {#name, &config.name, FLOAT, paramtype, false}
+#define DEFINE_BOOL_PARAM(name, paramtype) {#name, &config.name, BOOL, paramtype, false}
+#define DEFINE_UINT64_PARAM(name, paramtype) {#name, &config.name, UINT64, paramtype, false}
 
 namespace DRAMSim
 {
@@ -61,27 +63,32 @@ typedef struct _configMap
 	bool wasSet;
 } ConfigMap;
 
+//Reads the ini files into the config it was created with
 class IniReader
 {
+	Config &config;
+	vector<ConfigMap> configMap;
 
 public:
 	typedef std::map<string, string> OverrideMap;
 	typedef OverrideMap::const_iterator OverrideIterator; 
 
-	static void SetKey(string key, string value, bool isSystemParam = false, size_t lineNumber = 0);
-	static void OverrideKeys(const OverrideMap *map);
-	static void ReadIniFile(string filename, bool isSystemParam);
-	static void InitEnumsFromStrings();
-	static bool CheckIfAllSet();
-	static void WriteValuesOut(std::ofstream &visDataOut);
-	static int getBool(const std::string &field, bool *val);
-	static int getUint(const std::string &field, unsigned int *val);
-	static int getUint64(const std::string &field, uint64_t *val);
-	static int getFloat(const std::string &field, float *val);
+	IniReader(Config &config_);
+	void SetKey(string key, string value, bool isSystemParam = false, size_t lineNumber = 0);
+	void OverrideKeys(const OverrideMap *map);
+	void ReadIniFile(string filename, bool isSystemParam);
+	void InitEnumsFromStrings();
+	void InitDerivedValues();
+	bool CheckIfAllSet();
+	void WriteValuesOut(std::ostream &visDataOut);
+	int getBool(const std::string &field, bool *val);
+	int getUint(const std::string &field, unsigned int *val);
+	int getUint64(const std::string &field, uint64_t *val);
+	int getFloat(const std::string &field, float *val);
 
 private:
-	static void WriteParams(std::ofstream &visDataOut, paramType t);
-	static void Trim(string &str);
+	void WriteParams(std::ostream &visDataOut, paramType t);
+	void Trim(string &str);
 };
 }
 
@@ -39,31 +39,17 @@
 #include "MemorySystem.h"
 #include "AddressMapping.h"
 
-#define SEQUENTIAL(rank,bank) (rank*NUM_BANKS)+bank
+#define SEQUENTIAL(rank,bank) (rank*config.NUM_BANKS)+bank
 
 /* Power computations are localized to MemoryController.cpp */ 
-extern unsigned IDD0;
-extern unsigned IDD1;
-extern unsigned IDD2P;
-extern unsigned IDD2Q;
-extern unsigned IDD2N;
-extern unsigned IDD3Pf;
-extern unsigned IDD3Ps;
-extern unsigned IDD3N;
-extern unsigned IDD4W;
-extern unsigned IDD4R;
-extern unsigned IDD5;
-extern unsigned IDD6;
-extern unsigned IDD6L;
-extern unsigned IDD7;
-extern float Vdd; 
 
 using namespace DRAMSim;
 
-MemoryController::MemoryController(MemorySystem *parent, CSVWriter &csvOut_, ostream &dramsim_log_) :
+MemoryController::MemoryController(MemorySystem *parent, const Config &config_, CSVWriter &csvOut_, ostream &dramsim_log_) :
+		config(config_),
 		dramsim_log(dramsim_log_),
-		bankStates(NUM_RANKS, vector<BankState>(NUM_BANKS, dramsim_log)),
-		commandQueue(bankStates, dramsim_log_),
+		bankStates(config.NUM_RANKS, vector<BankState>(config.NUM_BANKS, dramsim_log)),
+		commandQueue(bankStates, config_, dramsim_log_),
 		poppedBusPacket(NULL),
 		csvOut(csvOut_),
 		totalTransactions(0),
@@ -83,30 +69,30 @@ MemoryController::MemoryController(MemorySystem *parent, CSVWriter &csvOut_, ost
 	currentClockCycle = 0;
 
 	//reserve memory for vectors
-	transactionQueue.reserve(TRANS_QUEUE_DEPTH);
-	powerDown = vector<bool>(NUM_RANKS,false);
-	grandTotalBankAccesses = vector<uint64_t>(NUM_RANKS*NUM_BANKS,0);
-	totalReadsPerBank = vector<uint64_t>(NUM_RANKS*NUM_BANKS,0);
-	totalWritesPerBank = vector<uint64_t>(NUM_RANKS*NUM_BANKS,0);
-	totalReadsPerRank = vector<uint64_t>(NUM_RANKS,0);
-	totalWritesPerRank = vector<uint64_t>(NUM_RANKS,0);
-
-	writeDataCountdown.reserve(NUM_RANKS);
-	writeDataToSend.reserve(NUM_RANKS);
-	refreshCountdown.reserve(NUM_RANKS);
+	transactionQueue.reserve(config.TRANS_QUEUE_DEPTH);
+	powerDown = vector<bool>(config.NUM_RANKS,false);
+	grandTotalBankAccesses = vector<uint64_t>(config.NUM_RANKS*config.NUM_BANKS,0);
+	totalReadsPerBank = vector<uint64_t>(config.NUM_RANKS*config.NUM_BANKS,0);
+	totalWritesPerBank = vector<uint64_t>(config.NUM_RANKS*config.NUM_BANKS,0);
+	totalReadsPerRank = vector<uint64_t>(config.NUM_RANKS,0);
+	totalWritesPerRank = vector<uint64_t>(config.NUM_RANKS,0);
+
+	writeDataCountdown.reserve(config.NUM_RANKS);
+	writeDataToSend.reserve(config.NUM_RANKS);
+	refreshCountdown.reserve(config.NUM_RANKS);
 
 	//Power related packets
-	backgroundEnergy = vector <uint64_t >(NUM_RANKS,0);
-	burstEnergy = vector <uint64_t> (NUM_RANKS,0);
-	actpreEnergy = vector <uint64_t> (NUM_RANKS,0);
-	refreshEnergy = vector <uint64_t> (NUM_RANKS,0);
+	backgroundEnergy = vector <uint64_t >(config.NUM_RANKS,0);
+	burstEnergy = vector <uint64_t> (config.NUM_RANKS,0);
+	actpreEnergy = vector <uint64_t> (config.NUM_RANKS,0);
+	refreshEnergy = vector <uint64_t> (config.NUM_RANKS,0);
 
-	totalEpochLatency = vector<uint64_t> (NUM_RANKS*NUM_BANKS,0);
+	totalEpochLatency = vector<uint64_t> (config.NUM_RANKS*config.NUM_BANKS,0);
 
 	//staggers when each rank is due for a refresh
-	for (size_t i=0;i<NUM_RANKS;i++)
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
-		refreshCountdown.push_back((int)((REFRESH_PERIOD/tCK)/NUM_RANKS)*(i+1));
+		refreshCountdown.push_back((int)((config.REFRESH_PERIOD/config.tCK)/config.NUM_RANKS)*(i+1));
 	}
 }
 
@@ -120,7 +106,7 @@ void MemoryController::receiveFromBus(BusPacket *bpacket)
 		exit(0);
 	}
 
-	if (DEBUG_BUS)
+	if (config.DEBUG_BUS)
 	{
 		PRINTN(" -- MC Receiving From Data Bus : ");
 		bpacket->print();
@@ -156,9 +142,9 @@ void MemoryController::update()
 	//PRINT(" ------------------------- [" << currentClockCycle << "] -------------------------");
 
 	//update bank states
-	for (size_t i=0;i<NUM_RANKS;i++)
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
-		for (size_t j=0;j<NUM_BANKS;j++)
+		for (size_t j=0;j<config.NUM_BANKS;j++)
 		{
 			if (bankStates[i][j].stateChangeCountdown>0)
 			{
@@ -175,7 +161,7 @@ void MemoryController::update()
 					case READ_P:
 						bankStates[i][j].currentBankState = Precharging;
 						bankStates[i][j].lastCommand = PRECHARGE;
-						bankStates[i][j].stateChangeCountdown = tRP;
+						bankStates[i][j].stateChangeCountdown = config.tRP;
 						break;
 
 					case REFRESH:
@@ -235,7 +221,7 @@ void MemoryController::update()
 		if (writeDataCountdown[0]==0)
 		{
 			//send to bus and print debug stuff
-			if (DEBUG_BUS)
+			if (config.DEBUG_BUS)
 			{
 				PRINTN(" -- MC Issuing On Data Bus    : ");
 				writeDataToSend[0]->print();
@@ -249,7 +235,7 @@ void MemoryController::update()
 			}
 
 			outgoingDataPacket = writeDataToSend[0];
-			dataCyclesLeft = BL/2;
+			dataCyclesLeft = config.BL/2;
 
 			totalTransactions++;
 			totalWritesPerBank[SEQUENTIAL(writeDataToSend[0]->rank,writeDataToSend[0]->bank)]++;
@@ -265,15 +251,15 @@ void MemoryController::update()
 	{
 		commandQueue.needRefresh(refreshRank);
 		(*ranks)[refreshRank]->refreshWaiting = true;
-		refreshCountdown[refreshRank] =	 REFRESH_PERIOD/tCK;
+		refreshCountdown[refreshRank] =	 config.REFRESH_PERIOD/config.tCK;
 		refreshRank++;
-		if (refreshRank == NUM_RANKS)
+		if (refreshRank == config.NUM_RANKS)
 		{
 			refreshRank = 0;
 		}
 	}
 	//if a rank is powered down, make sure we power it up in time for a refresh
-	else if (powerDown[refreshRank] && refreshCountdown[refreshRank] <= tXP)
+	else if (powerDown[refreshRank] && refreshCountdown[refreshRank] <= config.tXP)
 	{
 		(*ranks)[refreshRank]->refreshWaiting = true;
 	}
@@ -289,7 +275,7 @@ void MemoryController::update()
 			writeDataToSend.push_back(new BusPacket(DATA, poppedBusPacket->physicalAddress, poppedBusPacket->column,
 			                                    poppedBusPacket->row, poppedBusPacket->rank, poppedBusPacket->bank,
 			                                    poppedBusPacket->data, dramsim_log));
-			writeDataCountdown.push_back(WL);
+			writeDataCountdown.push_back(config.WL);
 		}
 
 		//
@@ -303,46 +289,46 @@ void MemoryController::update()
 			case READ_P:
 			case READ:
 				//add energy to account for total
-				if (DEBUG_POWER)
+				if (config.DEBUG_POWER)
 				{
 					PRINT(" ++ Adding Read energy to total energy");
 				}
-				burstEnergy[rank] += (IDD4R - IDD3N) * BL/2 * NUM_DEVICES;
+				burstEnergy[rank] += (config.IDD4R - config.IDD3N) * config.BL/2 * config.NUM_DEVICES;
 				if (poppedBusPacket->busPacketType == READ_P) 
 				{
 					//Don't bother setting next read or write times because the bank is no longer active
 					//bankStates[rank][bank].currentBankState = Idle;
-					bankStates[rank][bank].nextActivate = max(currentClockCycle + READ_AUTOPRE_DELAY,
+					bankStates[rank][bank].nextActivate = max(currentClockCycle + config.READ_AUTOPRE_DELAY,
 							bankStates[rank][bank].nextActivate);
 					bankStates[rank][bank].lastCommand = READ_P;
-					bankStates[rank][bank].stateChangeCountdown = READ_TO_PRE_DELAY;
+					bankStates[rank][bank].stateChangeCountdown = config.READ_TO_PRE_DELAY;
 				}
 				else if (poppedBusPacket->busPacketType == READ)
 				{
-					bankStates[rank][bank].nextPrecharge = max(currentClockCycle + READ_TO_PRE_DELAY,
+					bankStates[rank][bank].nextPrecharge = max(currentClockCycle + config.READ_TO_PRE_DELAY,
 							bankStates[rank][bank].nextPrecharge);
 					bankStates[rank][bank].lastCommand = READ;
 
 				}
 
-				for (size_t i=0;i<NUM_RANKS;i++)
+				for (size_t i=0;i<config.NUM_RANKS;i++)
 				{
-					for (size_t j=0;j<NUM_BANKS;j++)
+					for (size_t j=0;j<config.NUM_BANKS;j++)
 					{
 						if (i!=poppedBusPacket->rank)
 						{
 							//check to make sure it is active before trying to set (save's time?)
 							if (bankStates[i][j].currentBankState == RowActive)
 							{
-								bankStates[i][j].nextRead = max(currentClockCycle + BL/2 + tRTRS, bankStates[i][j].nextRead);
-								bankStates[i][j].nextWrite = max(currentClockCycle + READ_TO_WRITE_DELAY,
+								bankStates[i][j].nextRead = max(currentClockCycle + config.BL/2 + config.tRTRS, bankStates[i][j].nextRead);
+								bankStates[i][j].nextWrite = max(currentClockCycle + config.READ_TO_WRITE_DELAY,
 										bankStates[i][j].nextWrite);
 							}
 						}
 						else
 						{
-							bankStates[i][j].nextRead = max(currentClockCycle + max(tCCD, BL/2), bankStates[i][j].nextRead);
-							bankStates[i][j].nextWrite = max(currentClockCycle + READ_TO_WRITE_DELAY,
+							bankStates[i][j].nextRead = max(currentClockCycle + max(config.tCCD, config.BL/2), bankStates[i][j].nextRead);
+							bankStates[i][j].nextWrite = max(currentClockCycle + config.READ_TO_WRITE_DELAY,
 									bankStates[i][j].nextWrite);
 						}
 					}
@@ -362,43 +348,43 @@ void MemoryController::update()
 			case WRITE:
 				if (poppedBusPacket->busPacketType == WRITE_P) 
 				{
-					bankStates[rank][bank].nextActivate = max(currentClockCycle + WRITE_AUTOPRE_DELAY,
+					bankStates[rank][bank].nextActivate = max(currentClockCycle + config.WRITE_AUTOPRE_DELAY,
 							bankStates[rank][bank].nextActivate);
 					bankStates[rank][bank].lastCommand = WRITE_P;
-					bankStates[rank][bank].stateChangeCountdown = WRITE_TO_PRE_DELAY;
+					bankStates[rank][bank].stateChangeCountdown = config.WRITE_TO_PRE_DELAY;
 				}
 				else if (poppedBusPacket->busPacketType == WRITE)
 				{
-					bankStates[rank][bank].nextPrecharge = max(currentClockCycle + WRITE_TO_PRE_DELAY,
+					bankStates[rank][bank].nextPrecharge = max(currentClockCycle + config.WRITE_TO_PRE_DELAY,
 							bankStates[rank][bank].nextPrecharge);
 					bankStates[rank][bank].lastCommand = WRITE;
 				}
 
 
 				//add energy to account for total
-				if (DEBUG_POWER)
+				if (config.DEBUG_POWER)
 				{
 					PRINT(" ++ Adding Write energy to total energy");
 				}
-				burstEnergy[rank] += (IDD4W - IDD3N) * BL/2 * NUM_DEVICES;
+				burstEnergy[rank] += (config.IDD4W - config.IDD3N) * config.BL/2 * config.NUM_DEVICES;
 
-				for (size_t i=0;i<NUM_RANKS;i++)
+				for (size_t i=0;i<config.NUM_RANKS;i++)
 				{
-					for (size_t j=0;j<NUM_BANKS;j++)
+					for (size_t j=0;j<config.NUM_BANKS;j++)
 					{
 						if (i!=poppedBusPacket->rank)
 						{
 							if (bankStates[i][j].currentBankState == RowActive)
 							{
-								bankStates[i][j].nextWrite = max(currentClockCycle + BL/2 + tRTRS, bankStates[i][j].nextWrite);
-								bankStates[i][j].nextRead = max(currentClockCycle + WRITE_TO_READ_DELAY_R,
+								bankStates[i][j].nextWrite = max(currentClockCycle + config.BL/2 + config.tRTRS, bankStates[i][j].nextWrite);
+								bankStates[i][j].nextRead = max(currentClockCycle + config.WRITE_TO_READ_DELAY_R,
 										bankStates[i][j].nextRead);
 							}
 						}
 						else
 						{
-							bankStates[i][j].nextWrite = max(currentClockCycle + max(BL/2, tCCD), bankStates[i][j].nextWrite);
-							bankStates[i][j].nextRead = max(currentClockCycle + WRITE_TO_READ_DELAY_B,
+							bankStates[i][j].nextWrite = max(currentClockCycle + max(config.BL/2, config.tCCD), bankStates[i][j].nextWrite);
+							bankStates[i][j].nextRead = max(currentClockCycle + config.WRITE_TO_READ_DELAY_B,
 									bankStates[i][j].nextRead);
 						}
 					}
@@ -416,28 +402,28 @@ void MemoryController::update()
 				break;
 			case ACTIVATE:
 				//add energy to account for total
-				if (DEBUG_POWER)
+				if (config.DEBUG_POWER)
 				{
 					PRINT(" ++ Adding Activate and Precharge energy to total energy");
 				}
-				actpreEnergy[rank] += ((IDD0 * tRC) - ((IDD3N * tRAS) + (IDD2N * (tRC - tRAS)))) * NUM_DEVICES;
+				actpreEnergy[rank] += ((config.IDD0 * config.tRC) - ((config.IDD3N * config.tRAS) + (config.IDD2N * (config.tRC - config.tRAS)))) * config.NUM_DEVICES;
 
 				bankStates[rank][bank].currentBankState = RowActive;
 				bankStates[rank][bank].lastCommand = ACTIVATE;
 				bankStates[rank][bank].openRowAddress = poppedBusPacket->row;
-				bankStates[rank][bank].nextActivate = max(currentClockCycle + tRC, bankStates[rank][bank].nextActivate);
-				bankStates[rank][bank].nextPrecharge = max(currentClockCycle + tRAS, bankStates[rank][bank].nextPrecharge);
+				bankStates[rank][bank].nextActivate = max(currentClockCycle + config.tRC, bankStates[rank][bank].nextActivate);
+				bankStates[rank][bank].nextPrecharge = max(currentClockCycle + config.tRAS, bankStates[rank][bank].nextPrecharge);
 
 				//if we are using posted-CAS, the next column access can be sooner than normal operation
 
-				bankStates[rank][bank].nextRead = max(currentClockCycle + (tRCD-AL), bankStates[rank][bank].nextRead);
-				bankStates[rank][bank].nextWrite = max(currentClockCycle + (tRCD-AL), bankStates[rank][bank].nextWrite);
+				bankStates[rank][bank].nextRead = max(currentClockCycle + (config.tRCD-config.AL), bankStates[rank][bank].nextRead);
+				bankStates[rank][bank].nextWrite = max(currentClockCycle + (config.tRCD-config.AL), bankStates[rank][bank].nextWrite);
 
-				for (size_t i=0;i<NUM_BANKS;i++)
+				for (size_t i=0;i<config.NUM_BANKS;i++)
 				{
 					if (i!=poppedBusPacket->bank)
 					{
-						bankStates[rank][i].nextActivate = max(currentClockCycle + tRRD, bankStates[rank][i].nextActivate);
+						bankStates[rank][i].nextActivate = max(currentClockCycle + config.tRRD, bankStates[rank][i].nextActivate);
 					}
 				}
 
@@ -445,24 +431,24 @@ void MemoryController::update()
 			case PRECHARGE:
 				bankStates[rank][bank].currentBankState = Precharging;
 				bankStates[rank][bank].lastCommand = PRECHARGE;
-				bankStates[rank][bank].stateChangeCountdown = tRP;
-				bankStates[rank][bank].nextActivate = max(currentClockCycle + tRP, bankStates[rank][bank].nextActivate);
+				bankStates[rank][bank].stateChangeCountdown = config.tRP;
+				bankStates[rank][bank].nextActivate = max(currentClockCycle + config.tRP, bankStates[rank][bank].nextActivate);
 
 				break;
 			case REFRESH:
 				//add energy to account for total
-				if (DEBUG_POWER)
+				if (config.DEBUG_POWER)
 				{
 					PRINT(" ++ Adding Refresh energy to total energy");
 				}
-				refreshEnergy[rank] += (IDD5 - IDD3N) * tRFC * NUM_DEVICES;
+				refreshEnergy[rank] += (config.IDD5 - config.IDD3N) * config.tRFC * config.NUM_DEVICES;
 
-				for (size_t i=0;i<NUM_BANKS;i++)
+				for (size_t i=0;i<config.NUM_BANKS;i++)
 				{
-					bankStates[rank][i].nextActivate = currentClockCycle + tRFC;
+					bankStates[rank][i].nextActivate = currentClockCycle + config.tRFC;
 					bankStates[rank][i].currentBankState = Refreshing;
 					bankStates[rank][i].lastCommand = REFRESH;
-					bankStates[rank][i].stateChangeCountdown = tRFC;
+					bankStates[rank][i].stateChangeCountdown = config.tRFC;
 				}
 
 				break;
@@ -472,7 +458,7 @@ void MemoryController::update()
 		}
 
 		//issue on bus and print debug
-		if (DEBUG_BUS)
+		if (config.DEBUG_BUS)
 		{
 			PRINTN(" -- MC Issuing On Command Bus : ");
 			poppedBusPacket->print();
@@ -485,7 +471,7 @@ void MemoryController::update()
 			exit(-1);
 		}
 		outgoingCmdPacket = poppedBusPacket;
-		cmdCyclesLeft = tCMD;
+		cmdCyclesLeft = config.tCMD;
 
 	}
 
@@ -501,13 +487,13 @@ void MemoryController::update()
 		unsigned newTransactionChan, newTransactionRank, newTransactionBank, newTransactionRow, newTransactionColumn;
 
 		// pass these in as references so they get set by the addressMapping function
-		addressMapping(transaction->address, newTransactionChan, newTransactionRank, newTransactionBank, newTransactionRow, newTransactionColumn);
+		addressMapping(config, transaction->address, newTransactionChan, newTransactionRank, newTransactionBank, newTransactionRow, newTransactionColumn);
 
 		//if we have room, break up the transaction into the appropriate commands
 		//and add them to the command queue
 		if (commandQueue.hasRoomFor(2, newTransactionRank, newTransactionBank))
 		{
-			if (DEBUG_ADDR_MAP) 
+			if (config.DEBUG_ADDR_MAP) 
 			{
 				PRINTN("== New Transaction - Mapping Address [0x" << hex << transaction->address << dec << "]");
 				if (transaction->transactionType == DATA_READ) 
@@ -535,7 +521,7 @@ void MemoryController::update()
 					newTransactionBank, 0, dramsim_log);
 
 			//create read or write command and enqueue it
-			BusPacketType bpType = transaction->getBusPacketType();
+			BusPacketType bpType = transaction->getBusPacketType(config.rowBufferPolicy);
 			BusPacket *command = new BusPacket(bpType, transaction->address,
 					newTransactionColumn, newTransactionRow, newTransactionRank,
 					newTransactionBank, transaction->data, dramsim_log);
@@ -572,16 +558,16 @@ void MemoryController::update()
 
 	//calculate power
 	//  this is done on a per-rank basis, since power characterization is done per device (not per bank)
-	for (size_t i=0;i<NUM_RANKS;i++)
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
-		if (USE_LOW_POWER)
+		if (config.USE_LOW_POWER)
 		{
 			//if there are no commands in the queue and that particular rank is not waiting for a refresh...
 			if (commandQueue.isEmpty(i) && !(*ranks)[i]->refreshWaiting)
 			{
 				//check to make sure all banks are idle
 				bool allIdle = true;
-				for (size_t j=0;j<NUM_BANKS;j++)
+				for (size_t j=0;j<config.NUM_BANKS;j++)
 				{
 					if (bankStates[i][j].currentBankState != Idle)
 					{
@@ -595,10 +581,10 @@ void MemoryController::update()
 				{
 					powerDown[i] = true;
 					(*ranks)[i]->powerDown();
-					for (size_t j=0;j<NUM_BANKS;j++)
+					for (size_t j=0;j<config.NUM_BANKS;j++)
 					{
 						bankStates[i][j].currentBankState = PowerDown;
-						bankStates[i][j].nextPowerUp = currentClockCycle + tCKE;
+						bankStates[i][j].nextPowerUp = currentClockCycle + config.tCKE;
 					}
 				}
 			}
@@ -607,17 +593,17 @@ void MemoryController::update()
 			{
 				powerDown[i] = false;
 				(*ranks)[i]->powerUp();
-				for (size_t j=0;j<NUM_BANKS;j++)
+				for (size_t j=0;j<config.NUM_BANKS;j++)
 				{
 					bankStates[i][j].currentBankState = Idle;
-					bankStates[i][j].nextActivate = currentClockCycle + tXP;
+					bankStates[i][j].nextActivate = currentClockCycle + config.tXP;
 				}
 			}
 		}
 
 		//check for open bank
 		bool bankOpen = false;
-		for (size_t j=0;j<NUM_BANKS;j++)
+		for (size_t j=0;j<config.NUM_BANKS;j++)
 		{
 			if (bankStates[i][j].currentBankState == Refreshing ||
 			        bankStates[i][j].currentBankState == RowActive)
@@ -630,30 +616,30 @@ void MemoryController::update()
 		//background power is dependent on whether or not a bank is open or not
 		if (bankOpen)
 		{
-			if (DEBUG_POWER)
+			if (config.DEBUG_POWER)
 			{
 				PRINT(" ++ Adding IDD3N to total energy [from rank "<< i <<"]");
 			}
-			backgroundEnergy[i] += IDD3N * NUM_DEVICES;
+			backgroundEnergy[i] += config.IDD3N * config.NUM_DEVICES;
 		}
 		else
 		{
 			//if we're in power-down mode, use the correct current
 			if (powerDown[i])
 			{
-				if (DEBUG_POWER)
+				if (config.DEBUG_POWER)
 				{
 					PRINT(" ++ Adding IDD2P to total energy [from rank " << i << "]");
 				}
-				backgroundEnergy[i] += IDD2P * NUM_DEVICES;
+				backgroundEnergy[i] += config.IDD2P * config.NUM_DEVICES;
 			}
 			else
 			{
-				if (DEBUG_POWER)
+				if (config.DEBUG_POWER)
 				{
 					PRINT(" ++ Adding IDD2N to total energy [from rank " << i << "]");
 				}
-				backgroundEnergy[i] += IDD2N * NUM_DEVICES;
+				backgroundEnergy[i] += config.IDD2N * config.NUM_DEVICES;
 			}
 		}
 	}
@@ -661,7 +647,7 @@ void MemoryController::update()
 	//check for outstanding data to return to the CPU
 	if (returnTransaction.size()>0)
 	{
-		if (DEBUG_BUS)
+		if (config.DEBUG_BUS)
 		{
 			PRINTN(" -- MC Issuing to CPU bus : " << *returnTransaction[0]);
 		}
@@ -679,7 +665,7 @@ void MemoryController::update()
 				//		exit(0);
 				//	}
 				unsigned chan,rank,bank,row,col;
-				addressMapping(returnTransaction[0]->address,chan,rank,bank,row,col);
+				addressMapping(config, returnTransaction[0]->address,chan,rank,bank,row,col);
 				insertHistogram(currentClockCycle-pendingReadTransactions[i]->timeAdded,rank,bank);
 				//return latency
 				returnReadData(pendingReadTransactions[i]);
@@ -700,7 +686,7 @@ void MemoryController::update()
 	}
 
 	//decrement refresh counters
-	for (size_t i=0;i<NUM_RANKS;i++)
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
 		refreshCountdown[i]--;
 	}
@@ -708,7 +694,7 @@ void MemoryController::update()
 	//
 	//print debug
 	//
-	if (DEBUG_TRANS_Q)
+	if (config.DEBUG_TRANS_Q)
 	{
 		PRINT("== Printing transaction queue");
 		for (size_t i=0;i<transactionQueue.size();i++)
@@ -717,13 +703,13 @@ void MemoryController::update()
 		}
 	}
 
-	if (DEBUG_BANKSTATE)
+	if (config.DEBUG_BANKSTATE)
 	{
 		//TODO: move this to BankState.cpp
 		PRINT("== Printing bank states (According to MC)");
-		for (size_t i=0;i<NUM_RANKS;i++)
+		for (size_t i=0;i<config.NUM_RANKS;i++)
 		{
-			for (size_t j=0;j<NUM_BANKS;j++)
+			for (size_t j=0;j<config.NUM_BANKS;j++)
 			{
 				if (bankStates[i][j].currentBankState == RowActive)
 				{
@@ -750,7 +736,7 @@ void MemoryController::update()
 		}
 	}
 
-	if (DEBUG_CMD_Q)
+	if (config.DEBUG_CMD_Q)
 	{
 		commandQueue.print();
 	}
@@ -761,7 +747,7 @@ void MemoryController::update()
 
 bool MemoryController::WillAcceptTransaction()
 {
-	return transactionQueue.size() < TRANS_QUEUE_DEPTH;
+	return transactionQueue.size() < config.TRANS_QUEUE_DEPTH;
 }
 
 //allows outside source to make request of memory system
@@ -781,9 +767,9 @@ bool MemoryController::addTransaction(Transaction *trans)
 
 void MemoryController::resetStats()
 {
-	for (size_t i=0; i<NUM_RANKS; i++)
+	for (size_t i=0; i<config.NUM_RANKS; i++)
 	{
-		for (size_t j=0; j<NUM_BANKS; j++)
+		for (size_t j=0; j<config.NUM_BANKS; j++)
 		{
 			//XXX: this means the bank list won't be printed for partial epochs
 			grandTotalBankAccesses[SEQUENTIAL(i,j)] += totalReadsPerBank[SEQUENTIAL(i,j)] + totalWritesPerBank[SEQUENTIAL(i,j)];
@@ -807,29 +793,29 @@ void MemoryController::printStats(bool finalStats)
 
 	//if we are not at the end of the epoch, make sure to adjust for the actual number of cycles elapsed
 
-	uint64_t cyclesElapsed = (currentClockCycle % EPOCH_LENGTH == 0) ? EPOCH_LENGTH : currentClockCycle % EPOCH_LENGTH;
-	unsigned bytesPerTransaction = (JEDEC_DATA_BUS_BITS*BL)/8;
+	uint64_t cyclesElapsed = (currentClockCycle % config.EPOCH_LENGTH == 0) ? config.EPOCH_LENGTH : currentClockCycle % config.EPOCH_LENGTH;
+	unsigned bytesPerTransaction = (config.JEDEC_DATA_BUS_BITS*config.BL)/8;
 	uint64_t totalBytesTransferred = totalTransactions * bytesPerTransaction;
-	double secondsThisEpoch = (double)cyclesElapsed * tCK * 1E-9;
+	double secondsThisEpoch = (double)cyclesElapsed * config.tCK * 1E-9;
 
 	// only per rank
-	vector<double> backgroundPower = vector<double>(NUM_RANKS,0.0);
-	vector<double> burstPower = vector<double>(NUM_RANKS,0.0);
-	vector<double> refreshPower = vector<double>(NUM_RANKS,0.0);
-	vector<double> actprePower = vector<double>(NUM_RANKS,0.0);
-	vector<double> averagePower = vector<double>(NUM_RANKS,0.0);
+	vector<double> backgroundPower = vector<double>(config.NUM_RANKS,0.0);
+	vector<double> burstPower = vector<double>(config.NUM_RANKS,0.0);
+	vector<double> refreshPower = vector<double>(config.NUM_RANKS,0.0);
+	vector<double> actprePower = vector<double>(config.NUM_RANKS,0.0);
+	vector<double> averagePower = vector<double>(config.NUM_RANKS,0.0);
 
 	// per bank variables
-	vector<double> averageLatency = vector<double>(NUM_RANKS*NUM_BANKS,0.0);
-	vector<double> bandwidth = vector<double>(NUM_RANKS*NUM_BANKS,0.0);
+	vector<double> averageLatency = vector<double>(config.NUM_RANKS*config.NUM_BANKS,0.0);
+	vector<double> bandwidth = vector<double>(config.NUM_RANKS*config.NUM_BANKS,0.0);
 
 	double totalBandwidth=0.0;
-	for (size_t i=0;i<NUM_RANKS;i++)
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
-		for (size_t j=0; j<NUM_BANKS; j++)
+		for (size_t j=0; j<config.NUM_BANKS; j++)
 		{
 			bandwidth[SEQUENTIAL(i,j)] = (((double)(totalReadsPerBank[SEQUENTIAL(i,j)]+totalWritesPerBank[SEQUENTIAL(i,j)]) * (double)bytesPerTransaction)/(1024.0*1024.0*1024.0)) / secondsThisEpoch;
-			averageLatency[SEQUENTIAL(i,j)] = ((float)totalEpochLatency[SEQUENTIAL(i,j)] / (float)(totalReadsPerBank[SEQUENTIAL(i,j)])) * tCK;
+			averageLatency[SEQUENTIAL(i,j)] = ((float)totalEpochLatency[SEQUENTIAL(i,j)] / (float)(totalReadsPerBank[SEQUENTIAL(i,j)])) * config.tCK;
 			totalBandwidth+=bandwidth[SEQUENTIAL(i,j)];
 			totalReadsPerRank[i] += totalReadsPerBank[SEQUENTIAL(i,j)];
 			totalWritesPerRank[i] += totalWritesPerBank[SEQUENTIAL(i,j)];
@@ -849,7 +835,7 @@ void MemoryController::printStats(bool finalStats)
 	PRINT( " ("<<totalBytesTransferred <<" bytes) aggregate average bandwidth "<<totalBandwidth<<"GB/s");
 
 	double totalAggregateBandwidth = 0.0;	
-	for (size_t r=0;r<NUM_RANKS;r++)
+	for (size_t r=0;r<config.NUM_RANKS;r++)
 	{
 
 		PRINT( "      -Rank   "<<r<<" : ");
@@ -857,17 +843,17 @@ void MemoryController::printStats(bool finalStats)
 		PRINT( " ("<<totalReadsPerRank[r] * bytesPerTransaction<<" bytes)");
 		PRINTN( "        -Writes : " << totalWritesPerRank[r]);
 		PRINT( " ("<<totalWritesPerRank[r] * bytesPerTransaction<<" bytes)");
-		for (size_t j=0;j<NUM_BANKS;j++)
+		for (size_t j=0;j<config.NUM_BANKS;j++)
 		{
 			PRINT( "        -Bandwidth / Latency  (Bank " <<j<<"): " <<bandwidth[SEQUENTIAL(r,j)] << " GB/s\t\t" <<averageLatency[SEQUENTIAL(r,j)] << " ns");
 		}
 
 		// factor of 1000 at the end is to account for the fact that totalEnergy is accumulated in mJ since IDD values are given in mA
-		backgroundPower[r] = ((double)backgroundEnergy[r] / (double)(cyclesElapsed)) * Vdd / 1000.0;
-		burstPower[r] = ((double)burstEnergy[r] / (double)(cyclesElapsed)) * Vdd / 1000.0;
-		refreshPower[r] = ((double) refreshEnergy[r] / (double)(cyclesElapsed)) * Vdd / 1000.0;
-		actprePower[r] = ((double)actpreEnergy[r] / (double)(cyclesElapsed)) * Vdd / 1000.0;
-		averagePower[r] = ((backgroundEnergy[r] + burstEnergy[r] + refreshEnergy[r] + actpreEnergy[r]) / (double)cyclesElapsed) * Vdd / 1000.0;
+		backgroundPower[r] = ((double)backgroundEnergy[r] / (double)(cyclesElapsed)) * config.Vdd / 1000.0;
+		burstPower[r] = ((double)burstEnergy[r] / (double)(cyclesElapsed)) * config.Vdd / 1000.0;
+		refreshPower[r] = ((double) refreshEnergy[r] / (double)(cyclesElapsed)) * config.Vdd / 1000.0;
+		actprePower[r] = ((double)actpreEnergy[r] / (double)(cyclesElapsed)) * config.Vdd / 1000.0;
+		averagePower[r] = ((backgroundEnergy[r] + burstEnergy[r] + refreshEnergy[r] + actpreEnergy[r]) / (double)cyclesElapsed) * config.Vdd / 1000.0;
 
 		if ((*parentMemorySystem->ReportPower)!=NULL)
 		{
@@ -881,7 +867,7 @@ void MemoryController::printStats(bool finalStats)
 		PRINT( "     -Burst      (watts)     : " << burstPower[r]);
 		PRINT( "     -Refresh    (watts)     : " << refreshPower[r] );
 
-		if (VIS_FILE_OUTPUT)
+		if (config.VIS_FILE_OUTPUT)
 		{
 		//	cout << "c="<<myChannel<< " r="<<r<<"writing to csv out on cycle "<< currentClockCycle<<endl;
 			// write the vis file output
@@ -890,7 +876,7 @@ void MemoryController::printStats(bool finalStats)
 			csvOut << CSVWriter::IndexedName("Burst_Power",myChannel,r) << burstPower[r];
 			csvOut << CSVWriter::IndexedName("Refresh_Power",myChannel,r) << refreshPower[r];
 			double totalRankBandwidth=0.0;
-			for (size_t b=0; b<NUM_BANKS; b++)
+			for (size_t b=0; b<config.NUM_BANKS; b++)
 			{
 				csvOut << CSVWriter::IndexedName("Bandwidth",myChannel,r,b) << bandwidth[SEQUENTIAL(r,b)];
 				totalRankBandwidth += bandwidth[SEQUENTIAL(r,b)];
@@ -898,13 +884,13 @@ void MemoryController::printStats(bool finalStats)
 				csvOut << CSVWriter::IndexedName("Average_Latency",myChannel,r,b) << averageLatency[SEQUENTIAL(r,b)];
 			}
 			csvOut << CSVWriter::IndexedName("Rank_Aggregate_Bandwidth",myChannel,r) << totalRankBandwidth; 
-			csvOut << CSVWriter::IndexedName("Rank_Average_Bandwidth",myChannel,r) << totalRankBandwidth/NUM_RANKS; 
+			csvOut << CSVWriter::IndexedName("Rank_Average_Bandwidth",myChannel,r) << totalRankBandwidth/config.NUM_RANKS; 
 		}
 	}
-	if (VIS_FILE_OUTPUT)
+	if (config.VIS_FILE_OUTPUT)
 	{
 		csvOut << CSVWriter::IndexedName("Aggregate_Bandwidth",myChannel) << totalAggregateBandwidth;
-		csvOut << CSVWriter::IndexedName("Average_Bandwidth",myChannel) << totalAggregateBandwidth / (NUM_RANKS*NUM_BANKS);
+		csvOut << CSVWriter::IndexedName("Average_Bandwidth",myChannel) << totalAggregateBandwidth / (config.NUM_RANKS*config.NUM_BANKS);
 	}
 
 	// only print the latency histogram at the end of the simulation since it clogs the output too much to print every epoch
@@ -912,7 +898,7 @@ void MemoryController::printStats(bool finalStats)
 	{
 		PRINT( " ---  Latency list ("<<latencies.size()<<")");
 		PRINT( "       [lat] : #");
-		if (VIS_FILE_OUTPUT)
+		if (config.VIS_FILE_OUTPUT)
 		{
 			csvOut.getOutputStream() << "!!HISTOGRAM_DATA"<<endl;
 		}
@@ -921,18 +907,18 @@ void MemoryController::printStats(bool finalStats)
 		for (it=latencies.begin(); it!=latencies.end(); it++)
 		{
 			PRINT( "       ["<< it->first <<"-"<<it->first+(HISTOGRAM_BIN_SIZE-1)<<"] : "<< it->second );
-			if (VIS_FILE_OUTPUT)
+			if (config.VIS_FILE_OUTPUT)
 			{
 				csvOut.getOutputStream() << it->first <<"="<< it->second << endl;
 			}
 		}
-		if (currentClockCycle % EPOCH_LENGTH == 0)
+		if (currentClockCycle % config.EPOCH_LENGTH == 0)
 		{
 			PRINT( " --- Grand Total Bank usage list");
-			for (size_t i=0;i<NUM_RANKS;i++)
+			for (size_t i=0;i<config.NUM_RANKS;i++)
 			{
 				PRINT("Rank "<<i<<":"); 
-				for (size_t j=0;j<NUM_BANKS;j++)
+				for (size_t j=0;j<config.NUM_BANKS;j++)
 				{
 					PRINT( "  b"<<j<<": "<<grandTotalBankAccesses[SEQUENTIAL(i,j)]);
 				}
@@ -955,6 +941,121 @@ void MemoryController::printStats(bool finalStats)
 
 	resetStats();
 }
+//Drop all the transactions and packets in flight and go back to the initial state
+void MemoryController::reset()
+{
+	for (size_t i=0; i<transactionQueue.size(); i++)
+	{
+		delete transactionQueue[i];
+	}
+	transactionQueue.clear();
+	for (size_t i=0; i<pendingReadTransactions.size(); i++)
+	{
+		delete pendingReadTransactions[i];
+	}
+	pendingReadTransactions.clear();
+	for (size_t i=0; i<returnTransaction.size(); i++)
+	{
+		delete returnTransaction[i];
+	}
+	returnTransaction.clear();
+	for (size_t i=0; i<writeDataToSend.size(); i++)
+	{
+		delete writeDataToSend[i];
+	}
+	writeDataToSend.clear();
+	writeDataCountdown.clear();
+
+	commandQueue.reset();
+	for (size_t r=0; r<bankStates.size(); r++)
+	{
+		for (size_t b=0; b<bankStates[r].size(); b++)
+		{
+			bankStates[r][b].reset();
+		}
+	}
+
+	//the popped packet is the outgoing command packet, so it is freed only once
+	delete outgoingCmdPacket;
+	delete outgoingDataPacket;
+	poppedBusPacket = NULL;
+	outgoingCmdPacket = NULL;
+	outgoingDataPacket = NULL;
+	cmdCyclesLeft = 0;
+	dataCyclesLeft = 0;
+
+	latencies.clear();
+	totalTransactions = 0;
+	refreshRank = 0;
+	currentClockCycle = 0;
+
+	std::fill(powerDown.begin(), powerDown.end(), false);
+	resetStats();
+	std::fill(grandTotalBankAccesses.begin(), grandTotalBankAccesses.end(), 0);
+
+	for (size_t i=0;i<config.NUM_RANKS;i++)
+	{
+		refreshCountdown[i] = (int)((config.REFRESH_PERIOD/config.tCK)/config.NUM_RANKS)*(i+1);
+	}
+}
+
+//Number of cycles until something can happen in the controller or the ranks
+//	Only the clocks, the refresh counters and the background energy change while
+//	there are no transactions or commands in flight, so these cycles can be skipped
+uint64_t MemoryController::getIdleCycles()
+{
+	if (!transactionQueue.empty() || !pendingReadTransactions.empty() || !returnTransaction.empty() ||
+			!writeDataToSend.empty() || outgoingCmdPacket != NULL || outgoingDataPacket != NULL ||
+			!commandQueue.isIdle())
+	{
+		return 0;
+	}
+
+	for (size_t i=0;i<config.NUM_RANKS;i++)
+	{
+		if (!(*ranks)[i]->isIdle())
+		{
+			return 0;
+		}
+
+		//an idle rank is powered down in the next cycle
+		if (config.USE_LOW_POWER && !powerDown[i])
+		{
+			return 0;
+		}
+
+		CurrentBankState expected = powerDown[i] ? PowerDown : Idle;
+		for (size_t j=0;j<config.NUM_BANKS;j++)
+		{
+			if (bankStates[i][j].currentBankState != expected || bankStates[i][j].stateChangeCountdown > 0)
+			{
+				return 0;
+			}
+		}
+	}
+
+	//a powered down rank is woken up tXP cycles before its refresh
+	uint64_t countdown = refreshCountdown[refreshRank];
+	if (powerDown[refreshRank])
+	{
+		return countdown > config.tXP ? countdown - config.tXP : 0;
+	}
+	return countdown;
+}
+
+//Advance an idle controller the given number of cycles, see getIdleCycles()
+void MemoryController::skipIdleCycles(uint64_t cycles)
+{
+	for (size_t i=0;i<config.NUM_RANKS;i++)
+	{
+		backgroundEnergy[i] += cycles * (powerDown[i] ? config.IDD2P : config.IDD2N) * config.NUM_DEVICES;
+		refreshCountdown[i] -= cycles;
+		(*ranks)[i]->currentClockCycle += cycles;
+	}
+	commandQueue.currentClockCycle += cycles;
+	currentClockCycle += cycles;
+}
+
 MemoryController::~MemoryController()
 {
 	//ERROR("MEMORY CONTROLLER DESTRUCTOR");
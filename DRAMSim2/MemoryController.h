@@ -57,7 +57,7 @@ class MemoryController : public SimulatorObject
 
 public:
 	//functions
-	MemoryController(MemorySystem* ms, CSVWriter &csvOut_, ostream &dramsim_log_);
+	MemoryController(MemorySystem* ms, const Config &config_, CSVWriter &csvOut_, ostream &dramsim_log_);
 	virtual ~MemoryController();
 
 	bool addTransaction(Transaction *trans);
@@ -68,11 +68,15 @@ public:
 	void update();
 	void printStats(bool finalStats = false);
 	void resetStats(); 
+	void reset();
+	uint64_t getIdleCycles();
+	void skipIdleCycles(uint64_t cycles);
 
 
 	//fields
 	vector<Transaction *> transactionQueue;
 private:
+	const Config &config;
 	ostream &dramsim_log;
 	vector< vector <BankState> > bankStates;
 	//functions
@@ -43,20 +43,16 @@
 using namespace std;
 
 
-ofstream cmd_verify_out; //used in Rank.cpp and MemoryController.cpp if VERIFICATION_OUTPUT is set
-
-unsigned NUM_DEVICES;
-unsigned NUM_RANKS;
-unsigned NUM_RANKS_LOG;
+thread_local ofstream cmd_verify_out; //used in Rank.cpp and MemoryController.cpp if VERIFICATION_OUTPUT is set
 
 namespace DRAMSim {
 
-powerCallBack_t MemorySystem::ReportPower = NULL;
-
-MemorySystem::MemorySystem(unsigned id, unsigned int megsOfMemory, CSVWriter &csvOut_, ostream &dramsim_log_) :
+MemorySystem::MemorySystem(unsigned id, const Config &config_, CSVWriter &csvOut_, ostream &dramsim_log_) :
+		config(config_),
 		dramsim_log(dramsim_log_),
 		ReturnReadData(NULL),
 		WriteDataDone(NULL),
+		ReportPower(NULL),
 		systemID(id),
 		csvOut(csvOut_)
 {
@@ -64,9 +60,32 @@ MemorySystem::MemorySystem(unsigned id, unsigned int megsOfMemory, CSVWriter &cs
 
 	DEBUG("===== MemorySystem "<<systemID<<" =====");
 
+	DEBUG("CH. " <<systemID<<" TOTAL_STORAGE : "<< config.TOTAL_STORAGE << "MB | "<<config.NUM_RANKS<<" Ranks | "<< config.NUM_DEVICES <<" Devices per rank");
+
 
-	//calculate the total storage based on the devices the user selected and the number of
+	memoryController = new MemoryController(this, config, csvOut, dramsim_log);
+
+	// TODO: change to other vector constructor?
+	ranks = new vector<Rank *>();
 
+	for (size_t i=0; i<config.NUM_RANKS; i++)
+	{
+		Rank *r = new Rank(config, dramsim_log);
+		r->setId(i);
+		r->attachMemoryController(memoryController);
+		ranks->push_back(r);
+	}
+
+	memoryController->attachRanks(ranks);
+
+}
+
+
+
+//calculate the total storage based on the devices the user selected and the number of
+//ranks, the results are stored in the NUM_RANKS, NUM_DEVICES and TOTAL_STORAGE fields of config
+void MemorySystem::configureRanks(Config &config, unsigned megsOfMemory, ostream &dramsim_log)
+{
 	//calculate number of devices
 	/************************
 	  This code has always been problematic even though it's pretty simple. I'll try to explain it 
@@ -110,44 +129,56 @@ MemorySystem::MemorySystem(unsigned id, unsigned int megsOfMemory, CSVWriter &cs
 	*********************/
 
 	// number of bytes per rank
-	unsigned long megsOfStoragePerRank = ((((long long)NUM_ROWS * (NUM_COLS * DEVICE_WIDTH) * NUM_BANKS) * ((long long)JEDEC_DATA_BUS_BITS / DEVICE_WIDTH)) / 8) >> 20;
+	unsigned long megsOfStoragePerRank = ((((long long)config.NUM_ROWS * (config.NUM_COLS * config.DEVICE_WIDTH) * config.NUM_BANKS) * ((long long)config.JEDEC_DATA_BUS_BITS / config.DEVICE_WIDTH)) / 8) >> 20;
 
 	// If this is set, effectively override the number of ranks
 	if (megsOfMemory != 0)
 	{
-		NUM_RANKS = megsOfMemory / megsOfStoragePerRank;
-		NUM_RANKS_LOG = dramsim_log2(NUM_RANKS);
-		if (NUM_RANKS == 0)
+		config.NUM_RANKS = megsOfMemory / megsOfStoragePerRank;
+		config.NUM_RANKS_LOG = dramsim_log2(config.NUM_RANKS);
+		if (config.NUM_RANKS == 0)
 		{
 			PRINT("WARNING: Cannot create memory system with "<<megsOfMemory<<"MB, defaulting to minimum size of "<<megsOfStoragePerRank<<"MB");
-			NUM_RANKS=1;
+			config.NUM_RANKS=1;
 		}
 	}
 
-	NUM_DEVICES = JEDEC_DATA_BUS_BITS/DEVICE_WIDTH;
-	TOTAL_STORAGE = (NUM_RANKS * megsOfStoragePerRank); 
-
-	DEBUG("CH. " <<systemID<<" TOTAL_STORAGE : "<< TOTAL_STORAGE << "MB | "<<NUM_RANKS<<" Ranks | "<< NUM_DEVICES <<" Devices per rank");
-
-
-	memoryController = new MemoryController(this, csvOut, dramsim_log);
-
-	// TODO: change to other vector constructor?
-	ranks = new vector<Rank *>();
+	config.NUM_DEVICES = config.JEDEC_DATA_BUS_BITS/config.DEVICE_WIDTH;
+	config.TOTAL_STORAGE = (config.NUM_RANKS * megsOfStoragePerRank); 
+}
 
-	for (size_t i=0; i<NUM_RANKS; i++)
+//Drop all the transactions in flight and go back to the initial state
+void MemorySystem::reset()
+{
+	currentClockCycle = 0;
+	for (size_t i=0; i<pendingTransactions.size(); i++)
 	{
-		Rank *r = new Rank(dramsim_log);
-		r->setId(i);
-		r->attachMemoryController(memoryController);
-		ranks->push_back(r);
+		delete pendingTransactions[i];
 	}
+	pendingTransactions.clear();
 
-	memoryController->attachRanks(ranks);
-
+	memoryController->reset();
+	for (size_t i=0; i<ranks->size(); i++)
+	{
+		(*ranks)[i]->reset();
+	}
 }
 
+//Number of cycles this channel can be advanced without simulating them
+uint64_t MemorySystem::getIdleCycles()
+{
+	if (!pendingTransactions.empty())
+	{
+		return 0;
+	}
+	return memoryController->getIdleCycles();
+}
 
+void MemorySystem::skipIdleCycles(uint64_t cycles)
+{
+	memoryController->skipIdleCycles(cycles);
+	currentClockCycle += cycles;
+}
 
 MemorySystem::~MemorySystem()
 {
@@ -157,14 +188,14 @@ MemorySystem::~MemorySystem()
 
 	delete(memoryController);
 
-	for (size_t i=0; i<NUM_RANKS; i++)
+	for (size_t i=0; i<config.NUM_RANKS; i++)
 	{
 		delete (*ranks)[i];
 	}
 	ranks->clear();
 	delete(ranks);
 
-	if (VERIFICATION_OUTPUT)
+	if (config.VERIFICATION_OUTPUT)
 	{
 		cmd_verify_out.flush();
 		cmd_verify_out.close();
@@ -214,7 +245,7 @@ void MemorySystem::update()
 
 	//updates the state of each of the objects
 	// NOTE - do not change order
-	for (size_t i=0;i<NUM_RANKS;i++)
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
 		(*ranks)[i]->update();
 	}
@@ -228,7 +259,7 @@ void MemorySystem::update()
 	memoryController->update();
 
 	//simply increments the currentClockCycle field for each object
-	for (size_t i=0;i<NUM_RANKS;i++)
+	for (size_t i=0;i<config.NUM_RANKS;i++)
 	{
 		(*ranks)[i]->step();
 	}
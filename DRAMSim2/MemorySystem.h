@@ -52,16 +52,21 @@ namespace DRAMSim
 typedef CallbackBase<void,unsigned,uint64_t,uint64_t> Callback_t;
 class MemorySystem : public SimulatorObject
 {
+	const Config &config;
 	ostream &dramsim_log;
 public:
 	//functions
-	MemorySystem(unsigned id, unsigned megsOfMemory, CSVWriter &csvOut_, ostream &dramsim_log_);
+	MemorySystem(unsigned id, const Config &config_, CSVWriter &csvOut_, ostream &dramsim_log_);
 	virtual ~MemorySystem();
 	void update();
 	bool addTransaction(Transaction *trans);
 	bool addTransaction(bool isWrite, uint64_t addr);
 	void printStats(bool finalStats);
 	bool WillAcceptTransaction();
+	void reset();
+	uint64_t getIdleCycles();
+	void skipIdleCycles(uint64_t cycles);
+	static void configureRanks(Config &config, unsigned megsOfMemory, ostream &dramsim_log);
 	void RegisterCallbacks(
 	    Callback_t *readDone,
 	    Callback_t *writeDone,
@@ -77,7 +82,7 @@ public:
 	Callback_t* ReturnReadData;
 	Callback_t* WriteDataDone;
 	//TODO: make this a functor as well?
-	static powerCallBack_t ReportPower;
+	powerCallBack_t ReportPower;
 	unsigned systemID;
 
 private:
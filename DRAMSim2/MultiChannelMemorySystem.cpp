@@ -42,11 +42,10 @@
 
 using namespace DRAMSim; 
 
-
-MultiChannelMemorySystem::MultiChannelMemorySystem(const string &deviceIniFilename_, const string &systemIniFilename_, const string &pwd_, const string &traceFilename_, unsigned megsOfMemory_, string *visFilename_, const IniReader::OverrideMap *paramOverrides)
+MultiChannelMemorySystem::MultiChannelMemorySystem(const string &deviceIniFilename_, const string &systemIniFilename_, const string &pwd_, const string &traceFilename_, unsigned megsOfMemory_, string *visFilename_, const IniReader::OverrideMap *paramOverrides_)
 	:megsOfMemory(megsOfMemory_), deviceIniFilename(deviceIniFilename_),
 	systemIniFilename(systemIniFilename_), traceFilename(traceFilename_),
-	pwd(pwd_), visFilename(visFilename_), 
+	pwd(pwd_), visFilename(visFilename_), iniReader(config),
 	clockDomainCrosser(new ClockDomain::Callback<MultiChannelMemorySystem, void>(this, &MultiChannelMemorySystem::actual_update)),
 	csvOut(new CSVWriter(visDataOut))
 {
@@ -74,39 +73,86 @@ MultiChannelMemorySystem::MultiChannelMemorySystem(const string &deviceIniFilena
 		}
 	}
 
+	if (paramOverrides_)
+		paramOverrides = *paramOverrides_;
+
+	loadConfiguration();
+
+	for (size_t i=0; i<config.NUM_CHANS; i++)
+	{
+		MemorySystem *channel = new MemorySystem(i, config, (*csvOut), dramsim_log);
+		channels.push_back(channel);
+	}
+}
+/* Read the ini files into the config of this instance and set the overrides on top of them
+	The number of ranks depends on the memory size so it is computed here as well
+	*/
+void MultiChannelMemorySystem::loadConfiguration()
+{
 	DEBUG("== Loading device model file '"<<deviceIniFilename<<"' == ");
-	IniReader::ReadIniFile(deviceIniFilename, false);
+	iniReader.ReadIniFile(deviceIniFilename, false);
 	DEBUG("== Loading system model file '"<<systemIniFilename<<"' == ");
-	IniReader::ReadIniFile(systemIniFilename, true);
+	iniReader.ReadIniFile(systemIniFilename, true);
 
 	// If we have any overrides, set them now before creating all of the memory objects
-	if (paramOverrides)
-		IniReader::OverrideKeys(paramOverrides);
+	if (!paramOverrides.empty())
+		iniReader.OverrideKeys(&paramOverrides);
 
-	IniReader::InitEnumsFromStrings();
-	if (!IniReader::CheckIfAllSet())
+	iniReader.InitEnumsFromStrings();
+	iniReader.InitDerivedValues();
+	if (!iniReader.CheckIfAllSet())
 	{
 		exit(-1);
 	}
 
-	if (NUM_CHANS == 0) 
+	if (config.NUM_CHANS == 0) 
 	{
 		ERROR("Zero channels"); 
 		abort(); 
 	}
-	for (size_t i=0; i<NUM_CHANS; i++)
+
+	MemorySystem::configureRanks(config, megsOfMemory/config.NUM_CHANS, dramsim_log);
+}
+
+/* Bring the memory system back to the state right after construction so it can
+	be reused for a new simulation without parsing the ini files and allocating
+	all the memory objects again. The callbacks and the CPU clock speed are kept.
+	*/
+void MultiChannelMemorySystem::reset()
+{
+	for (size_t i=0; i<config.NUM_CHANS; i++)
 	{
-		MemorySystem *channel = new MemorySystem(i, megsOfMemory/NUM_CHANS, (*csvOut), dramsim_log);
-		channels.push_back(channel);
+		channels[i]->reset();
 	}
+
+	clockDomainCrosser.counter1 = 0;
+	clockDomainCrosser.counter2 = 0;
+	currentClockCycle = 0;
+	csvOut->reset();
+
+	// the output files are opened again on the first update
+	closeOutputFiles();
+}
+
+/* Write out and close the log and vis files, the vis file is written by a
+	background thread so its data is only complete after closing it
+	*/
+void MultiChannelMemorySystem::closeOutputFiles()
+{
+#ifdef LOG_OUTPUT
+	dramsim_log.flush();
+	dramsim_log.close();
+#endif
+	visDataOut.close();
 }
+
 /* Initialize the ClockDomainCrosser to use the CPU speed 
 	If cpuClkFreqHz == 0, then assume a 1:1 ratio (like for TraceBasedSim)
 	*/
 void MultiChannelMemorySystem::setCPUClockSpeed(uint64_t cpuClkFreqHz)
 {
 
-	uint64_t dramsimClkFreqHz = (uint64_t)(1.0/(tCK*1e-9));
+	uint64_t dramsimClkFreqHz = (uint64_t)(1.0/(config.tCK*1e-9));
 	clockDomainCrosser.clock1 = dramsimClkFreqHz; 
 	clockDomainCrosser.clock2 = (cpuClkFreqHz == 0) ? dramsimClkFreqHz : cpuClkFreqHz; 
 }
@@ -181,7 +227,7 @@ void MultiChannelMemorySystem::InitOutputFiles(string traceFilename)
 
 	// create a properly named verification output file if need be and open it
 	// as the stream 'cmd_verify_out'
-	if (VERIFICATION_OUTPUT)
+	if (config.VERIFICATION_OUTPUT)
 	{
 		string basefilename = deviceIniFilename.substr(deviceIniFilename.find_last_of("/")+1);
 		string verify_filename =  "sim_out_"+basefilename;
@@ -199,7 +245,7 @@ void MultiChannelMemorySystem::InitOutputFiles(string traceFilename)
 	}
 	// This sets up the vis file output along with the creating the result
 	// directory structure if it doesn't exist
-	if (VIS_FILE_OUTPUT)
+	if (config.VIS_FILE_OUTPUT)
 	{
 		stringstream out,tmpNum;
 		string path;
@@ -247,17 +293,17 @@ void MultiChannelMemorySystem::InitOutputFiles(string traceFilename)
 			// finally, figure out the filename
 			string sched = "BtR";
 			string queue = "pRank";
-			if (schedulingPolicy == RankThenBankRoundRobin)
+			if (config.schedulingPolicy == RankThenBankRoundRobin)
 			{
 				sched = "RtB";
 			}
-			if (queuingStructure == PerRankPerBank)
+			if (config.queuingStructure == PerRankPerBank)
 			{
 				queue = "pRankpBank";
 			}
 
 			/* I really don't see how "the C++ way" is better than snprintf()  */
-			out << (TOTAL_STORAGE>>10) << "GB." << NUM_CHANS << "Ch." << NUM_RANKS <<"R." <<ADDRESS_MAPPING_SCHEME<<"."<<ROW_BUFFER_POLICY<<"."<< TRANS_QUEUE_DEPTH<<"TQ."<<CMD_QUEUE_DEPTH<<"CQ."<<sched<<"."<<queue;
+			out << (config.TOTAL_STORAGE>>10) << "GB." << config.NUM_CHANS << "Ch." << config.NUM_RANKS <<"R." <<config.ADDRESS_MAPPING_SCHEME<<"."<<config.ROW_BUFFER_POLICY<<"."<< config.TRANS_QUEUE_DEPTH<<"TQ."<<config.CMD_QUEUE_DEPTH<<"CQ."<<sched<<"."<<queue;
 		}
 		else //visFilename given
 		{
@@ -284,7 +330,7 @@ void MultiChannelMemorySystem::InitOutputFiles(string traceFilename)
 			exit(-1);
 		}
 		//write out the ini config values for the visualizer tool
-		IniReader::WriteValuesOut(visDataOut);
+		iniReader.WriteValuesOut(visDataOut);
 
 	}
 	else
@@ -350,22 +396,14 @@ void MultiChannelMemorySystem::mkdirIfNotExist(string path)
 
 MultiChannelMemorySystem::~MultiChannelMemorySystem()
 {
-	for (size_t i=0; i<NUM_CHANS; i++)
+	for (size_t i=0; i<config.NUM_CHANS; i++)
 	{
 		delete channels[i];
 	}
 	channels.clear(); 
 
 // flush our streams and close them up
-#ifdef LOG_OUTPUT
-	dramsim_log.flush();
-	dramsim_log.close();
-#endif
-	if (VIS_FILE_OUTPUT) 
-	{	
-		visDataOut.flush();
-		visDataOut.close();
-	}
+	closeOutputFiles();
 }
 void MultiChannelMemorySystem::update()
 {
@@ -379,17 +417,17 @@ void MultiChannelMemorySystem::actual_update()
 		DEBUG("DRAMSim2 Clock Frequency ="<<clockDomainCrosser.clock1<<"Hz, CPU Clock Frequency="<<clockDomainCrosser.clock2<<"Hz"); 
 	}
 
-	if (currentClockCycle % EPOCH_LENGTH == 0)
+	if (currentClockCycle % config.EPOCH_LENGTH == 0)
 	{
-		(*csvOut) << "ms" <<currentClockCycle * tCK * 1E-6; 
-		for (size_t i=0; i<NUM_CHANS; i++)
+		(*csvOut) << "ms" <<currentClockCycle * config.tCK * 1E-6; 
+		for (size_t i=0; i<config.NUM_CHANS; i++)
 		{
 			channels[i]->printStats(false); 
 		}
 		csvOut->finalize();
 	}
 	
-	for (size_t i=0; i<NUM_CHANS; i++)
+	for (size_t i=0; i<config.NUM_CHANS; i++)
 	{
 		channels[i]->update(); 
 	}
@@ -397,15 +435,49 @@ void MultiChannelMemorySystem::actual_update()
 
 	currentClockCycle++; 
 }
+/* Number of update() calls that can be replaced by a single skipIdleCycles()
+	No channel has anything in flight and no refresh or epoch boundary is due
+	in the DRAM cycles covered by them.
+	*/
+uint64_t MultiChannelMemorySystem::getIdleCycles()
+{
+	// the output files are opened and the stats are printed in those cycles
+	if (currentClockCycle % config.EPOCH_LENGTH == 0)
+	{
+		return 0;
+	}
+
+	uint64_t idleCycles = config.EPOCH_LENGTH - currentClockCycle % config.EPOCH_LENGTH;
+	for (size_t i=0; i<config.NUM_CHANS && idleCycles > 0; i++)
+	{
+		idleCycles = std::min(idleCycles, channels[i]->getIdleCycles());
+	}
+
+	return idleCycles == 0 ? 0 : clockDomainCrosser.updatesFor(idleCycles);
+}
+
+/* Advance the memory system as if update() was called cpuCycles times, the
+	caller must not skip more cycles than the ones returned by getIdleCycles()
+	*/
+void MultiChannelMemorySystem::skipIdleCycles(uint64_t cpuCycles)
+{
+	uint64_t cycles = clockDomainCrosser.skip(cpuCycles);
+	for (size_t i=0; i<config.NUM_CHANS; i++)
+	{
+		channels[i]->skipIdleCycles(cycles);
+	}
+	currentClockCycle += cycles;
+}
+
 unsigned MultiChannelMemorySystem::findChannelNumber(uint64_t addr)
 {
 	// Single channel case is a trivial shortcut case 
-	if (NUM_CHANS == 1)
+	if (config.NUM_CHANS == 1)
 	{
 		return 0; 
 	}
 
-	if (!isPowerOfTwo(NUM_CHANS))
+	if (!isPowerOfTwo(config.NUM_CHANS))
 	{
 		ERROR("We can only support power of two # of channels.\n" <<
 				"I don't know what Intel was thinking, but trying to address map half a bit is a neat trick that we're not sure how to do"); 
@@ -414,10 +486,10 @@ unsigned MultiChannelMemorySystem::findChannelNumber(uint64_t addr)
 
 	// only chan is used from this set 
 	unsigned channelNumber,rank,bank,row,col;
-	addressMapping(addr, channelNumber, rank, bank, row, col); 
-	if (channelNumber >= NUM_CHANS)
+	addressMapping(config, addr, channelNumber, rank, bank, row, col); 
+	if (channelNumber >= config.NUM_CHANS)
 	{
-		ERROR("Got channel index "<<channelNumber<<" but only "<<NUM_CHANS<<" exist"); 
+		ERROR("Got channel index "<<channelNumber<<" but only "<<config.NUM_CHANS<<" exist"); 
 		abort();
 	}
 	//DEBUG("Channel idx = "<<channelNumber<<" totalbits="<<totalBits<<" channelbits="<<channelBits); 
@@ -459,13 +531,13 @@ bool MultiChannelMemorySystem::addTransaction(bool isWrite, uint64_t addr)
 bool MultiChannelMemorySystem::willAcceptTransaction(uint64_t addr)
 {
 	unsigned chan, rank,bank,row,col; 
-	addressMapping(addr, chan, rank, bank, row, col); 
+	addressMapping(config, addr, chan, rank, bank, row, col); 
 	return channels[chan]->WillAcceptTransaction(); 
 }
 
 bool MultiChannelMemorySystem::willAcceptTransaction()
 {
-	for (size_t c=0; c<NUM_CHANS; c++) {
+	for (size_t c=0; c<config.NUM_CHANS; c++) {
 		if (!channels[c]->WillAcceptTransaction())
 		{
 			return false; 
@@ -478,8 +550,8 @@ bool MultiChannelMemorySystem::willAcceptTransaction()
 
 void MultiChannelMemorySystem::printStats(bool finalStats) {
 
-	(*csvOut) << "ms" <<currentClockCycle * tCK * 1E-6; 
-	for (size_t i=0; i<NUM_CHANS; i++)
+	(*csvOut) << "ms" <<currentClockCycle * config.tCK * 1E-6; 
+	for (size_t i=0; i<config.NUM_CHANS; i++)
 	{
 		PRINT("==== Channel ["<<i<<"] ====");
 		channels[i]->printStats(finalStats); 
@@ -492,7 +564,7 @@ void MultiChannelMemorySystem::RegisterCallbacks(
 		TransactionCompleteCB *writeDone,
 		void (*reportPower)(double bgpower, double burstpower, double refreshpower, double actprepower))
 {
-	for (size_t i=0; i<NUM_CHANS; i++)
+	for (size_t i=0; i<config.NUM_CHANS; i++)
 	{
 		channels[i]->RegisterCallbacks(readDone, writeDone, reportPower); 
 	}
@@ -505,35 +577,40 @@ void MultiChannelMemorySystem::RegisterCallbacks(
  */
 int MultiChannelMemorySystem::getIniBool(const std::string& field, bool *val)
 {
-	if (!IniReader::CheckIfAllSet())
+	if (!iniReader.CheckIfAllSet())
 		exit(-1);
-	return IniReader::getBool(field, val);
+	return iniReader.getBool(field, val);
 }
 
 int MultiChannelMemorySystem::getIniUint(const std::string& field, unsigned int *val)
 {
-	if (!IniReader::CheckIfAllSet())
+	if (!iniReader.CheckIfAllSet())
 		exit(-1);
-	return IniReader::getUint(field, val);
+	return iniReader.getUint(field, val);
 }
 
 int MultiChannelMemorySystem::getIniUint64(const std::string& field, uint64_t *val)
 {
-	if (!IniReader::CheckIfAllSet())
+	if (!iniReader.CheckIfAllSet())
 		exit(-1);
-	return IniReader::getUint64(field, val);
+	return iniReader.getUint64(field, val);
 }
 
 int MultiChannelMemorySystem::getIniFloat(const std::string& field, float *val)
 {
-	if (!IniReader::CheckIfAllSet())
+	if (!iniReader.CheckIfAllSet())
 		exit(-1);
-	return IniReader::getFloat(field, val);
+	return iniReader.getFloat(field, val);
+}
+
+const Config &MultiChannelMemorySystem::getConfig() const
+{
+	return config;
 }
 
 namespace DRAMSim {
-MultiChannelMemorySystem *getMemorySystemInstance(const string &dev, const string &sys, const string &pwd, const string &trc, unsigned megsOfMemory, string *visfilename) 
+MultiChannelMemorySystem *getMemorySystemInstance(const string &dev, const string &sys, const string &pwd, const string &trc, unsigned megsOfMemory, string *visfilename, const std::map<string, string> *paramOverrides) 
 {
-	return new MultiChannelMemorySystem(dev, sys, pwd, trc, megsOfMemory, visfilename);
+	return new MultiChannelMemorySystem(dev, sys, pwd, trc, megsOfMemory, visfilename, paramOverrides);
 }
 }
@@ -34,6 +34,7 @@
 #include "IniReader.h"
 #include "ClockDomain.h"
 #include "CSVWriter.h"
+#include "BufferedFileWriter.h"
 
 
 namespace DRAMSim {
@@ -51,6 +52,10 @@ class MultiChannelMemorySystem : public SimulatorObject
 			bool willAcceptTransaction(); 
 			bool willAcceptTransaction(uint64_t addr); 
 			void update();
+			void reset();
+			void closeOutputFiles();
+			uint64_t getIdleCycles();
+			void skipIdleCycles(uint64_t cpuCycles);
 			void printStats(bool finalStats=false);
 			ostream &getLogFile();
 			void RegisterCallbacks( 
@@ -61,17 +66,19 @@ class MultiChannelMemorySystem : public SimulatorObject
 			int getIniUint(const std::string &field, unsigned int *val);
 			int getIniUint64(const std::string &field, uint64_t *val);
 			int getIniFloat(const std::string &field, float *val);
+			const Config &getConfig() const;
 
 	void InitOutputFiles(string tracefilename);
 	void setCPUClockSpeed(uint64_t cpuClkFreqHz);
 
 	//output file
-	std::ofstream visDataOut;
+	BufferedFileWriter visDataOut;
 	ofstream dramsim_log; 
 
 	private:
 		unsigned findChannelNumber(uint64_t addr);
 		void actual_update(); 
+		void loadConfiguration();
 		vector<MemorySystem*> channels; 
 		unsigned megsOfMemory; 
 		string deviceIniFilename;
@@ -79,6 +86,10 @@ class MultiChannelMemorySystem : public SimulatorObject
 		string traceFilename;
 		string pwd;
 		string *visFilename;
+		IniReader::OverrideMap paramOverrides;
+		// every instance owns its parameters, so differently configured instances can coexist
+		Config config;
+		IniReader iniReader;
 		ClockDomain::ClockDomainCrosser clockDomainCrosser; 
 		static void mkdirIfNotExist(string path);
 		static bool fileExists(string path); 
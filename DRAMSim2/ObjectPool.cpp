@@ -0,0 +1,97 @@
+/*********************************************************************************
+*  Copyright (c) 2010-2011, Elliott Cooper-Balis
+*                             Paul Rosenfeld
+*                             Bruce Jacob
+*                             University of Maryland 
+*                             dramninjas [at] gmail [dot] com
+*  All rights reserved.
+*  
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*  
+*     * Redistributions of source code must retain the above copyright notice,
+*        this list of conditions and the following disclaimer.
+*  
+*     * Redistributions in binary form must reproduce the above copyright notice,
+*        this list of conditions and the following disclaimer in the documentation
+*        and/or other materials provided with the distribution.
+*  
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+*  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+*  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************************/
+
+
+
+//ObjectPool.cpp
+//
+//Class file for a free list of fixed size objects
+//
+
+#include "ObjectPool.h"
+#include <new>
+
+using namespace DRAMSim;
+
+ObjectPool::ObjectPool(size_t objectSize_, size_t objectsPerChunk_) :
+	objectSize(objectSize_ < sizeof(FreeObject) ? sizeof(FreeObject) : objectSize_),
+	objectsPerChunk(objectsPerChunk_),
+	freeList(NULL)
+{}
+
+//allocate a whole chunk of objects and add them to the free list
+//	chunks are never returned since objects may still be deleted at exit or
+//	released into the pool of another thread
+void ObjectPool::grow()
+{
+	char *chunk = static_cast<char *>(::operator new(objectSize * objectsPerChunk));
+	chunks.push_back(chunk);
+	for (size_t i=0; i<objectsPerChunk; i++)
+	{
+		FreeObject *object = reinterpret_cast<FreeObject *>(chunk + i * objectSize);
+		object->next = freeList;
+		freeList = object;
+	}
+}
+
+void *ObjectPool::allocate(size_t size)
+{
+	//derived classes don't fit in the pool
+	if (size > objectSize)
+	{
+		return ::operator new(size);
+	}
+
+	if (freeList == NULL)
+	{
+		grow();
+	}
+	FreeObject *object = freeList;
+	freeList = object->next;
+	return object;
+}
+
+void ObjectPool::release(void *object, size_t size)
+{
+	if (object == NULL)
+	{
+		return;
+	}
+
+	if (size > objectSize)
+	{
+		::operator delete(object);
+		return;
+	}
+
+	FreeObject *freeObject = static_cast<FreeObject *>(object);
+	freeObject->next = freeList;
+	freeList = freeObject;
+}
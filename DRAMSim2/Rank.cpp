@@ -37,14 +37,15 @@
 using namespace std;
 using namespace DRAMSim;
 
-Rank::Rank(ostream &dramsim_log_) :
+Rank::Rank(const Config &config_, ostream &dramsim_log_) :
 	id(-1),
+	config(config_),
 	dramsim_log(dramsim_log_),
 	isPowerDown(false),
 	refreshWaiting(false),
 	readReturnCountdown(0),
-	banks(NUM_BANKS, Bank(dramsim_log_)),
-	bankStates(NUM_BANKS, BankState(dramsim_log_))
+	banks(config.NUM_BANKS, Bank(config_, dramsim_log_)),
+	bankStates(config.NUM_BANKS, BankState(dramsim_log_))
 
 {
 
@@ -70,6 +71,35 @@ void Rank::attachMemoryController(MemoryController *memoryController)
 {
 	this->memoryController = memoryController;
 }
+//Drop the packets in flight and go back to the initial state
+//The bank contents are functional storage only and are kept
+void Rank::reset()
+{
+	for (size_t i=0; i<readReturnPacket.size(); i++)
+	{
+		delete readReturnPacket[i];
+	}
+	readReturnPacket.clear();
+	readReturnCountdown.clear();
+	delete outgoingDataPacket;
+	outgoingDataPacket = NULL;
+	dataCyclesLeft = 0;
+	isPowerDown = false;
+	refreshWaiting = false;
+	currentClockCycle = 0;
+
+	for (size_t i=0; i<bankStates.size(); i++)
+	{
+		bankStates[i].reset();
+	}
+}
+
+//True if there is no data in flight and no refresh pending
+bool Rank::isIdle()
+{
+	return readReturnPacket.empty() && outgoingDataPacket == NULL && !refreshWaiting;
+}
+
 Rank::~Rank()
 {
 	for (size_t i=0; i<readReturnPacket.size(); i++)
@@ -81,12 +111,12 @@ Rank::~Rank()
 }
 void Rank::receiveFromBus(BusPacket *packet)
 {
-	if (DEBUG_BUS)
+	if (config.DEBUG_BUS)
 	{
 		PRINTN(" -- R" << this->id << " Receiving On Bus    : ");
 		packet->print();
 	}
-	if (VERIFICATION_OUTPUT)
+	if (config.VERIFICATION_OUTPUT)
 	{
 		packet->print(currentClockCycle,false);
 	}
@@ -105,11 +135,11 @@ void Rank::receiveFromBus(BusPacket *packet)
 		}
 
 		//update state table
-		bankStates[packet->bank].nextPrecharge = max(bankStates[packet->bank].nextPrecharge, currentClockCycle + READ_TO_PRE_DELAY);
-		for (size_t i=0;i<NUM_BANKS;i++)
+		bankStates[packet->bank].nextPrecharge = max(bankStates[packet->bank].nextPrecharge, currentClockCycle + config.READ_TO_PRE_DELAY);
+		for (size_t i=0;i<config.NUM_BANKS;i++)
 		{
-			bankStates[i].nextRead = max(bankStates[i].nextRead, currentClockCycle + max(tCCD, BL/2));
-			bankStates[i].nextWrite = max(bankStates[i].nextWrite, currentClockCycle + READ_TO_WRITE_DELAY);
+			bankStates[i].nextRead = max(bankStates[i].nextRead, currentClockCycle + max(config.tCCD, config.BL/2));
+			bankStates[i].nextWrite = max(bankStates[i].nextWrite, currentClockCycle + config.READ_TO_WRITE_DELAY);
 		}
 
 		//get the read data and put it in the storage which delays until the appropriate time (RL)
@@ -119,7 +149,7 @@ void Rank::receiveFromBus(BusPacket *packet)
 		packet->busPacketType = DATA;
 #endif
 		readReturnPacket.push_back(packet);
-		readReturnCountdown.push_back(RL);
+		readReturnCountdown.push_back(config.RL);
 		break;
 	case READ_P:
 		//make sure a read is allowed
@@ -133,12 +163,12 @@ void Rank::receiveFromBus(BusPacket *packet)
 
 		//update state table
 		bankStates[packet->bank].currentBankState = Idle;
-		bankStates[packet->bank].nextActivate = max(bankStates[packet->bank].nextActivate, currentClockCycle + READ_AUTOPRE_DELAY);
-		for (size_t i=0;i<NUM_BANKS;i++)
+		bankStates[packet->bank].nextActivate = max(bankStates[packet->bank].nextActivate, currentClockCycle + config.READ_AUTOPRE_DELAY);
+		for (size_t i=0;i<config.NUM_BANKS;i++)
 		{
 			//will set next read/write for all banks - including current (which shouldnt matter since its now idle)
-			bankStates[i].nextRead = max(bankStates[i].nextRead, currentClockCycle + max(BL/2, tCCD));
-			bankStates[i].nextWrite = max(bankStates[i].nextWrite, currentClockCycle + READ_TO_WRITE_DELAY);
+			bankStates[i].nextRead = max(bankStates[i].nextRead, currentClockCycle + max(config.BL/2, config.tCCD));
+			bankStates[i].nextWrite = max(bankStates[i].nextWrite, currentClockCycle + config.READ_TO_WRITE_DELAY);
 		}
 
 		//get the read data and put it in the storage which delays until the appropriate time (RL)
@@ -149,7 +179,7 @@ void Rank::receiveFromBus(BusPacket *packet)
 #endif
 
 		readReturnPacket.push_back(packet);
-		readReturnCountdown.push_back(RL);
+		readReturnCountdown.push_back(config.RL);
 		break;
 	case WRITE:
 		//make sure a write is allowed
@@ -163,11 +193,11 @@ void Rank::receiveFromBus(BusPacket *packet)
 		}
 
 		//update state table
-		bankStates[packet->bank].nextPrecharge = max(bankStates[packet->bank].nextPrecharge, currentClockCycle + WRITE_TO_PRE_DELAY);
-		for (size_t i=0;i<NUM_BANKS;i++)
+		bankStates[packet->bank].nextPrecharge = max(bankStates[packet->bank].nextPrecharge, currentClockCycle + config.WRITE_TO_PRE_DELAY);
+		for (size_t i=0;i<config.NUM_BANKS;i++)
 		{
-			bankStates[i].nextRead = max(bankStates[i].nextRead, currentClockCycle + WRITE_TO_READ_DELAY_B);
-			bankStates[i].nextWrite = max(bankStates[i].nextWrite, currentClockCycle + max(BL/2, tCCD));
+			bankStates[i].nextRead = max(bankStates[i].nextRead, currentClockCycle + config.WRITE_TO_READ_DELAY_B);
+			bankStates[i].nextWrite = max(bankStates[i].nextWrite, currentClockCycle + max(config.BL/2, config.tCCD));
 		}
 
 		//take note of where data is going when it arrives
@@ -188,11 +218,11 @@ void Rank::receiveFromBus(BusPacket *packet)
 
 		//update state table
 		bankStates[packet->bank].currentBankState = Idle;
-		bankStates[packet->bank].nextActivate = max(bankStates[packet->bank].nextActivate, currentClockCycle + WRITE_AUTOPRE_DELAY);
-		for (size_t i=0;i<NUM_BANKS;i++)
+		bankStates[packet->bank].nextActivate = max(bankStates[packet->bank].nextActivate, currentClockCycle + config.WRITE_AUTOPRE_DELAY);
+		for (size_t i=0;i<config.NUM_BANKS;i++)
 		{
-			bankStates[i].nextWrite = max(bankStates[i].nextWrite, currentClockCycle + max(tCCD, BL/2));
-			bankStates[i].nextRead = max(bankStates[i].nextRead, currentClockCycle + WRITE_TO_READ_DELAY_B);
+			bankStates[i].nextWrite = max(bankStates[i].nextWrite, currentClockCycle + max(config.tCCD, config.BL/2));
+			bankStates[i].nextRead = max(bankStates[i].nextRead, currentClockCycle + config.WRITE_TO_READ_DELAY_B);
 		}
 
 		//take note of where data is going when it arrives
@@ -213,27 +243,27 @@ void Rank::receiveFromBus(BusPacket *packet)
 		}
 
 		bankStates[packet->bank].currentBankState = RowActive;
-		bankStates[packet->bank].nextActivate = currentClockCycle + tRC;
+		bankStates[packet->bank].nextActivate = currentClockCycle + config.tRC;
 		bankStates[packet->bank].openRowAddress = packet->row;
 
 		//if AL is greater than one, then posted-cas is enabled - handle accordingly
-		if (AL>0)
+		if (config.AL>0)
 		{
-			bankStates[packet->bank].nextWrite = currentClockCycle + (tRCD-AL);
-			bankStates[packet->bank].nextRead = currentClockCycle + (tRCD-AL);
+			bankStates[packet->bank].nextWrite = currentClockCycle + (config.tRCD-config.AL);
+			bankStates[packet->bank].nextRead = currentClockCycle + (config.tRCD-config.AL);
 		}
 		else
 		{
-			bankStates[packet->bank].nextWrite = currentClockCycle + (tRCD-AL);
-			bankStates[packet->bank].nextRead = currentClockCycle + (tRCD-AL);
+			bankStates[packet->bank].nextWrite = currentClockCycle + (config.tRCD-config.AL);
+			bankStates[packet->bank].nextRead = currentClockCycle + (config.tRCD-config.AL);
 		}
 
-		bankStates[packet->bank].nextPrecharge = currentClockCycle + tRAS;
-		for (size_t i=0;i<NUM_BANKS;i++)
+		bankStates[packet->bank].nextPrecharge = currentClockCycle + config.tRAS;
+		for (size_t i=0;i<config.NUM_BANKS;i++)
 		{
 			if (i != packet->bank)
 			{
-				bankStates[i].nextActivate = max(bankStates[i].nextActivate, currentClockCycle + tRRD);
+				bankStates[i].nextActivate = max(bankStates[i].nextActivate, currentClockCycle + config.tRRD);
 			}
 		}
 		delete(packet); 
@@ -248,19 +278,19 @@ void Rank::receiveFromBus(BusPacket *packet)
 		}
 
 		bankStates[packet->bank].currentBankState = Idle;
-		bankStates[packet->bank].nextActivate = max(bankStates[packet->bank].nextActivate, currentClockCycle + tRP);
+		bankStates[packet->bank].nextActivate = max(bankStates[packet->bank].nextActivate, currentClockCycle + config.tRP);
 		delete(packet); 
 		break;
 	case REFRESH:
 		refreshWaiting = false;
-		for (size_t i=0;i<NUM_BANKS;i++)
+		for (size_t i=0;i<config.NUM_BANKS;i++)
 		{
 			if (bankStates[i].currentBankState != Idle)
 			{
 				ERROR("== Error - Rank " << id << " received a REF when not allowed");
 				exit(0);
 			}
-			bankStates[i].nextActivate = currentClockCycle + tRFC;
+			bankStates[i].nextActivate = currentClockCycle + config.tRFC;
 		}
 		delete(packet); 
 		break;
@@ -325,13 +355,13 @@ void Rank::update()
 		// ready to go out on the bus
 
 		outgoingDataPacket = readReturnPacket[0];
-		dataCyclesLeft = BL/2;
+		dataCyclesLeft = config.BL/2;
 
 		// remove the packet from the ranks
 		readReturnPacket.erase(readReturnPacket.begin());
 		readReturnCountdown.erase(readReturnCountdown.begin());
 
-		if (DEBUG_BUS)
+		if (config.DEBUG_BUS)
 		{
 			PRINTN(" -- R" << this->id << " Issuing On Data Bus : ");
 			outgoingDataPacket->print();
@@ -345,7 +375,7 @@ void Rank::update()
 void Rank::powerDown()
 {
 	//perform checks
-	for (size_t i=0;i<NUM_BANKS;i++)
+	for (size_t i=0;i<config.NUM_BANKS;i++)
 	{
 		if (bankStates[i].currentBankState != Idle)
 		{
@@ -353,7 +383,7 @@ void Rank::powerDown()
 			exit(0);
 		}
 
-		bankStates[i].nextPowerUp = currentClockCycle + tCKE;
+		bankStates[i].nextPowerUp = currentClockCycle + config.tCKE;
 		bankStates[i].currentBankState = PowerDown;
 	}
 
@@ -371,7 +401,7 @@ void Rank::powerUp()
 
 	isPowerDown = false;
 
-	for (size_t i=0;i<NUM_BANKS;i++)
+	for (size_t i=0;i<config.NUM_BANKS;i++)
 	{
 		if (bankStates[i].nextPowerUp > currentClockCycle)
 		{
@@ -379,7 +409,7 @@ void Rank::powerUp()
 			ERROR(bankStates[i].nextPowerUp << "    " << currentClockCycle);
 			exit(0);
 		}
-		bankStates[i].nextActivate = currentClockCycle + tXP;
+		bankStates[i].nextActivate = currentClockCycle + config.tXP;
 		bankStates[i].currentBankState = Idle;
 	}
 }
@@ -50,6 +50,7 @@ class Rank : public SimulatorObject
 {
 private:
 	int id;
+	const Config &config;
 	ostream &dramsim_log; 
 	unsigned incomingWriteBank;
 	unsigned incomingWriteRow;
@@ -58,7 +59,7 @@ private:
 
 public:
 	//functions
-	Rank(ostream &dramsim_log_);
+	Rank(const Config &config_, ostream &dramsim_log_);
 	virtual ~Rank(); 
 	void receiveFromBus(BusPacket *packet);
 	void attachMemoryController(MemoryController *mc);
@@ -67,6 +68,8 @@ public:
 	void update();
 	void powerUp();
 	void powerDown();
+	void reset();
+	bool isIdle();
 
 	//fields
 	MemoryController *memoryController;
@@ -324,11 +324,11 @@ void *parseTraceFileLine(string &line, uint64_t &addr, enum TransactionType &tra
 
 #ifndef _SIM_
 
-void alignTransactionAddress(Transaction &trans)
+void alignTransactionAddress(Transaction &trans, const Config &config)
 {
 	// zero out the low order bits which correspond to the size of a transaction
 
-	unsigned throwAwayBits = THROW_AWAY_BITS;
+	unsigned throwAwayBits = config.THROW_AWAY_BITS;
 
 	trans.address >>= throwAwayBits;
 	trans.address <<= throwAwayBits;
@@ -553,7 +553,7 @@ int main(int argc, char **argv)
 				{
 					data = parseTraceFileLine(line, addr, transType,clockCycle, traceType,useClockCycle);
 					trans = new Transaction(transType, addr, data);
-					alignTransactionAddress(*trans); 
+					alignTransactionAddress(*trans, memorySystem->getConfig()); 
 
 					if (i>=clockCycle)
 					{
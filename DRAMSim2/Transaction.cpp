@@ -43,6 +43,8 @@ using std::dec;
 
 namespace DRAMSim {
 
+thread_local ObjectPool Transaction::pool(sizeof(Transaction));
+
 Transaction::Transaction(TransactionType transType, uint64_t addr, void *dat) :
 	transactionType(transType),
 	address(addr),
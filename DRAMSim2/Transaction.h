@@ -37,6 +37,7 @@
 
 #include "SystemConfiguration.h"
 #include "BusPacket.h"
+#include "ObjectPool.h"
 
 using std::ostream; 
 
@@ -52,6 +53,8 @@ enum TransactionType
 class Transaction
 {
 	Transaction();
+	//one pool per thread so memory systems on different threads never share a free list
+	static thread_local ObjectPool pool;
 public:
 	//fields
 	TransactionType transactionType;
@@ -66,7 +69,17 @@ public:
 	Transaction(TransactionType transType, uint64_t addr, void *data);
 	Transaction(const Transaction &t);
 
-	BusPacketType getBusPacketType()
+	//transactions are recycled through the pool
+	static void *operator new(size_t size)
+	{
+		return pool.allocate(size);
+	}
+	static void operator delete(void *object, size_t size)
+	{
+		pool.release(object, size);
+	}
+
+	BusPacketType getBusPacketType(RowBufferPolicy rowBufferPolicy)
 	{
 		switch (transactionType)
 		{
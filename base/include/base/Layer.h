@@ -50,6 +50,12 @@ namespace base {
         /** numpy array containing the activations for the layer */
         Array<T> activations;
 
+        /** Shape of the activations given by the model, empty if the model does not define it */
+        std::vector<size_t> act_shape;
+
+        /** Shape of the weights given by the model, empty if the model does not define it */
+        std::vector<size_t> wgt_shape;
+
     public:
 
         /** Constructor
@@ -157,6 +163,18 @@ namespace base {
          */
         const Array<T> &getActivations() const { return activations; }
 
+        /**
+         * Get the activations shape given by the model
+         * @return Activations shape, empty if not defined
+         */
+        const std::vector<size_t> &getActShape() const { return act_shape; }
+
+        /**
+         * Get the weights shape given by the model
+         * @return Weights shape, empty if not defined
+         */
+        const std::vector<size_t> &getWgtShape() const { return wgt_shape; }
+
         /**
          * Set the name of the layer
          * @param _name Name of the layer
@@ -175,6 +193,16 @@ namespace base {
          */
         void setActivations(const Array<T> &_activations) { Layer::activations = _activations; }
 
+        /**
+         * Set the shapes given by the model
+         * @param _act_shape Activations shape
+         * @param _wgt_shape Weights shape
+         */
+        void setShapes(const std::vector<size_t> &_act_shape, const std::vector<size_t> &_wgt_shape) {
+            Layer::act_shape = _act_shape;
+            Layer::wgt_shape = _wgt_shape;
+        }
+
         /**
          * Set the activations precision
          * @param _act_precision Activations precision
@@ -39,6 +39,12 @@ namespace base {
          */
         base::Layer<T> read_layer_caffe(const caffe::LayerParameter &layer_caffe);
 
+        /** Set the activations and weights shapes of a layer in the layout of the traces
+         * @param layer     Layer
+         * @param shape     Channels, Nx, Ny, filters, Kx, Ky and groups. Recurrent layers use Nx as the sequence length
+         */
+        void set_layer_shapes(base::Layer<T> &layer, const std::vector<size_t> &shape);
+
     public:
 
         /** Constructor
@@ -73,6 +79,15 @@ namespace base {
          */
         void read_activations_npy(base::Network<T> &network);
 
+        /** Generate synthetic weights and activations from the layer shapes of the model instead of the traces
+         * The values of each layer are generated when the layer is simulated
+         * @param network       Network with the layers already initialized
+         * @param samples       Number of input samples
+         * @param act_sparsity  Fraction of zero activations
+         * @param wgt_sparsity  Fraction of zero weights
+         */
+        void set_synthetic(base::Network<T> &network, uint32_t samples, double act_sparsity, double wgt_sparsity);
+
         /** Read the precision for each layer
          * @param network       Network with the layers already initialized
          */
@@ -12,6 +12,9 @@ namespace base {
     template <typename T>
     class Network {
 
+        /** The floating point network sets up its fixed point copy */
+        template <typename U> friend class Network;
+
     private:
 
         /** Name of the network */
@@ -29,6 +32,70 @@ namespace base {
         /** Quantised */
         bool quantised = false;
 
+        /** Generate the values of each layer from its model shape instead of reading the traces */
+        bool synthetic = false;
+
+        /** Seed of the synthetic values */
+        uint32_t seed = 0;
+
+        /** Number of synthetic input samples */
+        uint32_t samples = 1;
+
+        /** Fraction of zero synthetic activations */
+        double act_sparsity = 0;
+
+        /** Fraction of zero synthetic weights */
+        double wgt_sparsity = 0;
+
+        /** Data width of the fixed point synthetic values */
+        uint32_t synthetic_width = 16;
+
+        /** Quantize the fixed point synthetic values with the profiled precisions */
+        bool synthetic_profiled = false;
+
+        /**
+         * Return random values for a shape, the same for every run of the same layer
+         * @param shape     Shape of the values
+         * @param layer_idx Index of the layer
+         * @param weights   True for the weights, False for the activations
+         * @return Floating point values
+         */
+        Array<float> generate_values(const std::vector<size_t> &shape, uint64_t layer_idx, bool weights) const {
+            std::seed_seq seeds = {(uint64_t)seed, layer_idx, (uint64_t)weights};
+            std::mt19937 generator(seeds);
+            std::uniform_real_distribution<float> distribution(weights ? -1 : 0, 1);
+            std::bernoulli_distribution zero(weights ? wgt_sparsity : act_sparsity);
+
+            auto size = std::accumulate(shape.begin(), shape.end(), (size_t)1, std::multiplies<>());
+            std::vector<float> values (size);
+            for (auto &value : values)
+                value = zero.p() > 0 && zero(generator) ? 0 : distribution(generator);
+
+            Array<float> array; array.set_values(values, shape, weights);
+            return array;
+        }
+
+        /**
+         * Keep synthetic values in floating point
+         * @param values    Floating point values
+         * @param output    Floating point values
+         */
+        void convert_values(const Array<float> &values, int, int, Array<float> &output) const {
+            output = values;
+        }
+
+        /**
+         * Quantize synthetic values to fixed point as the traces
+         * @param values    Floating point values
+         * @param magnitude Profiled magnitude
+         * @param fraction  Profiled fraction
+         * @param output    Fixed point values
+         */
+        void convert_values(const Array<float> &values, int magnitude, int fraction, Array<uint16_t> &output) const {
+            if (synthetic_profiled) output = values.profiled_quantization(magnitude, fraction);
+            else output = values.linear_quantization(synthetic_width);
+        }
+
     public:
 
         /** Default constructor */
@@ -81,6 +148,7 @@ namespace base {
          * @return Btach
          */
         uint64_t getBatchSize() const {
+            if (synthetic) return samples;
             uint64_t max_batch_size = 0;
             for (const auto &layer : this->layers) {
                 uint64_t batch_size = layer.getActivations().getShape()[0];
@@ -90,6 +158,46 @@ namespace base {
             return max_batch_size;
         }
 
+        /**
+         * Return True if the values are generated from the layer shapes
+         * @return True if synthetic
+         */
+        bool isSynthetic() const { return synthetic; }
+
+        /**
+         * Get the activations of a layer, generated from its model shape if the network is synthetic
+         * @param layer_idx Index of the layer
+         * @return Activations data
+         */
+        Array<T> getActivations(uint64_t layer_idx) const {
+            const auto &layer = layers[layer_idx];
+            if (!synthetic) return layer.getActivations();
+
+            // The first dimension of the model shape is the batch
+            auto shape = layer.getActShape();
+            shape[0] = samples;
+
+            Array<T> activations;
+            convert_values(generate_values(shape, layer_idx, false), layer.getActMagnitude(),
+                    layer.getActFraction(), activations);
+            return activations;
+        }
+
+        /**
+         * Get the weights of a layer, generated from its model shape if the network is synthetic
+         * @param layer_idx Index of the layer
+         * @return Weights data
+         */
+        Array<T> getWeights(uint64_t layer_idx) const {
+            const auto &layer = layers[layer_idx];
+            if (!synthetic) return layer.getWeights();
+
+            Array<T> weights;
+            convert_values(generate_values(layer.getWgtShape(), layer_idx, true), layer.getWgtMagnitude(),
+                    layer.getWgtFraction(), weights);
+            return weights;
+        }
+
         /**
          * Get number of layers in the network
          * @return Number of layers in the network
@@ -130,6 +238,21 @@ namespace base {
          */
         void setQuantised(bool _quantised) { Network::quantised = _quantised; }
 
+        /**
+         * Generate the values of each layer from its model shape when it is simulated
+         * @param _seed         Seed of the values
+         * @param _samples      Number of input samples
+         * @param _act_sparsity Fraction of zero activations
+         * @param _wgt_sparsity Fraction of zero weights
+         */
+        void setSynthetic(uint32_t _seed, uint32_t _samples, double _act_sparsity, double _wgt_sparsity) {
+            Network::synthetic = true;
+            Network::seed = _seed;
+            Network::samples = _samples;
+            Network::act_sparsity = _act_sparsity;
+            Network::wgt_sparsity = _wgt_sparsity;
+        }
+
         /** Return a network in fixed point given a floating point network
          * @return   Network in fixed point
          */
@@ -140,6 +263,13 @@ namespace base {
                 auto fixed_layer = Layer<uint16_t>(layer.getName(), layer.getType(), layer.getStride(),
                         layer.getPadding(), layer.getActPrecision(), layer.getActMagnitude(), layer.getActFraction(),
                         layer.getWgtPrecision(), layer.getWgtMagnitude(), layer.getWgtFraction());
+                fixed_layer.setShapes(layer.getActShape(), layer.getWgtShape());
+
+                // Synthetic values are quantized when they are generated
+                if (synthetic) {
+                    fixed_network.updateLayers().emplace_back(fixed_layer);
+                    continue;
+                }
 
                 if (quantised) fixed_layer.setActivations(layer.getActivations().float_to_int());
                 else if (profiled) fixed_layer.setActivations(layer.getActivations().profiled_quantization
@@ -156,6 +286,11 @@ namespace base {
                 fixed_network.updateLayers().emplace_back(fixed_layer);
             }
 
+            if (synthetic) {
+                fixed_network.setSynthetic(seed, samples, act_sparsity, wgt_sparsity);
+                fixed_network.synthetic_width = data_width;
+                fixed_network.synthetic_profiled = profiled;
+            }
             return fixed_network;
         }
 
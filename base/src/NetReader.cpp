@@ -40,6 +40,24 @@ namespace base {
         return base::Layer<T>(layer_name, type, stride, padding);
     }
 
+    template <typename T>
+    void NetReader<T>::set_layer_shapes(base::Layer<T> &layer, const std::vector<size_t> &shape) {
+        auto channels = shape[0], Nx = shape[1], Ny = shape[2];
+        auto filters = shape[3], Kx = shape[4], Ky = shape[5];
+        auto groups = shape[6];
+
+        if (groups == 0 || channels % groups != 0)
+            throw std::runtime_error("Wrong groups for layer " + layer.getName());
+
+        if (layer.getType() == "Convolution") {
+            layer.setShapes({1, channels, Nx, Ny}, {filters, channels / groups, Kx, Ky});
+        } else if (layer.getType() == "RNN") {
+            layer.setShapes({1, Nx, channels}, {filters, channels});
+        } else {
+            layer.setShapes({1, channels * Nx * Ny}, {filters, channels * Nx * Ny});
+        }
+    }
+
     template <typename T>
     base::Network<T> NetReader<T>::read_network_caffe() {
         GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -54,10 +72,100 @@ namespace base {
             throw std::runtime_error("Failed to read prototxt");
         }
 
+        // Blob shapes as channels, height and width, propagated from the network inputs through the layers
+        std::map<std::string, std::vector<size_t>> blobs;
+        auto blob_shape = [](const caffe::BlobShape &shape) {
+            std::vector<size_t> dims;
+            for (int d = 1; d < shape.dim_size(); ++d) dims.push_back(shape.dim(d));
+            dims.resize(3, 1);
+            return dims;
+        };
+
+        for (int i = 0; i < network.input_size(); ++i) {
+            if (i < network.input_shape_size())
+                blobs[network.input(i)] = blob_shape(network.input_shape(i));
+            else if (network.input_dim_size() >= 4 * (i + 1))
+                blobs[network.input(i)] = {(size_t)network.input_dim(4 * i + 1),
+                        (size_t)network.input_dim(4 * i + 2), (size_t)network.input_dim(4 * i + 3)};
+        }
+
+        // Single value for both dimensions, one value per dimension, or the 2D only parameter
+        auto conv_param = [](const google::protobuf::RepeatedField<uint32_t> &values, int dim, bool has_2d,
+                uint32_t value_2d, uint32_t default_value) {
+            if (has_2d) return value_2d;
+            if (values.empty()) return default_value;
+            return values.Get(std::min(dim, values.size() - 1));
+        };
+
         for(const auto &layer : network.layer()) {
-           if(this->allowed_layers.find(layer.type()) != this->allowed_layers.end()) {
-               layers.emplace_back(read_layer_caffe(layer));
-           }
+
+            if (layer.type() == "Input") {
+                const auto &input_param = layer.input_param();
+                for (int t = 0; t < layer.top_size() && input_param.shape_size() > 0; ++t)
+                    blobs[layer.top(t)] = blob_shape(input_param.shape(std::min(t, input_param.shape_size() - 1)));
+                continue;
+            }
+
+            std::vector<size_t> bottom, top;
+            if (layer.bottom_size() > 0 && blobs.find(layer.bottom(0)) != blobs.end())
+                bottom = blobs[layer.bottom(0)];
+
+            // Channels, Nx, Ny, filters, Kx, Ky and groups of the layer
+            std::vector<size_t> shape;
+            if (bottom.empty() || layer.type() == "LSTM") {
+                // Unknown shape
+            } else if (layer.type() == "Convolution") {
+                const auto &conv = layer.convolution_param();
+                auto Kx = conv_param(conv.kernel_size(), 0, conv.has_kernel_h(), conv.kernel_h(), 1);
+                auto Ky = conv_param(conv.kernel_size(), 1, conv.has_kernel_w(), conv.kernel_w(), 1);
+                auto pad_x = conv_param(conv.pad(), 0, conv.has_pad_h(), conv.pad_h(), 0);
+                auto pad_y = conv_param(conv.pad(), 1, conv.has_pad_w(), conv.pad_w(), 0);
+                auto stride_x = conv_param(conv.stride(), 0, conv.has_stride_h(), conv.stride_h(), 1);
+                auto stride_y = conv_param(conv.stride(), 1, conv.has_stride_w(), conv.stride_w(), 1);
+
+                shape = {bottom[0], bottom[1], bottom[2], conv.num_output(), Kx, Ky, conv.group()};
+                top = {conv.num_output(), (bottom[1] + 2 * pad_x - Kx) / stride_x + 1,
+                        (bottom[2] + 2 * pad_y - Ky) / stride_y + 1};
+            } else if (layer.type() == "InnerProduct") {
+                auto filters = layer.inner_product_param().num_output();
+                shape = {bottom[0] * bottom[1] * bottom[2], 1, 1, filters, 1, 1, 1};
+                top = {filters, 1, 1};
+            } else if (layer.type() == "Pooling") {
+                const auto &pool = layer.pooling_param();
+                if (pool.global_pooling()) {
+                    top = {bottom[0], 1, 1};
+                } else {
+                    auto Kx = pool.has_kernel_h() ? pool.kernel_h() : pool.kernel_size();
+                    auto Ky = pool.has_kernel_w() ? pool.kernel_w() : pool.kernel_size();
+                    auto pad_x = pool.has_pad_h() ? pool.pad_h() : pool.pad();
+                    auto pad_y = pool.has_pad_w() ? pool.pad_w() : pool.pad();
+                    auto stride_x = pool.has_stride_h() ? pool.stride_h() : pool.stride();
+                    auto stride_y = pool.has_stride_w() ? pool.stride_w() : pool.stride();
+                    top = {bottom[0], (size_t)ceil((bottom[1] + 2 * pad_x - Kx) / (double)stride_x) + 1,
+                            (size_t)ceil((bottom[2] + 2 * pad_y - Ky) / (double)stride_y) + 1};
+                }
+            } else if (layer.type() == "Concat") {
+                top = bottom;
+                for (int b = 1; b < layer.bottom_size() && !top.empty(); ++b) {
+                    auto it = blobs.find(layer.bottom(b));
+                    if (it == blobs.end()) top.clear();
+                    else top[0] += it->second[0];
+                }
+            } else {
+                // Element-wise layers keep the shape
+                top = bottom;
+            }
+
+            for (const auto &top_name : layer.top()) {
+                if (top.empty()) blobs.erase(top_name);
+                else blobs[top_name] = top;
+            }
+
+            if(this->allowed_layers.find(layer.type()) != this->allowed_layers.end()) {
+                auto net_layer = read_layer_caffe(layer);
+                if (!shape.empty()) set_layer_shapes(net_layer, shape);
+                layers.emplace_back(net_layer);
+            }
         }
 
         if(!QUIET) std::cout << "Network loaded from Caffe prototxt model definition" << std::endl;
@@ -100,6 +208,24 @@ namespace base {
                 std::replace(layer_name.begin(), layer_name.end(), '/', '-'); // Sanitize name
 
                 auto layer = base::Layer<T>(layer_name, type, stoi(words[2]), stoi(words[3]));
+
+                // Optional shape: channels, Nx, Ny, filters, Kx, Ky and groups
+                if (words.size() > 4) {
+                    if (words.size() < 10 || words.size() > 11)
+                        throw std::runtime_error("Failed to read model.csv: Wrong number of parameters for layer " +
+                                layer_name);
+
+                    std::vector<size_t> shape;
+                    for (size_t i = 4; i < words.size(); ++i)
+                        shape.push_back(stoul(words[i]));
+                    if (shape.size() == 6) shape.push_back(1);
+
+                    if (shape[6] != 1)
+                        throw std::runtime_error("Failed to read model.csv: Grouped layer " + layer_name +
+                                " is not supported, the simulated layers need as many weight as activation channels");
+                    set_layer_shapes(layer, shape);
+                }
+
                 layers.emplace_back(layer);
             }
             myfile.close();
@@ -136,6 +262,30 @@ namespace base {
 
     }
 
+    template <typename T>
+    void NetReader<T>::set_synthetic(base::Network<T> &network, uint32_t samples, double act_sparsity,
+            double wgt_sparsity) {
+
+        for(const base::Layer<T> &layer : network.getLayers()) {
+            const auto &act_shape = layer.getActShape();
+            const auto &wgt_shape = layer.getWgtShape();
+
+            if (act_shape.empty() || wgt_shape.empty())
+                throw std::runtime_error("Layer " + layer.getName() + " has no shape, synthetic simulations need the "
+                        "shapes in model.csv or the input shape in train_val.prototxt");
+
+            if (layer.getType() == "Convolution" && wgt_shape[1] != act_shape[1])
+                throw std::runtime_error("Grouped layer " + layer.getName() + " is not supported, the simulated "
+                        "layers need as many weight as activation channels");
+        }
+
+        // Fixed seed so every run of the same network sees the same values
+        network.setSynthetic(this->batch, samples, act_sparsity, wgt_sparsity);
+
+        if(!QUIET) std::cout << "Synthetic traces will be generated from the layer shapes" << std::endl;
+
+    }
+
     template <typename T>
     void NetReader<T>::read_precision(base::Network<T> &network) {
 
@@ -0,0 +1,140 @@
+#ifndef DNNSIM_ADDRESS_INDEX_H
+#define DNNSIM_ADDRESS_INDEX_H
+
+#include "Utils.h"
+
+namespace core {
+
+    /** Slot of the addresses not tracked */
+    const uint32_t NULL_SLOT = UINT32_MAX;
+
+    /**
+     * Open addressing map from memory addresses to dense slot indices
+     * Keys and slots live in flat arrays with linear probing and backward shift deletion, so lookups, insertions and
+     * removals do not allocate once the table has grown to the number of tracked addresses.
+     */
+    class AddressIndex {
+
+    private:
+
+        /** Keys of the table */
+        std::vector<uint64_t> keys;
+
+        /** Slot of each key, NULL_SLOT if the entry is empty */
+        std::vector<uint32_t> slots;
+
+        /** Table size minus one */
+        uint64_t mask = 0;
+
+        /** Number of keys in the table */
+        uint64_t used = 0;
+
+        /**
+         * Return the home entry of an address
+         * @param addr Memory address
+         * @return Entry in the table
+         */
+        uint64_t home(uint64_t addr) const {
+            return ((addr * 0x9E3779B97F4A7C15ull) >> 32u) & mask;
+        }
+
+        /**
+         * Return the entry of an address, or the empty entry where it would be inserted
+         * @param addr Memory address
+         * @return Entry in the table
+         */
+        uint64_t locate(uint64_t addr) const {
+            auto entry = home(addr);
+            while (slots[entry] != NULL_SLOT && keys[entry] != addr)
+                entry = (entry + 1) & mask;
+            return entry;
+        }
+
+        /**
+         * Resize the table and insert all the keys again
+         * @param size New table size, power of two
+         */
+        void rehash(uint64_t size) {
+            auto old_keys = std::move(keys);
+            auto old_slots = std::move(slots);
+            keys = std::vector<uint64_t>(size, 0);
+            slots = std::vector<uint32_t>(size, NULL_SLOT);
+            mask = size - 1;
+            for (uint64_t entry = 0; entry < old_slots.size(); ++entry) {
+                if (old_slots[entry] == NULL_SLOT)
+                    continue;
+                auto new_entry = locate(old_keys[entry]);
+                keys[new_entry] = old_keys[entry];
+                slots[new_entry] = old_slots[entry];
+            }
+        }
+
+    public:
+
+        /** Constructor */
+        AddressIndex() {
+            rehash(16);
+        }
+
+        /** Remove all the addresses keeping the table size */
+        void clear() {
+            if (used == 0)
+                return;
+            std::fill(slots.begin(), slots.end(), NULL_SLOT);
+            used = 0;
+        }
+
+        /**
+         * Return the slot of an address
+         * @param addr Memory address
+         * @return Slot, NULL_SLOT if the address is not in the table
+         */
+        uint32_t find(uint64_t addr) const {
+            return slots[locate(addr)];
+        }
+
+        /**
+         * Set the slot of an address
+         * @param addr Memory address
+         * @param slot Slot
+         */
+        void insert(uint64_t addr, uint32_t slot) {
+            if ((used + 1) * 2 > slots.size())
+                rehash(slots.size() * 2);
+            auto entry = locate(addr);
+            if (slots[entry] == NULL_SLOT)
+                used++;
+            keys[entry] = addr;
+            slots[entry] = slot;
+        }
+
+        /**
+         * Remove an address from the table
+         * @param addr Memory address
+         */
+        void erase(uint64_t addr) {
+            auto entry = locate(addr);
+            if (slots[entry] == NULL_SLOT)
+                return;
+
+            // Shift back the following entries of the probe sequence that can not be found past the hole
+            auto hole = entry;
+            auto next = (entry + 1) & mask;
+            while (slots[next] != NULL_SLOT) {
+                auto next_home = home(keys[next]);
+                if (((next - next_home) & mask) >= ((next - hole) & mask)) {
+                    keys[hole] = keys[next];
+                    slots[hole] = slots[next];
+                    hole = next;
+                }
+                next = (next + 1) & mask;
+            }
+            slots[hole] = NULL_SLOT;
+            used--;
+        }
+
+    };
+
+}
+
+#endif //DNNSIM_ADDRESS_INDEX_H
@@ -238,6 +238,22 @@ namespace core {
             return idle_pe;
         }
 
+        /**
+         * Return the cycle at which the architecture accepts new data
+         * @return Ready cycle
+         */
+        uint64_t getReadyCycle() const {
+            return ready_cycle;
+        }
+
+        /**
+         * Return the cycle at which the architecture finishes the current data
+         * @return Done cycle
+         */
+        uint64_t getDoneCycle() const {
+            return done_cycle;
+        }
+
         /**
          * Get idle Lanes
          * @return Idle Lanes
@@ -425,7 +441,7 @@ namespace core {
                             if ((pow(2, configColumn) * pow(2, configLane) == (COLUMNS * LANES))
                                 && !searchArray(confArr, ROWS,pow(2, configColumn), pow(2, configLane))
                                 //&& ( pow(2, configLane) != 32 ))
-                            {
+                            ){
                                 confArr[configsNumber][0] = ROWS;
                                 confArr[configsNumber][1] = pow(2, configColumn);
                                 confArr[configsNumber][2] = pow(2, configLane);
@@ -0,0 +1,95 @@
+#ifndef DNNSIM_BANK_COUNTERS_H
+#define DNNSIM_BANK_COUNTERS_H
+
+#include "Utils.h"
+
+namespace core {
+
+    /**
+     * Per level and bank access counters of one global buffer request
+     * The counters live in a flat array tagged with the epoch of the request that last used them, so clearing them is
+     * a single increment, and only the banks touched by the request are visited to compute the bank steps.
+     */
+    class BankCounters {
+
+    private:
+
+        /** Number of banks per level */
+        const uint32_t BANKS;
+
+        /** Accesses per level and bank */
+        std::vector<uint32_t> counts;
+
+        /** Epoch of the last request that used each counter */
+        std::vector<uint32_t> epochs;
+
+        /** Current request epoch */
+        uint32_t epoch = 1;
+
+        /** Counters used in the current request */
+        std::vector<uint32_t> touched;
+
+        /** Maximum bank accesses per level in the current request */
+        std::vector<uint64_t> level_steps;
+
+    public:
+
+        /**
+         * Constructor
+         * @param _LEVELS   Number of levels
+         * @param _BANKS    Number of banks per level
+         */
+        BankCounters(uint32_t _LEVELS, uint32_t _BANKS) : BANKS(_BANKS) {
+            counts = std::vector<uint32_t>(_LEVELS * _BANKS, 0);
+            epochs = std::vector<uint32_t>(_LEVELS * _BANKS, 0);
+            touched.reserve(_LEVELS * _BANKS);
+            level_steps = std::vector<uint64_t>(_LEVELS, 0);
+        }
+
+        /** Start a new request with all the counters at zero */
+        void clear() {
+            touched.clear();
+            if (++epoch == 0) {
+                std::fill(epochs.begin(), epochs.end(), 0);
+                epoch = 1;
+            }
+        }
+
+        /**
+         * Count an access to a bank
+         * @param level Level of the access
+         * @param bank  Bank of the access
+         */
+        void increment(uint32_t level, uint32_t bank) {
+            auto slot = level * BANKS + bank;
+            if (epochs[slot] != epoch) {
+                epochs[slot] = epoch;
+                counts[slot] = 0;
+                touched.push_back(slot);
+            }
+            counts[slot]++;
+        }
+
+        /**
+         * Compute the bank accesses of the current request grouping the addresses per access
+         * @param addrs_per_access  Addresses per bank access
+         * @param accesses          Bank accesses per level, incremented with the accesses of the request
+         * @return Maximum bank accesses per level
+         */
+        const std::vector<uint64_t> &steps(uint32_t addrs_per_access, std::vector<uint64_t> &accesses) {
+            std::fill(level_steps.begin(), level_steps.end(), 0);
+            for (const auto &slot : touched) {
+                auto level = slot / BANKS;
+                uint64_t bank_accesses = (counts[slot] + addrs_per_access - 1) / addrs_per_access;
+                accesses[level] += bank_accesses;
+                if (bank_accesses > level_steps[level])
+                    level_steps[level] = bank_accesses;
+            }
+            return level_steps;
+        }
+
+    };
+
+}
+
+#endif //DNNSIM_BANK_COUNTERS_H
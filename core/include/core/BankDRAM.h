@@ -0,0 +1,98 @@
+#ifndef DNNSIM_BANK_DRAM_H
+#define DNNSIM_BANK_DRAM_H
+
+#include "DRAMBackend.h"
+
+namespace core {
+
+    /**
+     * Bank-aware analytic DRAM backend
+     * Consecutive rows are interleaved across the banks and each bank keeps its last row open. A row miss occupies the
+     * bank for the precharge and activation before the transfer, and all banks share the channel bandwidth.
+     */
+    class BankDRAM : public DRAMBackend {
+
+    private:
+
+        /** Cycles from the end of the transfer to the completion of a transaction */
+        const uint32_t LATENCY;
+
+        /** Transactions transferred per cycle */
+        const double BANDWIDTH;
+
+        /** Extra cycles to open a new row in a bank */
+        const uint32_t ROW_MISS_LATENCY;
+
+        /** Number of banks */
+        const uint32_t BANKS;
+
+        /** Row size in bytes */
+        const uint32_t ROW_SIZE;
+
+        /** Current cycle */
+        uint64_t now = 0;
+
+        /** Cycle when the channel can start the next transfer */
+        double channel_free = 0;
+
+        /** Cycle when each bank can start the next access */
+        std::vector<double> bank_free;
+
+        /** Open row per bank */
+        std::vector<uint64_t> open_row;
+
+        /** Transactions sent, to complete in order the transactions of the same cycle */
+        uint64_t sent = 0;
+
+        /** Transactions in flight: completion cycle, order, address, write */
+        std::priority_queue<std::tuple<uint64_t, uint64_t, uint64_t, bool>,
+                std::vector<std::tuple<uint64_t, uint64_t, uint64_t, bool>>,
+                std::greater<std::tuple<uint64_t, uint64_t, uint64_t, bool>>> in_flight;
+
+    public:
+
+        /**
+         * Constructor
+         * @param _read_done        Read transactions callback
+         * @param _write_done       Write transactions callback
+         * @param _LATENCY          Transaction latency in cycles
+         * @param _BANDWIDTH        Transactions transferred per cycle
+         * @param _ROW_MISS_LATENCY Extra cycles to open a new row
+         * @param _BANKS            Number of banks
+         * @param _ROW_SIZE         Row size in bytes
+         */
+        BankDRAM(const TransactionDone &_read_done, const TransactionDone &_write_done, uint32_t _LATENCY,
+                double _BANDWIDTH, uint32_t _ROW_MISS_LATENCY, uint32_t _BANKS, uint32_t _ROW_SIZE) :
+                DRAMBackend(_read_done, _write_done), LATENCY(_LATENCY), BANDWIDTH(_BANDWIDTH),
+                ROW_MISS_LATENCY(_ROW_MISS_LATENCY), BANKS(_BANKS), ROW_SIZE(_ROW_SIZE) {
+            bank_free = std::vector<double>(BANKS, 0);
+            open_row = std::vector<uint64_t>(BANKS, UINT64_MAX);
+        }
+
+        /**
+         * Return the description of the backend
+         * @return Description
+         */
+        std::string name() override;
+
+        /**
+         * Check if the backend can receive a new transaction
+         * @return True if a new transaction is accepted
+         */
+        bool will_accept_transaction() override;
+
+        /**
+         * Send a transaction to the backend
+         * @param address Address requested
+         * @param isWrite Transaction type: True = Write, False = Read
+         */
+        void add_transaction(uint64_t address, bool isWrite) override;
+
+        /** Update the backend one cycle */
+        void cycle() override;
+
+    };
+
+}
+
+#endif //DNNSIM_BANK_DRAM_H
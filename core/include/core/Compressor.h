@@ -0,0 +1,110 @@
+#ifndef DNNSIM_COMPRESSOR_H
+#define DNNSIM_COMPRESSOR_H
+
+#include <core/Utils.h>
+
+namespace core {
+
+    /**
+     * Zero-value compression and dynamic precision of the off-chip blocks
+     * The size of a compressed block includes its metadata. Blocks that do not shrink are stored dense.
+     * With dynamic precision every block stores its values with the precision of its widest value, and a header
+     * with that precision.
+     * @tparam T Data type values
+     */
+    template <typename T>
+    class Compressor {
+
+    private:
+
+        /** Bits of the zero run field of the run-length encoding */
+        const uint32_t RUN_BITS = 4;
+
+        /** Compression scheme: None, ZeroRLE, Bitmask, CSR */
+        const std::string SCHEME;
+
+        /** Store every block with the precision of its widest value */
+        const bool DYNAMIC_PRECISION;
+
+        /**
+         * Return the bits required by a value
+         * @param value         Value
+         * @param data_size     Bits per value
+         * @param signed_data   True if the value is signed
+         * @return Required bits
+         */
+        uint32_t value_bits(T value, uint32_t data_size, bool signed_data) const;
+
+        /**
+         * Return the bits of a block with the zero-value compression scheme, or dense
+         * @param values    Values of the block
+         * @param data_size Bits per value
+         * @return Compressed bits
+         */
+        uint64_t compressed_bits(const std::vector<T> &values, uint32_t data_size) const;
+
+        /**
+         * Return the bits of a block encoded as (zero run, value) pairs. Runs longer than the run field store an
+         * explicit zero, trailing zeros are implicit in the number of pairs.
+         * @param values    Values of the block
+         * @param data_size Bits per value
+         * @return Compressed bits
+         */
+        uint64_t zero_rle_bits(const std::vector<T> &values, uint32_t data_size) const;
+
+        /**
+         * Return the bits of a block encoded as a mask with one bit per value followed by the non-zero values
+         * @param values    Values of the block
+         * @param data_size Bits per value
+         * @return Compressed bits
+         */
+        uint64_t bitmask_bits(const std::vector<T> &values, uint32_t data_size) const;
+
+        /**
+         * Return the bits of a block encoded as a compressed sparse row: the non-zero values with their position
+         * and the number of non-zero values
+         * @param values    Values of the block
+         * @param data_size Bits per value
+         * @return Compressed bits
+         */
+        uint64_t csr_bits(const std::vector<T> &values, uint32_t data_size) const;
+
+    public:
+
+        /**
+         * Constructor
+         * @param _SCHEME               Compression scheme: None, ZeroRLE, Bitmask, CSR
+         * @param _DYNAMIC_PRECISION    Store every block with the precision of its widest value
+         */
+        Compressor(const std::string &_SCHEME, bool _DYNAMIC_PRECISION) : SCHEME(_SCHEME),
+                DYNAMIC_PRECISION(_DYNAMIC_PRECISION) {
+            if (SCHEME != "None" && SCHEME != "ZeroRLE" && SCHEME != "Bitmask" && SCHEME != "CSR")
+                throw std::runtime_error("Incorrect DRAM compression scheme");
+        }
+
+        /**
+         * Return the compression scheme
+         * @return Compression scheme
+         */
+        const std::string &getScheme() const;
+
+        /**
+         * Return True if the blocks are compressed or stored with dynamic precision
+         * @return True if enabled
+         */
+        bool enabled() const;
+
+        /**
+         * Return the stored bits of a block, including the compression and precision metadata
+         * @param values        Values of the block
+         * @param data_size     Bits per value
+         * @param signed_data   True if the values are signed
+         * @return Stored bits
+         */
+        uint64_t block_bits(const std::vector<T> &values, uint32_t data_size, bool signed_data) const;
+
+    };
+
+}
+
+#endif //DNNSIM_COMPRESSOR_H
@@ -124,6 +124,41 @@ namespace core {
         /** True if activations on-chip for the next layer */
         bool next_layer_act_on_chip = false;
 
+        /** Window-filter sets visited in the current layer by the dataflow traversal */
+        uint64_t set_visits = 0;
+
+        /** Window-filter sets simulated in the current layer by the dataflow traversal */
+        uint64_t simulated_sets = 0;
+
+        /** True while a simulated set of the current node is in the pipeline */
+        bool set_open = false;
+
+        /** True if the set in the pipeline is measured */
+        bool set_measured = false;
+
+        /** True if the set in the pipeline only warms up the pipeline */
+        bool set_warm = false;
+
+        /** Cycle when the current simulated set started */
+        uint64_t set_start_cycle = 0;
+
+        /** Cycles spent on each sampled set by this architecture */
+        std::vector<double> set_cycles;
+
+        /** Cycles the clock advanced over the skipped sets of the current layer */
+        uint64_t skipped_cycles = 0;
+
+        /** Number of warm-up sets of the current layer */
+        uint64_t warm_sets = 0;
+
+        /** Cycles spent on the warm-up sets of the current layer, not representative as they follow skipped sets */
+        uint64_t warm_cycles = 0;
+
+        /**
+         * Record the cycles of the sampled set in progress
+         */
+        void close_set();
+
         /**
          * Generate memory mapping for input data
          */
@@ -176,6 +211,12 @@ namespace core {
         /** Update time one cycle */
         void cycle();
 
+        /**
+         * Advance the time while the off-chip memory is idle
+         * @param cycles Number of cycles
+         */
+        void skip_cycles(uint64_t cycles);
+
         /**
          * Return a pointer to the dram model
          * @return Dram model
@@ -256,6 +297,19 @@ namespace core {
                 const std::shared_ptr<base::Array<T>> &_wgt, uint32_t act_prec, uint32_t wgt_prec, bool _linear,
                 bool __3dim, int _stride);
 
+        /**
+         * Configure the memory and architecture models for the current layer without the values
+         * @param act_prec      Activations precision
+         * @param wgt_prec      Weight precision
+         * @param signed_act    True if signed activations
+         * @param signed_wgt    True if signed weights
+         * @param _linear       True if linear layer
+         * @param __3dim        True if layer has 3 dimensions
+         * @param _stride       Stride
+         */
+        void configure_models(uint32_t act_prec, uint32_t wgt_prec, bool signed_act, bool signed_wgt, bool _linear,
+                bool __3dim, int _stride);
+
         /**
          * Return activation addresses to read for the current node
          * @return Activation addresses to read
@@ -274,12 +328,42 @@ namespace core {
          */
         const std::vector<AddressRange> &getReadWgtAddresses() const;
 
+        /**
+         * Return True if there is a node after the current one
+         * @return True if next node
+         */
+        bool hasNextNode() const;
+
+        /**
+         * Return activation addresses to read for the next node
+         * @return Activation addresses to read
+         */
+        const std::vector<AddressRange> &getNextReadActAddresses() const;
+
+        /**
+         * Return partial sum addresses to read for the next node
+         * @return Partial sum addresses to read
+         */
+        const std::vector<AddressRange> &getNextReadPsumAddresses() const;
+
+        /**
+         * Return weight addresses to read for the next node
+         * @return Weight addresses to read
+         */
+        const std::vector<AddressRange> &getNextReadWgtAddresses() const;
+
         /**
          * Return output activation addresses to write for the current node
          * @return Output Activation addresses to write
          */
         const std::vector<AddressRange> &getWriteAddresses() const;
 
+        /**
+         * Return the addresses read by all the nodes of the layer
+         * @return Activation, partial sum and weight addresses to read
+         */
+        std::vector<AddressRange> getLayerReadAddresses() const;
+
         /**
          * Return True if evict previous activations from on-chip for the current node
          * @return Evict Activation
@@ -324,6 +408,13 @@ namespace core {
          */
         virtual bool still_on_chip_data(TilesData<T> &tiles_data) = 0;
 
+        /**
+         * Generate the on-chip steps of every remaining node of the layer, numbered from the first one.
+         * The nodes are left to traverse.
+         * @return On-chip steps of each node
+         */
+        std::vector<std::vector<std::shared_ptr<TilesData<T>>>> generate_layer_steps();
+
         /**
          * Return true if there is output values to write to the global buffer
          * @param tiles_data Current data to process in the tiles
@@ -331,6 +422,93 @@ namespace core {
          */
         bool check_if_write_output(const std::shared_ptr<TilesData<T>> &tiles_data);
 
+        /**
+         * Return the number of output values written to the global buffer by an on-chip step
+         * @param tiles_data Current data to process in the tiles
+         * @return Outputs written
+         */
+        uint64_t calculate_step_outputs(const std::shared_ptr<TilesData<T>> &tiles_data);
+
+        /**
+         * Start the cycles of a simulated set when its first on-chip step enters the pipeline, and finish the
+         * previous set of the node. Sets neither measured nor warming up keep their simulated cycles.
+         * @param measured  True if the set is measured
+         * @param warm      True if the set only warms up the pipeline
+         */
+        void start_set(bool measured, bool warm);
+
+        /**
+         * Finish the sampled set in progress at the end of an off-chip node, and take the set visits from the
+         * control that traverses the dataflow. Every co-simulated architecture keeps its own set cycles.
+         * @param leader Control that generates the on-chip steps
+         */
+        void end_node_sets(const Control<T> &leader);
+
+        /**
+         * Return the number of window-filter sets skipped so far in the current layer
+         * @return Skipped sets
+         */
+        uint64_t getSkippedSets() const;
+
+        /**
+         * Return the number of sets of the current layer whose cycles are extrapolated from the measured sets: the
+         * skipped and the warm-up sets
+         * @return Extrapolated sets
+         */
+        uint64_t getExtrapolatedSets() const;
+
+        /**
+         * Finish the sampled set in progress and return the time of the sets skipped after it, at the mean cycles
+         * per set measured so far. The clock runs over them so the off-chip transfers overlap them as in the full
+         * run, and the estimated cycles replace this time with the final mean.
+         * @param sets Number of skipped sets
+         * @return Cycles to advance
+         */
+        uint64_t skip_sets(uint64_t sets);
+
+        /**
+         * Return True if the dataflow only simulates a sample of the on-chip steps
+         * @return True if sampling
+         */
+        virtual bool sampling() const;
+
+        /**
+         * Return the number of cycles for the current layer extrapolated from the sampled steps
+         * @return Estimated cycles
+         */
+        virtual double getEstimatedCycles() const;
+
+        /**
+         * Return the half-width of the confidence interval for the estimated cycles
+         * @return Confidence interval half-width
+         */
+        virtual double getEstimatedCyclesInterval() const;
+
+        /**
+         * Return the fraction of the on-chip work simulated in the current layer. The global buffer statistics only
+         * count the simulated steps.
+         * @return Simulated fraction
+         */
+        virtual double getSimulatedFraction() const;
+
+        /**
+         * Return True if the dataflow searches the mapping of each layer
+         * @return True if mapping search
+         */
+        virtual bool mapping_search() const;
+
+        /**
+         * Return the memory policies and tiling chosen for the current layer
+         * @return Mapping description
+         */
+        virtual std::string getMapping() const;
+
+        /**
+         * Return the estimated DRAM traffic in bytes of the mapping chosen for the current layer
+         * @return Estimated DRAM traffic
+         */
+        virtual uint64_t getMappingTraffic() const;
+
     };
 
 }
@@ -2,10 +2,108 @@
 #define DNNSIM_DRAM_H
 
 #include "Memory.h"
-#include <DRAMSim.h>
+#include "DRAMSimBackend.h"
+#include "IdealDRAM.h"
+#include "FixedDRAM.h"
+#include "BankDRAM.h"
+#include "TransactionLog.h"
+#include "AddressIndex.h"
+#include "Compressor.h"
+#include <sys/stat.h>
 
 namespace core {
 
+    /**
+     * DRAM parameters
+     */
+    struct DRAMOptions {
+
+        /** Interface width */
+        uint32_t width = 0;
+
+        /** Size in MiB */
+        uint32_t size = 0;
+
+        /** Baseline data size in bits */
+        uint32_t data_size = 0;
+
+        /** Compute frequency */
+        uint64_t clock_freq = 0;
+
+        /** Start activation address */
+        uint64_t start_act_address = 0;
+
+        /** Start weight address */
+        uint64_t start_wgt_address = 0;
+
+        /** DRAM configuration file */
+        std::string dram_conf;
+
+        /** System configuration file */
+        std::string system_conf;
+
+        /** Network name */
+        std::string network;
+
+        /** Timing model: DRAMSim2, Ideal, Fixed, Bank */
+        std::string backend;
+
+        /** Transaction latency in cycles for the analytic models */
+        uint32_t latency = 0;
+
+        /** Transactions per cycle for the analytic models */
+        double bandwidth = 0;
+
+        /** Extra cycles to open a new row for the bank model */
+        uint32_t row_miss_latency = 0;
+
+        /** Number of banks for the bank model */
+        uint32_t banks = 0;
+
+        /** Row size in bytes for the bank model */
+        uint32_t row_size = 0;
+
+        /** Write the DRAMSim2 visualization file */
+        bool vis_output = false;
+
+        /** File to record and replay the transaction stream (empty to disable) */
+        std::string transaction_log;
+
+        /** Folder to export each layer as a DRAMSim2 trace (empty to disable) */
+        std::string trace_dir;
+
+        /** Prefetch the data of the next on-chip stage while the current one computes */
+        bool prefetch = false;
+
+        /** Zero-value compression scheme: None, ZeroRLE, Bitmask, CSR */
+        std::string compression;
+
+        /** Off-chip layout of the values: None, Static, Dynamic */
+        std::string packing;
+
+        /** Activations layout: NHWC, NCHW, NCHWc, Auto */
+        std::string layout;
+
+        /** Timing model of the dedicated weight memory (empty to share the memory) */
+        std::string wgt_backend;
+
+        /** DRAM configuration file of the dedicated weight memory */
+        std::string wgt_dram_conf;
+
+        /** Transaction latency in cycles of the dedicated weight memory */
+        uint32_t wgt_latency = 0;
+
+        /** Transactions per cycle of the dedicated weight memory */
+        double wgt_bandwidth = 0;
+
+        /** Consecutive activation and partial sum reads per round of the arbitration */
+        uint32_t act_burst = 0;
+
+        /** Consecutive weight reads per round of the arbitration */
+        uint32_t wgt_burst = 0;
+
+    };
+
     /**
      * DRAM model
      * @tparam T Data type values
@@ -29,6 +127,28 @@ namespace core {
         /** Size in MiB */
         const uint32_t SIZE;
 
+        /** Prefetch the data of the next on-chip stage while the current one computes */
+        const bool PREFETCH;
+
+        /** Off-chip layout of the values: None (power of two sizes), Static (layer precision), Dynamic (block
+         * precision) */
+        const std::string PACKING;
+
+        /** Zero-value compression and dynamic precision of the off-chip blocks */
+        const Compressor<T> compressor;
+
+        /** Activations layout: NHWC, NCHW (one plane per DRAM block), NCHWc, Auto (NHWC aligned to the Bank rows) */
+        const std::string LAYOUT;
+
+        /** DRAM row size in bytes */
+        const uint32_t ROW_SIZE;
+
+        /** Consecutive activation and partial sum reads per round of the read arbitration */
+        const uint32_t ACT_BURST;
+
+        /** Consecutive weight reads per round of the read arbitration */
+        const uint32_t WGT_BURST;
+
         /** Baseline values per DRAM block */
         uint32_t BASE_VALUES_PER_BLOCK;
 
@@ -47,14 +167,88 @@ namespace core {
         /** Weights data size in bits */
         uint32_t WGT_DATA_SIZE;
 
-        /** Memory system */
-        DRAMSim::MultiChannelMemorySystem *dram_interface;
+        /** Timing model */
+        std::shared_ptr<DRAMBackend> backend;
+
+        /** Timing model of the dedicated weight memory, nullptr if weights share the memory with activations */
+        std::shared_ptr<DRAMBackend> wgt_backend;
+
+        /** Transactions queue per memory: ring buffer of address and type, doubled when full */
+        std::vector<std::tuple<uint64_t, bool>> request_queue[2];
+
+        /** Position of the oldest transaction in the queue per memory */
+        uint64_t request_head[2] = {0, 0};
+
+        /** Transactions in the queue per memory */
+        uint64_t request_count[2] = {0, 0};
+
+        /** Start address of the two DRAM regions: the lower and the higher start addresses */
+        uint64_t region_start[2];
+
+        /** Required addresses waiting to be transferred to on-chip: one bit per DRAM block of the layer and region */
+        std::vector<uint64_t> waiting_blocks[2];
+
+        /** Number of required addresses waiting to be transferred to on-chip */
+        uint64_t waiting_addresses = 0;
+
+        /** Number of transactions requested whose completion has not been reported yet */
+        uint64_t transactions_in_flight = 0;
+
+        /** Number of reads of the current on-chip stage still off-chip */
+        uint64_t stage_reads_in_flight = 0;
+
+        /** Addresses prefetched for the next on-chip stage: 0 while in flight, 1 once transferred */
+        AddressIndex prefetched;
+
+        /** Number of prefetched addresses not read yet by their on-chip stage */
+        uint64_t prefetched_addresses = 0;
+
+        /** Output addresses of the current on-chip stage written back as the outputs are produced */
+        std::vector<uint64_t> staged_writes;
+
+        /** True if the output addresses of the current on-chip stage are streamed */
+        bool writes_staged = false;
+
+        /** Staged addresses already written */
+        uint64_t staged_written = 0;
+
+        /** Output values produced and not written yet */
+        uint64_t staged_values = 0;
+
+        /** Transaction stream log, nullptr if not recorded */
+        std::shared_ptr<TransactionLog> transaction_log;
 
-        /** Transactions queue */
-        std::queue<std::tuple<uint64_t, bool>> request_queue;
+        /** Current cycle */
+        uint64_t now = 0;
 
-        /** List of required addresses waiting to be transferred to on-chip */
-        std::set<uint64_t> waiting_addresses;
+        /** Cycles the timing models have been updated, behind the current cycle while the log is replayed */
+        uint64_t backend_now = 0;
+
+        /** Transactions replayed, to complete in order the transactions of the same cycle */
+        uint64_t replay_sent = 0;
+
+        /** Folder where each layer is exported as a DRAMSim2 trace, empty if not exported */
+        std::string trace_dir;
+
+        /** Network name for the exported traces */
+        std::string trace_network;
+
+        /** DRAMSim2 trace of the current layer */
+        std::ofstream trace_file;
+
+        /** Layers exported */
+        uint64_t trace_layers = 0;
+
+        /** Cycle when the current layer started */
+        uint64_t layer_start = 0;
+
+        /** DRAM clock cycles per compute cycle for the trace stamps */
+        double trace_clock_ratio = 1.0;
+
+        /** Replayed transactions in flight, completed at their recorded latency: cycle, order, address, write */
+        std::priority_queue<std::tuple<uint64_t, uint64_t, uint64_t, bool>,
+                std::vector<std::tuple<uint64_t, uint64_t, uint64_t, bool>>,
+                std::greater<std::tuple<uint64_t, uint64_t, uint64_t, bool>>> replay_in_flight;
 
         /* STATISTICS */
 
@@ -71,52 +265,165 @@ namespace core {
         uint64_t out_writes = 0;
 
         /**
-         * Request an address to the memory system
+         * Request an address to the memory system, replaying its latency from the transaction log if possible
          * @param address Address to request
          * @param isWrite Transaction type: True = Write, False = Read
          */
         void transaction_request(uint64_t address, bool isWrite);
 
-    public:
+        /**
+         * Create a timing model
+         * @param _backend          Timing model: DRAMSim2, Ideal, Fixed, Bank
+         * @param _dram_conf        DRAM configuration file
+         * @param _system_conf      System configuration file
+         * @param _name             Name of the DRAMSim2 visualization file
+         * @param _clock_freq       Compute frequency
+         * @param _latency          Transaction latency in cycles for the analytic models
+         * @param _bandwidth        Transactions per cycle for the analytic models
+         * @param _row_miss_latency Extra cycles to open a new row for the bank model
+         * @param _banks            Number of banks for the bank model
+         * @param _row_size         Row size in bytes for the bank model
+         * @param _vis_output       Write the DRAMSim2 visualization file
+         * @return Timing model
+         */
+        std::shared_ptr<DRAMBackend> create_backend(const std::string &_backend, const std::string &_dram_conf,
+                const std::string &_system_conf, const std::string &_name, uint64_t _clock_freq, uint32_t _latency,
+                double _bandwidth, uint32_t _row_miss_latency, uint32_t _banks, uint32_t _row_size, bool _vis_output);
 
         /**
-         * Constructor
-         * @param _tracked_data         Current tracked data on-chip
-         * @param _act_addresses        Address range for activations
-         * @param _out_addresses        Output activation addresses range
-         * @param _wgt_addresses        Address range for weights
-         * @param _WIDTH                Interface width
-         * @param _SIZE                 Size in MiB
-         * @param _BASE_DATA_SIZE       Baseline data size in bits
-         * @param _clock_freq           Compute frequency
-         * @param _START_ACT_ADDRESS    Start activation address
-         * @param _START_WGT_ADDRESS    Start weight address
-         * @param _dram_conf            DRAM configuration file
-         * @param _system_conf          System configuration file
-         * @param _network              Network name
+         * Return the memory serving an address
+         * @param address Memory address
+         * @return 1 if the address is served by the dedicated weight memory, 0 otherwise
          */
-        DRAM(const std::shared_ptr<std::map<uint64_t, uint32_t>> &_tracked_data,
-                const std::shared_ptr<AddressRange> &_act_addresses, const std::shared_ptr<AddressRange> &_out_addresses,
-                const std::shared_ptr<AddressRange> &_wgt_addresses, uint32_t _WIDTH, uint32_t _SIZE,
-                uint32_t _BASE_DATA_SIZE, uint64_t _clock_freq, uint64_t _START_ACT_ADDRESS, uint64_t _START_WGT_ADDRESS,
-                const std::string &_dram_conf, const std::string &_system_conf, const std::string &_network) :
-                Memory<T>(_tracked_data, _act_addresses, _out_addresses, _wgt_addresses), WIDTH(_WIDTH),
-                START_ACT_ADDRESS(_START_ACT_ADDRESS), START_WGT_ADDRESS(_START_WGT_ADDRESS), SIZE(_SIZE),
-                BASE_VALUES_PER_BLOCK(64 / _BASE_DATA_SIZE), BASE_DATA_SIZE(_BASE_DATA_SIZE), ACT_VALUES_PER_BLOCK(0),
-                ACT_DATA_SIZE(0), WGT_VALUES_PER_BLOCK(0), WGT_DATA_SIZE(0) {
+        uint32_t memory(uint64_t address) const;
 
-            dram_interface = DRAMSim::getMemorySystemInstance(_dram_conf, _system_conf, "./DRAMSim2/",
-                    "DNNsim_" + _network, _SIZE);
+        /**
+         * Update the timing models until they reach a cycle
+         * @param cycle Cycle to reach
+         */
+        void update_backends(uint64_t cycle);
 
-            DRAMSim::TransactionCompleteCB *read_cb =
-                    new DRAMSim::Callback<DRAM, void, unsigned, uint64_t, uint64_t>(this, &DRAM::read_transaction_done);
+        /**
+         * Send a transaction to the timing model, or queue it if not accepted
+         * @param address Address to request
+         * @param isWrite Transaction type: True = Write, False = Read
+         */
+        void send_transaction(uint64_t address, bool isWrite);
 
-            DRAMSim::TransactionCompleteCB *write_cb =
-                    new DRAMSim::Callback<DRAM, void, unsigned, uint64_t, uint64_t>(this, &DRAM::write_transaction_done);
+        /**
+         * Send the oldest queued transaction of a memory to its timing model
+         * @param mem Memory: 0 for the shared or activation memory, 1 for the dedicated weight memory
+         */
+        void dequeue_request(uint32_t mem);
+
+        /**
+         * Return the waiting list bit of an address
+         * @param address   Off-chip address
+         * @param region    Returns the region of the address
+         * @return Block of the address inside its region
+         */
+        uint64_t waiting_block(uint64_t address, int &region) const;
+
+        /**
+         * Add an address to the waiting list if not there yet
+         * @param address Address required on-chip
+         */
+        void wait_address(uint64_t address);
+
+        /**
+         * Remove an address from the waiting list if there
+         * @param address Address transferred on-chip
+         */
+        void release_address(uint64_t address);
+
+        /**
+         * Track on-chip an address already prefetched instead of requesting it again
+         * @param address Memory address
+         * @return True if the address was prefetched
+         */
+        bool claim_prefetched(uint64_t address);
+
+        /**
+         * Read ahead of time the addresses not on-chip yet, while there is free on-chip capacity
+         * @param addresses Read addresses of the next stage
+         * @param reads     Off-chip reads of the data type (Overwritten)
+         * @param free      Free on-chip capacity in addresses (Overwritten)
+         */
+        void prefetch_addresses(const std::vector<AddressRange> &addresses, uint64_t &reads, uint64_t &free);
+
+        /**
+         * Return the number of addresses tracked on-chip inside a range
+         * @param range Address range
+         * @return Number of addresses
+         */
+        uint64_t resident_addresses(const AddressRange &range) const;
 
-            dram_interface->RegisterCallbacks(read_cb, write_cb, nullptr);
+        /**
+         * Wait for the addresses inside a range that are still in flight from off-chip
+         * @param range Address range
+         */
+        void wait_range(const AddressRange &range);
 
-            dram_interface->setCPUClockSpeed(_clock_freq);
+    public:
+
+        /**
+         * Constructor
+         * @param _tracked_data     Current tracked data on-chip
+         * @param _act_addresses    Address range for activations
+         * @param _out_addresses    Output activation addresses range
+         * @param _wgt_addresses    Address range for weights
+         * @param _options          DRAM parameters
+         */
+        DRAM(const std::shared_ptr<std::map<uint64_t, uint32_t>> &_tracked_data,
+                const std::shared_ptr<AddressRange> &_act_addresses, const std::shared_ptr<AddressRange> &_out_addresses,
+                const std::shared_ptr<AddressRange> &_wgt_addresses, const DRAMOptions &_options) :
+                Memory<T>(_tracked_data, _act_addresses, _out_addresses, _wgt_addresses), WIDTH(_options.width),
+                START_ACT_ADDRESS(_options.start_act_address), START_WGT_ADDRESS(_options.start_wgt_address),
+                SIZE(_options.size), PREFETCH(_options.prefetch), PACKING(_options.packing),
+                compressor(_options.compression, _options.packing == "Dynamic"), LAYOUT(_options.layout),
+                ROW_SIZE(_options.row_size), ACT_BURST(_options.act_burst), WGT_BURST(_options.wgt_burst),
+                BASE_VALUES_PER_BLOCK(64 / _options.data_size), BASE_DATA_SIZE(_options.data_size),
+                ACT_VALUES_PER_BLOCK(0), ACT_DATA_SIZE(0), WGT_VALUES_PER_BLOCK(0), WGT_DATA_SIZE(0) {
+
+            request_queue[0] = std::vector<std::tuple<uint64_t, bool>>(4096);
+            request_queue[1] = std::vector<std::tuple<uint64_t, bool>>(4096);
+            region_start[0] = std::min(START_ACT_ADDRESS, START_WGT_ADDRESS);
+            region_start[1] = std::max(START_ACT_ADDRESS, START_WGT_ADDRESS);
+
+            backend = create_backend(_options.backend, _options.dram_conf, _options.system_conf,
+                    "DNNsim_" + _options.network, _options.clock_freq, _options.latency, _options.bandwidth,
+                    _options.row_miss_latency, _options.banks, _options.row_size, _options.vis_output);
+
+            if (!_options.wgt_backend.empty()) {
+                if (START_ACT_ADDRESS == START_WGT_ADDRESS)
+                    throw std::runtime_error("Dedicated weight memory needs different activation and weight start "
+                                             "addresses");
+                wgt_backend = create_backend(_options.wgt_backend, _options.wgt_dram_conf, _options.system_conf,
+                        "DNNsim_" + _options.network + "_wgt", _options.clock_freq, _options.wgt_latency,
+                        _options.wgt_bandwidth, _options.row_miss_latency, _options.banks, _options.row_size,
+                        _options.vis_output);
+            }
+
+            if (!_options.transaction_log.empty()) {
+                auto key = _options.backend + "_" + _options.dram_conf + "_" + _options.system_conf + "_" +
+                        std::to_string(_options.size) + "_" + std::to_string(_options.clock_freq) + "_" +
+                        std::to_string(_options.latency) + "_" + std::to_string(_options.bandwidth) + "_" +
+                        std::to_string(_options.row_miss_latency) + "_" + std::to_string(_options.banks) + "_" +
+                        std::to_string(_options.row_size);
+                if (wgt_backend)
+                    key += "_W" + _options.wgt_backend + "_" + _options.wgt_dram_conf + "_" +
+                            std::to_string(_options.wgt_latency) + "_" + std::to_string(_options.wgt_bandwidth);
+                transaction_log = std::make_shared<TransactionLog>(_options.transaction_log, key);
+            }
+
+            if (!_options.trace_dir.empty()) {
+                std::ifstream dir(_options.trace_dir);
+                if (!dir.good() && mkdir(_options.trace_dir.c_str(), 0775) == -1)
+                    throw std::runtime_error("Error creating folder " + _options.trace_dir);
+                trace_dir = _options.trace_dir;
+                trace_network = _options.network;
+                trace_clock_ratio = backend->memory_cycles_per_cycle();
+            }
         }
 
         /**
@@ -197,20 +504,77 @@ namespace core {
          */
         uint32_t getWgtDataSize() const;
 
+        /**
+         * Return True if the values are stored with the layer precision instead of power of two sizes
+         * @return True if packed
+         */
+        bool packed() const;
+
+        /**
+         * Return True if the size of the off-chip blocks depends on their values
+         * @return True if compressed or stored with dynamic precision
+         */
+        bool compression() const;
+
+        /**
+         * Return the stored bits of an off-chip block. Without compression every block fills a line.
+         * @param values        Values of the block
+         * @param data_size     Bits per value
+         * @param signed_data   True if the values are signed
+         * @return Stored bits
+         */
+        uint64_t block_bits(const std::vector<T> &values, uint32_t data_size, bool signed_data) const;
+
+        /**
+         * Return the address of an off-chip block packed in the line being filled, or in a new line if it does not
+         * fit
+         * @param bits          Stored bits of the block
+         * @param next_address  Address offset of the line being filled, updated
+         * @param line_bits     Bits used of the line being filled, updated
+         * @return Address offset of the block
+         */
+        uint64_t pack_block(uint64_t bits, uint64_t &next_address, uint64_t &line_bits) const;
+
+        /**
+         * Return the activations layout
+         * @return Activations layout
+         */
+        const std::string &getLayout() const;
+
+        /**
+         * Move to the next DRAM row if a unit of blocks read together fits in a row but not in the rest of the
+         * current one. Only the Auto layout aligns the units.
+         * @param start_address Start address of the region
+         * @param next_address  Address offset of the line being filled, updated
+         * @param line_bits     Bits used of the line being filled, updated
+         * @param unit_size     Size of the unit in addresses, dense
+         */
+        void align_unit(uint64_t start_address, uint64_t &next_address, uint64_t &line_bits, uint64_t unit_size) const;
+
+        /**
+         * Close the line being filled so the next block starts a new line
+         * @param next_address  Address offset of the line being filled, updated
+         * @param line_bits     Bits used of the line being filled, updated
+         */
+        void close_line(uint64_t &next_address, uint64_t &line_bits) const;
+
         /**
          * Return stats header for the DRAM
          * @return Header
          */
         std::string header() override;
 
-        /** Update memory interface one cycle */
+        /**
+         * Update memory interface one cycle. The timing models are not updated while the transaction log is replayed,
+         * they catch up with the idle cycles at the first mismatch
+         */
         void cycle();
 
         /** Configure memory for current layer parameters */
         void configure_layer() override {}; // Unused
 
         /**
-         * Configure memory for current layer parameters
+         * Configure memory for current layer parameters, and start the trace of the layer if exported
          * @param _ACT_DATA_SIZE Activations data size in bits
          * @param _WGT_DATA_SIZE Weight data size in bits
          */
@@ -229,6 +593,30 @@ namespace core {
          */
         bool data_ready();
 
+        /**
+         * Check if any transaction is still queued or in flight
+         * @return True if the memory is busy
+         */
+        bool busy() const;
+
+        /**
+         * Size the waiting lists to hold the off-chip addresses read by the layer
+         * @param addresses Address ranges read by the layer
+         */
+        void reserve_addresses(const std::vector<AddressRange> &addresses);
+
+        /**
+         * Check if any read of the current on-chip stage is still off-chip
+         * @return True if the stage is still reading
+         */
+        bool reading() const;
+
+        /**
+         * Advance the clock while the memory is idle, without updating the timing model
+         * @param cycles Number of cycles
+         */
+        void skip_cycles(uint64_t cycles);
+
         /**
          * Add requested data on-chip to the waiting list if still off-chip
          * @param tiles_data Data to be read
@@ -238,14 +626,13 @@ namespace core {
 
         /**
          * Callback function for read address from DRAM
-         * @param id            Channel id
          * @param address       Address requested
-         * @param _clock_cycle  Arrival clock cycle
          */
-        void read_transaction_done(unsigned id, uint64_t address, uint64_t _clock_cycle);
+        void read_transaction_done(uint64_t address);
 
         /**
-         * Read memory addresses from off-chip alternating blocks of 16 addresses
+         * Read memory addresses from off-chip with a weighted round-robin: each round requests a burst of activation,
+         * partial sum and weight addresses
          * @param act_addresses     Activation read addresses
          * @param psum_addresses    Partial sum read addresses
          * @param wgt_addresses     Weight read addresses
@@ -253,15 +640,50 @@ namespace core {
         void read_data(const std::vector<AddressRange> &act_addresses, const std::vector<AddressRange> &psum_addresses,
                 const std::vector<AddressRange> &wgt_addresses);
 
+        /**
+         * Return True if the data of the next on-chip stage is prefetched
+         * @return True if prefetch
+         */
+        bool prefetch() const;
+
+        /**
+         * Read the addresses of the next on-chip stage ahead of time, up to the free on-chip capacity left by the
+         * data currently on-chip. The stage reading them later waits only for the transfers still in flight.
+         * @param act_addresses     Activation read addresses of the next stage
+         * @param psum_addresses    Partial sum read addresses of the next stage
+         * @param wgt_addresses     Weight read addresses of the next stage
+         * @param act_capacity      Activation and output on-chip capacity in addresses
+         * @param wgt_capacity      Weight on-chip capacity in addresses
+         */
+        void prefetch_data(const std::vector<AddressRange> &act_addresses,
+                const std::vector<AddressRange> &psum_addresses, const std::vector<AddressRange> &wgt_addresses,
+                uint64_t act_capacity, uint64_t wgt_capacity);
+
+        /**
+         * Wait for every read of the current on-chip stage still in flight. The sampled runs skip the steps that
+         * would have requested them, so they must arrive before the next stage evicts their addresses.
+         */
+        void wait_read_data();
+
+        /**
+         * Write back the output addresses of the current on-chip stage as the outputs are produced
+         * @param write_addresses   Output activation addresses of the stage
+         */
+        void stage_writes(const std::vector<AddressRange> &write_addresses);
+
+        /**
+         * Write the staged addresses filled by the outputs of an on-chip step
+         * @param outputs Output values produced
+         */
+        void write_request(uint64_t outputs);
+
         /**
          * Callback function for write address from DRAM
-         * @param id            Channel id
          * @param address       Address requested
-         * @param _clock_cycle  Arrival clock cycle
          */
-        void write_transaction_done(unsigned id, uint64_t address, uint64_t _clock_cycle);
+        void write_transaction_done(uint64_t address);
 
-        /** Write memory addresses to off-chip
+        /** Write memory addresses to off-chip, only the ones not written yet if they were staged
          * @param write_addresses   Output activation addresses
          */
         void write_data(const std::vector<AddressRange> &write_addresses);
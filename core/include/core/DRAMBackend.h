@@ -0,0 +1,74 @@
+#ifndef DNNSIM_DRAM_BACKEND_H
+#define DNNSIM_DRAM_BACKEND_H
+
+#include "Utils.h"
+#include <functional>
+
+namespace core {
+
+    /** Callback for a completed transaction with the transaction address */
+    typedef std::function<void(uint64_t)> TransactionDone;
+
+    /**
+     * DRAM Backend Interface
+     * Timing model behind the DRAM: receives the transactions and calls back when they are completed. All the cycles
+     * are compute cycles.
+     */
+    class DRAMBackend {
+
+    protected:
+
+        /** Read transactions callback */
+        const TransactionDone read_done;
+
+        /** Write transactions callback */
+        const TransactionDone write_done;
+
+    public:
+
+        /**
+         * Constructor
+         * @param _read_done    Read transactions callback
+         * @param _write_done   Write transactions callback
+         */
+        DRAMBackend(const TransactionDone &_read_done, const TransactionDone &_write_done) : read_done(_read_done),
+                write_done(_write_done) {}
+
+        /** Destructor */
+        virtual ~DRAMBackend() = default;
+
+        /**
+         * Return the description of the backend
+         * @return Description
+         */
+        virtual std::string name() = 0;
+
+        /**
+         * Check if the backend can receive a new transaction
+         * @return True if a new transaction is accepted
+         */
+        virtual bool will_accept_transaction() = 0;
+
+        /**
+         * Send a transaction to the backend
+         * @param address Address requested
+         * @param isWrite Transaction type: True = Write, False = Read
+         */
+        virtual void add_transaction(uint64_t address, bool isWrite) = 0;
+
+        /** Update the backend one cycle */
+        virtual void cycle() = 0;
+
+        /**
+         * Return the memory clock cycles per compute cycle
+         * @return Memory cycles per compute cycle
+         */
+        virtual double memory_cycles_per_cycle() {
+            return 1.0;
+        }
+
+    };
+
+}
+
+#endif //DNNSIM_DRAM_BACKEND_H
@@ -0,0 +1,163 @@
+#ifndef DNNSIM_DRAMSIM_BACKEND_H
+#define DNNSIM_DRAMSIM_BACKEND_H
+
+#include "DRAMBackend.h"
+#include <DRAMSim.h>
+#include <mutex>
+
+namespace core {
+
+    /**
+     * Pool of DRAMSim2 memory systems reused across experiments
+     * Creating a memory system parses the ini files and allocates all the channels, ranks and banks, so idle
+     * instances are kept per configuration and reset before handing them out again. Every memory system owns its
+     * configuration, so the pool can be shared by experiments running concurrently.
+     */
+    class DRAMPool {
+
+    private:
+
+        /** Idle memory systems per configuration */
+        static std::map<std::string, std::vector<DRAMSim::MultiChannelMemorySystem*>> idle;
+
+        /** Lock for the idle memory systems */
+        static std::mutex idle_lock;
+
+    public:
+
+        /**
+         * Return the configuration key of a memory system
+         * @param dram_conf     DRAM configuration file
+         * @param system_conf   System configuration file
+         * @param trace         Trace name for the output files
+         * @param size          Size in MiB
+         * @param vis_output    Write the DRAMSim2 visualization file
+         * @return Key
+         */
+        static std::string key(const std::string &dram_conf, const std::string &system_conf, const std::string &trace,
+                uint32_t size, bool vis_output);
+
+        /**
+         * Take an idle memory system for the configuration or create a new one
+         * @param dram_conf     DRAM configuration file
+         * @param system_conf   System configuration file
+         * @param trace         Trace name for the output files
+         * @param size          Size in MiB
+         * @param vis_output    Write the DRAMSim2 visualization file
+         * @return Memory system at cycle zero
+         */
+        static DRAMSim::MultiChannelMemorySystem* acquire(const std::string &dram_conf, const std::string &system_conf,
+                const std::string &trace, uint32_t size, bool vis_output);
+
+        /**
+         * Close the output files of a memory system and return it to the pool
+         * @param key           Configuration key of the memory system
+         * @param dram_interface Memory system
+         */
+        static void release(const std::string &key, DRAMSim::MultiChannelMemorySystem *dram_interface);
+
+    };
+
+    /**
+     * Cycle-accurate DRAMSim2 backend
+     */
+    class DRAMSimBackend : public DRAMBackend {
+
+    private:
+
+        /** DRAM configuration file */
+        const std::string DRAM_CONF;
+
+        /** Compute frequency */
+        const uint64_t CLOCK_FREQ;
+
+        /** Memory system */
+        DRAMSim::MultiChannelMemorySystem *dram_interface;
+
+        /** Configuration key of the memory system in the pool */
+        std::string dram_key;
+
+        /** Read transactions callback */
+        DRAMSim::TransactionCompleteCB *read_cb;
+
+        /** Write transactions callback */
+        DRAMSim::TransactionCompleteCB *write_cb;
+
+        /** Cycles the memory system can stay idle before it has to be simulated again */
+        uint64_t idle_cycles = 0;
+
+        /** Idle cycles not yet applied to the memory system */
+        uint64_t skipped_cycles = 0;
+
+        /** Apply the skipped idle cycles to the memory system before interacting with it */
+        void catch_up();
+
+        /**
+         * Callback function for read address from DRAMSim2
+         * @param id            Channel id
+         * @param address       Address requested
+         * @param _clock_cycle  Arrival clock cycle
+         */
+        void read_transaction_done(unsigned id, uint64_t address, uint64_t _clock_cycle);
+
+        /**
+         * Callback function for write address from DRAMSim2
+         * @param id            Channel id
+         * @param address       Address requested
+         * @param _clock_cycle  Arrival clock cycle
+         */
+        void write_transaction_done(unsigned id, uint64_t address, uint64_t _clock_cycle);
+
+    public:
+
+        /**
+         * Constructor
+         * @param _read_done    Read transactions callback
+         * @param _write_done   Write transactions callback
+         * @param _dram_conf    DRAM configuration file
+         * @param _system_conf  System configuration file
+         * @param _trace        Trace name for the output files
+         * @param _SIZE         Size in MiB
+         * @param _clock_freq   Compute frequency
+         * @param _vis_output   Write the DRAMSim2 visualization file
+         */
+        DRAMSimBackend(const TransactionDone &_read_done, const TransactionDone &_write_done,
+                const std::string &_dram_conf, const std::string &_system_conf, const std::string &_trace,
+                uint32_t _SIZE, uint64_t _clock_freq, bool _vis_output);
+
+        /** Destructor: return the memory system to the pool */
+        ~DRAMSimBackend() override;
+
+        /**
+         * Return the description of the backend
+         * @return Description
+         */
+        std::string name() override;
+
+        /**
+         * Check if the memory system can receive a new transaction
+         * @return True if a new transaction is accepted
+         */
+        bool will_accept_transaction() override;
+
+        /**
+         * Send a transaction to the memory system
+         * @param address Address requested
+         * @param isWrite Transaction type: True = Write, False = Read
+         */
+        void add_transaction(uint64_t address, bool isWrite) override;
+
+        /** Update the memory system one cycle, idle cycles are skipped in a single step */
+        void cycle() override;
+
+        /**
+         * Return the DRAM clock cycles per compute cycle
+         * @return DRAM cycles per compute cycle
+         */
+        double memory_cycles_per_cycle() override;
+
+    };
+
+}
+
+#endif //DNNSIM_DRAMSIM_BACKEND_H
@@ -5,12 +5,23 @@
 
 namespace core {
 
+    /**
+     * First In First Out eviction policy
+     * The addresses are kept in a ring buffer that grows up to the bank size, so accesses do not allocate once the
+     * bank is full.
+     */
     class FIFO : public EvictionPolicy {
 
     private:
 
-        /** FIFO eviction queue */
-        std::queue<uint64_t> fifo;
+        /** FIFO eviction ring buffer */
+        std::vector<uint64_t> fifo;
+
+        /** Position of the oldest address in the ring buffer */
+        uint64_t first = 0;
+
+        /** Number of addresses tracked */
+        uint64_t size = 0;
 
         /**
          * Flush all the addresses
@@ -0,0 +1,69 @@
+#ifndef DNNSIM_FIXED_DRAM_H
+#define DNNSIM_FIXED_DRAM_H
+
+#include "DRAMBackend.h"
+
+namespace core {
+
+    /**
+     * Fixed latency and bandwidth DRAM backend
+     * Transactions are transferred in order through a single channel and complete a fixed latency after the transfer.
+     */
+    class FixedDRAM : public DRAMBackend {
+
+    private:
+
+        /** Cycles from the end of the transfer to the completion of a transaction */
+        const uint32_t LATENCY;
+
+        /** Transactions transferred per cycle */
+        const double BANDWIDTH;
+
+        /** Current cycle */
+        uint64_t now = 0;
+
+        /** Cycle when the channel can start the next transfer */
+        double channel_free = 0;
+
+        /** Transactions in flight in completion order: completion cycle, address, write */
+        std::queue<std::tuple<uint64_t, uint64_t, bool>> in_flight;
+
+    public:
+
+        /**
+         * Constructor
+         * @param _read_done    Read transactions callback
+         * @param _write_done   Write transactions callback
+         * @param _LATENCY      Transaction latency in cycles
+         * @param _BANDWIDTH    Transactions transferred per cycle
+         */
+        FixedDRAM(const TransactionDone &_read_done, const TransactionDone &_write_done, uint32_t _LATENCY,
+                double _BANDWIDTH) : DRAMBackend(_read_done, _write_done), LATENCY(_LATENCY), BANDWIDTH(_BANDWIDTH) {}
+
+        /**
+         * Return the description of the backend
+         * @return Description
+         */
+        std::string name() override;
+
+        /**
+         * Check if the backend can receive a new transaction
+         * @return True if a new transaction is accepted
+         */
+        bool will_accept_transaction() override;
+
+        /**
+         * Send a transaction to the backend
+         * @param address Address requested
+         * @param isWrite Transaction type: True = Write, False = Read
+         */
+        void add_transaction(uint64_t address, bool isWrite) override;
+
+        /** Update the backend one cycle */
+        void cycle() override;
+
+    };
+
+}
+
+#endif //DNNSIM_FIXED_DRAM_H
@@ -5,6 +5,8 @@
 #include "Memory.h"
 #include "FIFO.h"
 #include "LRU.h"
+#include "OPT.h"
+#include "BankCounters.h"
 
 namespace core {
 
@@ -76,6 +78,30 @@ namespace core {
         /** Weight eviction policy data per bank and level */
         std::vector<std::vector<std::shared_ptr<EvictionPolicy>>> wgt_eviction_policy;
 
+        /** Future activation accesses for the OPT eviction policy */
+        std::shared_ptr<NextUse> act_future;
+
+        /** Future partial sum and output activation accesses for the OPT eviction policy */
+        std::shared_ptr<NextUse> out_future;
+
+        /** Future weight accesses for the OPT eviction policy */
+        std::shared_ptr<NextUse> wgt_future;
+
+        /** Latest on-chip step requested */
+        std::shared_ptr<uint64_t> current_step;
+
+        /** Activation reads per level and bank of the current request */
+        BankCounters act_bank_reads;
+
+        /** Partial sum reads per level and bank of the current request */
+        BankCounters psum_bank_reads;
+
+        /** Weight reads per level and bank of the current request */
+        BankCounters wgt_bank_reads;
+
+        /** Output activation writes per level and bank of the current request */
+        BankCounters out_bank_writes;
+
         /** Partial sum banks ready cycle */
         uint64_t psum_read_ready_cycle = 0;
 
@@ -145,7 +171,9 @@ namespace core {
                 _wgt_addresses), ACT_LEVELS(_ACT_LEVELS), WGT_LEVELS(_WGT_LEVELS), ACT_BANKS(_ACT_OUT_BANKS/2),
                 WGT_BANKS(_WGT_BANKS), OUT_BANKS(_ACT_OUT_BANKS/2), ACT_BANK_WIDTH(_ACT_BANK_WIDTH),
                 WGT_BANK_WIDTH(_WGT_BANK_WIDTH), ACT_ADDRS_PER_ACCESS(ceil(ACT_BANK_WIDTH / (double)_DRAM_WIDTH)),
-                WGT_ADDRS_PER_ACCESS(ceil(WGT_BANK_WIDTH / (double)_DRAM_WIDTH)) {
+                WGT_ADDRS_PER_ACCESS(ceil(WGT_BANK_WIDTH / (double)_DRAM_WIDTH)),
+                act_bank_reads(ACT_LEVELS, ACT_BANKS), psum_bank_reads(ACT_LEVELS, OUT_BANKS),
+                wgt_bank_reads(WGT_LEVELS, WGT_BANKS), out_bank_writes(ACT_LEVELS, OUT_BANKS) {
 
             ACT_SIZE = _ACT_SIZE;
             WGT_SIZE = _WGT_SIZE;
@@ -155,6 +183,11 @@ namespace core {
             ACT_POLICY = _ACT_POLICY;
             WGT_POLICY = _WGT_POLICY;
 
+            act_future = std::make_shared<NextUse>();
+            out_future = std::make_shared<NextUse>();
+            wgt_future = std::make_shared<NextUse>();
+            current_step = std::make_shared<uint64_t>(0);
+
             act_eviction_policy = std::vector<std::vector<std::shared_ptr<EvictionPolicy>>>(ACT_LEVELS,
                     std::vector<std::shared_ptr<EvictionPolicy>>(ACT_BANKS, std::shared_ptr<EvictionPolicy>()));
 
@@ -166,6 +199,8 @@ namespace core {
                         act_eviction_policy[lvl][bank] = std::make_shared<LRU>(bank_size);
                     else if (_ACT_POLICY == "FIFO")
                         act_eviction_policy[lvl][bank] = std::make_shared<FIFO>(bank_size);
+                    else if (_ACT_POLICY == "OPT")
+                        act_eviction_policy[lvl][bank] = std::make_shared<OPT>(bank_size, act_future, current_step);
                     else throw std::runtime_error("Incorrect activation eviction policy");
                 }
             }
@@ -181,6 +216,8 @@ namespace core {
                         out_eviction_policy[lvl][bank] = std::make_shared<LRU>(bank_size);
                     else if (_ACT_POLICY == "FIFO")
                         out_eviction_policy[lvl][bank] = std::make_shared<FIFO>(bank_size);
+                    else if (_ACT_POLICY == "OPT")
+                        out_eviction_policy[lvl][bank] = std::make_shared<OPT>(bank_size, out_future, current_step);
                     else throw std::runtime_error("Incorrect activation eviction policy");                }
             }
 
@@ -195,6 +232,8 @@ namespace core {
                         wgt_eviction_policy[lvl][bank] = std::make_shared<LRU>(bank_size);
                     else if (_WGT_POLICY == "FIFO")
                         wgt_eviction_policy[lvl][bank] = std::make_shared<FIFO>(bank_size);
+                    else if (_WGT_POLICY == "OPT")
+                        wgt_eviction_policy[lvl][bank] = std::make_shared<OPT>(bank_size, wgt_future, current_step);
                     else throw std::runtime_error("Incorrect activation eviction policy");                }
             }
         }
@@ -326,6 +365,18 @@ namespace core {
          */
         void configure_layer() override;
 
+        /**
+         * Check if an eviction policy needs the on-chip steps before they are requested
+         * @return True if the steps have to be planned
+         */
+        bool lookahead() const;
+
+        /**
+         * Set the future accesses of the OPT eviction policies, replacing the previous plan
+         * @param steps On-chip steps in request order
+         */
+        void plan_steps(const std::vector<std::shared_ptr<TilesData<T>>> &steps);
+
         /**
          * Check if all the writes are done
          * @return True if writes done
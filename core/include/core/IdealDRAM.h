@@ -0,0 +1,54 @@
+#ifndef DNNSIM_IDEAL_DRAM_H
+#define DNNSIM_IDEAL_DRAM_H
+
+#include "DRAMBackend.h"
+
+namespace core {
+
+    /**
+     * Ideal DRAM backend: infinite bandwidth, every transaction completes in the next cycle
+     */
+    class IdealDRAM : public DRAMBackend {
+
+    private:
+
+        /** Transactions to complete in the next cycle */
+        std::vector<std::tuple<uint64_t, bool>> in_flight;
+
+    public:
+
+        /**
+         * Constructor
+         * @param _read_done    Read transactions callback
+         * @param _write_done   Write transactions callback
+         */
+        IdealDRAM(const TransactionDone &_read_done, const TransactionDone &_write_done) :
+                DRAMBackend(_read_done, _write_done) {}
+
+        /**
+         * Return the description of the backend
+         * @return Description
+         */
+        std::string name() override;
+
+        /**
+         * Check if the backend can receive a new transaction
+         * @return True if a new transaction is accepted
+         */
+        bool will_accept_transaction() override;
+
+        /**
+         * Send a transaction to the backend
+         * @param address Address requested
+         * @param isWrite Transaction type: True = Write, False = Read
+         */
+        void add_transaction(uint64_t address, bool isWrite) override;
+
+        /** Update the backend one cycle */
+        void cycle() override;
+
+    };
+
+}
+
+#endif //DNNSIM_IDEAL_DRAM_H
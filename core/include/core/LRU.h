@@ -2,18 +2,55 @@
 #define DNNSIM_LRU_H
 
 #include "EvictionPolicy.h"
+#include "AddressIndex.h"
 
 namespace core {
 
+    /**
+     * Least Recently Used eviction policy
+     * The addresses are kept in a doubly linked list of slot indices stored in flat arrays, ordered from the most to the
+     * least recently used, and found through an address index. Slots of evicted addresses are reused, so accesses do
+     * not allocate once the bank is full.
+     */
     class LRU : public EvictionPolicy {
 
     private:
 
-        /** Addresses eviction list */
-        std::list<uint64_t> data;
+        /** Address stored in each slot */
+        std::vector<uint64_t> addrs;
 
-        /** Least Recently Used tracking tree */
-        std::unordered_map<uint64_t, std::list<uint64_t>::iterator> lru;
+        /** Previous (more recently used) slot of each slot */
+        std::vector<uint32_t> prev;
+
+        /** Next (less recently used) slot of each slot, or next free slot */
+        std::vector<uint32_t> next;
+
+        /** Most recently used slot */
+        uint32_t head = NULL_SLOT;
+
+        /** Least recently used slot */
+        uint32_t tail = NULL_SLOT;
+
+        /** First free slot */
+        uint32_t free_slots = NULL_SLOT;
+
+        /** Number of addresses tracked */
+        uint64_t size = 0;
+
+        /** Slot of each address tracked */
+        AddressIndex lru;
+
+        /**
+         * Unlink a slot from the list
+         * @param slot Slot
+         */
+        void unlink(uint32_t slot);
+
+        /**
+         * Link a slot at the head of the list
+         * @param slot Slot
+         */
+        void push_front(uint32_t slot);
 
         /**
          * Flush all the addresses
@@ -0,0 +1,97 @@
+#ifndef DNNSIM_NEXT_USE_H
+#define DNNSIM_NEXT_USE_H
+
+#include "AddressIndex.h"
+
+namespace core {
+
+    /** Next use of the addresses that are not accessed again */
+    const uint64_t NEVER_USED = UINT64_MAX;
+
+    /**
+     * Future accesses of a set of on-chip steps
+     * The steps accessing each address are kept sorted in a flat array per address, so the next use of an address
+     * after a given step is a binary search.
+     */
+    class NextUse {
+
+    private:
+
+        /** Dense identifier of each address */
+        AddressIndex ids;
+
+        /** First position in the steps of each identifier, plus the end position */
+        std::vector<uint64_t> offsets;
+
+        /** Steps accessing each address, in order */
+        std::vector<uint64_t> steps;
+
+        /** Accesses added since the last build: address identifier and step */
+        std::vector<std::pair<uint32_t, uint64_t>> pending;
+
+        /** Number of identifiers */
+        uint32_t addresses = 0;
+
+    public:
+
+        /** Forget all the accesses */
+        void clear() {
+            ids.clear();
+            offsets.clear();
+            steps.clear();
+            pending.clear();
+            addresses = 0;
+        }
+
+        /**
+         * Add an access, steps must be added in order
+         * @param addr Memory address
+         * @param step On-chip step
+         */
+        void add(uint64_t addr, uint64_t step) {
+            auto id = ids.find(addr);
+            if (id == NULL_SLOT) {
+                id = addresses++;
+                ids.insert(addr, id);
+            }
+            pending.emplace_back(id, step);
+        }
+
+        /** Sort the added accesses per address */
+        void build() {
+            offsets = std::vector<uint64_t>(addresses + 1, 0);
+            for (const auto &access : pending)
+                offsets[access.first + 1]++;
+            for (uint32_t id = 0; id < addresses; ++id)
+                offsets[id + 1] += offsets[id];
+
+            steps = std::vector<uint64_t>(pending.size());
+            auto fill = std::vector<uint64_t>(offsets.begin(), offsets.end() - 1);
+            for (const auto &access : pending)
+                steps[fill[access.first]++] = access.second;
+
+            pending.clear();
+            pending.shrink_to_fit();
+        }
+
+        /**
+         * Return the first step accessing an address after the given step
+         * @param addr Memory address
+         * @param now  Current step
+         * @return Next step, NEVER_USED if not accessed again
+         */
+        uint64_t next(uint64_t addr, uint64_t now) const {
+            auto id = ids.find(addr);
+            if (id == NULL_SLOT || id + 1 >= offsets.size())
+                return NEVER_USED;
+            auto first = steps.begin() + offsets[id];
+            auto last = steps.begin() + offsets[id + 1];
+            auto it = std::upper_bound(first, last, now);
+            return it == last ? NEVER_USED : *it;
+        }
+
+    };
+
+}
+
+#endif //DNNSIM_NEXT_USE_H
@@ -0,0 +1,78 @@
+#ifndef DNNSIM_OPT_H
+#define DNNSIM_OPT_H
+
+#include "EvictionPolicy.h"
+#include "NextUse.h"
+
+namespace core {
+
+    /**
+     * Belady optimal eviction policy
+     * Evicts the address whose next use is the furthest in the planned on-chip steps. The next use of each address
+     * is cached when it is accessed and only computed again once the current step has reached it, so the eviction
+     * scan does not depend on the policy being notified of every access.
+     */
+    class OPT : public EvictionPolicy {
+
+    private:
+
+        /** Future accesses of the planned steps */
+        std::shared_ptr<NextUse> future;
+
+        /** Current on-chip step */
+        std::shared_ptr<uint64_t> now;
+
+        /** Addresses tracked */
+        std::vector<uint64_t> addrs;
+
+        /** Next use of each address tracked */
+        std::vector<uint64_t> next_uses;
+
+        /** Position of each address tracked */
+        AddressIndex positions;
+
+        /**
+         * Flush all the addresses
+         */
+        void flush() override;
+
+        /**
+         * Check if the bank is full
+         * @return False if full, True otherwise
+         */
+        bool free_entry() override;
+
+        /**
+         * Insert a new address in the eviction policy tracking
+         * @param addr Memory address
+         */
+        void insert_addr(uint64_t addr) override;
+
+        /**
+         * Remove an address from the eviction policy tracking
+         * @return Memory address evicted
+         */
+        uint64_t evict_addr() override;
+
+        /**
+         * Update the eviction policy tracking for the accessed address
+         * @param addr Memory address accessed
+         */
+        void update_status(uint64_t addr) override;
+
+    public:
+
+        /**
+         * Constructor
+         * @param _MAX_SIZE Maximum number of addresses
+         * @param _future   Future accesses of the planned steps
+         * @param _now      Current on-chip step
+         */
+        OPT(uint64_t _MAX_SIZE, const std::shared_ptr<NextUse> &_future, const std::shared_ptr<uint64_t> &_now) :
+                EvictionPolicy(_MAX_SIZE), future(_future), now(_now) {}
+
+    };
+
+}
+
+#endif //DNNSIM_OPT_H
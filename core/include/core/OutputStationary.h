@@ -66,6 +66,9 @@ namespace core {
         /** Activation Addresses map */
         AddressMap act_address_map;
 
+        /** Addresses of all the activations of the layer */
+        std::vector<AddressRange> act_layer_addresses;
+
         /** Window Bank buffer */
         BankBufferSet window_bank_buffer;
 
@@ -167,6 +170,14 @@ namespace core {
          */
         void generate_memory_maps() override;
 
+        /**
+         * Return the weights read by an off-chip access of a weight buffer row
+         * @param row       Weight buffer row
+         * @param access    Access of the row: filter first, then block of lanes
+         * @return Weights of the access
+         */
+        std::vector<T> weight_block(const BufferRow<T> &row, uint64_t access);
+
         /**
          * Fill the weight buffer with the weights
          */
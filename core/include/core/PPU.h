@@ -20,17 +20,24 @@ namespace core {
         /** Processing delay per step */
         const uint32_t DELAY;
 
+        /** Process the outputs as they are produced instead of after each on-chip stage */
+        const bool STREAM;
+
         /** Global cycle */
         std::shared_ptr<uint64_t> global_cycle;
 
+        /** Cycle when the streamed outputs are processed */
+        uint64_t ready_cycle = 0;
+
     public:
 
         /**
          * Constructor
          * @param _INPUTS Concurrent inputs
          * @param _DELAY Processing delay per step
+         * @param _STREAM Process the outputs as they are produced instead of after each on-chip stage
          */
-        PPU(uint32_t _INPUTS, uint32_t _DELAY) : INPUTS(_INPUTS), DELAY(_DELAY) {}
+        PPU(uint32_t _INPUTS, uint32_t _DELAY, bool _STREAM) : INPUTS(_INPUTS), DELAY(_DELAY), STREAM(_STREAM) {}
 
         /**
          * Return stats header for the Post-Processing Unit
@@ -52,6 +59,24 @@ namespace core {
          */
         void calculate_delay(uint64_t outputs);
 
+        /** Configure the Post-Processing Unit for a new layer */
+        void configure_layer();
+
+        /**
+         * Return True if the outputs are processed as they are produced
+         * @return True if stream
+         */
+        bool stream() const;
+
+        /**
+         * Process outputs in the background, after the outputs streamed before
+         * @param outputs Outputs produced
+         */
+        void stream_outputs(uint64_t outputs);
+
+        /** Wait until all the streamed outputs are processed */
+        void wait_outputs();
+
     };
 
 }
@@ -0,0 +1,224 @@
+#ifndef DNNSIM_REPLAY_H
+#define DNNSIM_REPLAY_H
+
+#include "Architecture.h"
+
+namespace core {
+
+    /**
+     * Memory trace of one off-chip stage
+     * @tparam T Data type values
+     */
+    template <typename T>
+    class NodeTrace {
+    public:
+
+        /** True if evict previous activations from on-chip */
+        bool evict_act = false;
+
+        /** True if evict previous output activations and partial sums from on-chip */
+        bool evict_out = false;
+
+        /** True if evict previous weights from on-chip */
+        bool evict_wgt = false;
+
+        /** True if activations already on-chip */
+        bool layer_act_on_chip = false;
+
+        /** Activation addresses to read */
+        std::vector<AddressRange> read_act_addresses;
+
+        /** Partial sum addresses to read */
+        std::vector<AddressRange> read_psum_addresses;
+
+        /** Weight addresses to read */
+        std::vector<AddressRange> read_wgt_addresses;
+
+        /** Output activation addresses to write */
+        std::vector<AddressRange> write_addresses;
+
+        /** On-chip steps with their addresses and banks, without the values */
+        std::vector<std::shared_ptr<TilesData<T>>> steps;
+
+        /** Outputs sent to the post-processing unit */
+        uint64_t outputs = 0;
+
+        /**
+         * Record an on-chip step, keeping only the addresses, banks and number of windows and filters per tile
+         * @param tiles_data Processing information for all the tiles
+         */
+        void record_step(const TilesData<T> &tiles_data);
+
+    };
+
+    /**
+     * Memory trace of one layer
+     * @tparam T Data type values
+     */
+    template <typename T>
+    class LayerTrace {
+    public:
+
+        /** True if the layer went through the on-chip pipeline */
+        bool pipelined = false;
+
+        /** True if signed activations */
+        bool signed_act = false;
+
+        /** True if signed weights */
+        bool signed_wgt = false;
+
+        /** Activations precision */
+        uint32_t act_prec = 0;
+
+        /** Weights precision */
+        uint32_t wgt_prec = 0;
+
+        /** Linear layer */
+        bool linear = false;
+
+        /** RNN layer */
+        bool rnn = false;
+
+        /** Stride of the layer */
+        int stride = 0;
+
+        /** Off-chip stages in order */
+        std::vector<NodeTrace<T>> nodes;
+
+        /** Ready and done delays of the architecture for each processed step, relative to the issue cycle */
+        std::vector<std::pair<uint64_t, uint64_t>> delays;
+
+        /** Compute cycles of the architecture */
+        uint64_t compute_cycles = 0;
+
+        /** Scheduled PEs */
+        uint64_t scheduled_pe = 0;
+
+        /** Idle PEs */
+        uint64_t idle_pe = 0;
+
+    };
+
+    /**
+     * Memory trace of a network
+     * @tparam T Data type values
+     */
+    template <typename T>
+    class MemoryTrace {
+    public:
+
+        /** Layer traces: samples x layers */
+        std::vector<std::vector<LayerTrace<T>>> layers;
+
+        /** Number of times the trace has been replayed */
+        uint64_t replays = 0;
+
+    };
+
+    /**
+     * Architecture that replays the compute delays recorded in a memory trace
+     * The delays are relative to the cycle each step is issued, so the architecture timing is exact when the
+     * recorded architecture does not depend on the absolute cycle, and approximate otherwise.
+     * @tparam T Data type values
+     */
+    template <typename T>
+    class Replay : public Architecture<T> {
+
+    private:
+
+        /** Architecture that generated the trace */
+        std::shared_ptr<Architecture<T>> arch;
+
+        /** Trace of the current layer */
+        const LayerTrace<T> *trace = nullptr;
+
+        /** Next step to replay */
+        uint64_t step = 0;
+
+        /* AUXILIARY FUNCTIONS */
+
+        /**
+         * Return name of the class
+         * @return Name
+         */
+        std::string name() override;
+
+        /* CYCLES */
+
+        /**
+         * Return stats filename for the architecture in the cycles function
+         * @return Filename
+         */
+        std::string filename() override;
+
+        /**
+         * Return stats header for the architecture in the cycles function
+         * @return Header
+         */
+        std::string header() override;
+
+        /**
+         * Return if calculate deltas for the window buffer
+         * @return True if diffy, False if not
+         */
+        bool diffy() override;
+
+        /**
+         * Return if schedule the weight buffer
+         * @return True if weight buffer to schedule, False if not
+         */
+        bool schedule() override;
+
+        /**
+         * Replay the recorded delays for the next step
+         * @param tiles_data Processing information for all the tiles
+         */
+        void process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) override;
+
+        /* POTENTIALS */
+
+        /**
+         * Return stats filename for the architecture in the potentials function
+         * @return Filename
+         */
+        std::string filename_pot() override;
+
+        /**
+         * Return stats header for the architecture in the potentials function
+         * @return Header
+         */
+        std::string header_pot() override;
+
+        /** Compute number of one bit multiplications given a weights and an activation
+         * @param act           Activation
+         * @param wgt           Weight
+         * @return              Number of one bit multiplications
+         */
+        uint16_t computeBits(T act, T wgt) override;
+
+    public:
+
+        /** Constructor
+         * @param _arch Architecture that generated the trace
+         */
+        explicit Replay(const std::shared_ptr<Architecture<T>> &_arch) : Architecture<T>(_arch->getLanes(),
+                _arch->getColumns(), _arch->getRows(), _arch->getTiles(), _arch->getPeWidth()), arch(_arch) {}
+
+        /**
+         * Set the trace of the layer to replay, after configuring the layer
+         * @param _trace Layer trace
+         */
+        void replay_layer(const LayerTrace<T> &_trace);
+
+        /**
+         * Return the recorded compute cycles
+         * @return Cycles
+         */
+        uint64_t getCycles() const override;
+
+    };
+
+}
+
+#endif //DNNSIM_REPLAY_H
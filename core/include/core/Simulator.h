@@ -14,6 +14,7 @@
 #include "DRAM.h"
 #include "GlobalBuffer.h"
 #include "BitTactical.h"
+#include "Replay.h"
 #include "Utils.h"
 
 namespace core {
@@ -131,6 +132,38 @@ namespace core {
         /** Check the correctness of the simulations */
         const bool CHECK = false;
 
+        /** Stop simulating samples when the per-layer cycles are within this relative error (0 to disable) */
+        const double ADAPTIVE_ERROR = 0;
+
+        /** Confidence level for the adaptive number of samples */
+        const double ADAPTIVE_CONFIDENCE = 0.95;
+
+        /**
+         * Return the relative half-width of the confidence interval of the mean
+         * @param values Values of the samples simulated so far
+         * @return Half-width divided by the mean
+         */
+        double relative_interval(const std::vector<double> &values);
+
+        /**
+         * Advance the on-chip pipeline of one architecture by one cycle
+         * @param pipeline          Pipeline of the architecture
+         * @param control           Control of the architecture
+         * @param layer_act_on_chip True if the layer activations are already on-chip
+         * @param trace             Layer trace where to record the compute delays (nullptr to not record)
+         */
+        void cycle_pipeline(Pipeline<T> &pipeline, const std::shared_ptr<Control<T>> &control,
+                bool layer_act_on_chip, LayerTrace<T> *trace = nullptr);
+
+        /**
+         * Advance the time of one architecture over the window-filter sets skipped by the sampling. The off-chip memory
+         * keeps running while busy and the rest of the time is skipped at once. The pipeline keeps the end of the
+         * previous set, which the next simulated set overlaps as it would overlap the skipped sets.
+         * @param control Control of the architecture
+         * @param sets    Number of skipped sets
+         */
+        void skip_sets(const std::shared_ptr<Control<T>> &control, uint64_t sets);
+
     public:
 
         /** Constructor
@@ -140,12 +173,43 @@ namespace core {
          */
         Simulator(bool _FAST_MODE, bool _QUIET, bool _CHECK) : FAST_MODE(_FAST_MODE), QUIET(_QUIET), CHECK(_CHECK) {}
 
+        /** Constructor
+         * @param _FAST_MODE            Enable fast mode to simulate only one sample
+         * @param _QUIET                Avoid std::out messages
+         * @param _CHECK                Check the correctness of the simulations
+         * @param _ADAPTIVE_ERROR       Relative error to stop simulating samples (0 to simulate all)
+         * @param _ADAPTIVE_CONFIDENCE  Confidence level for the relative error
+         */
+        Simulator(bool _FAST_MODE, bool _QUIET, bool _CHECK, double _ADAPTIVE_ERROR, double _ADAPTIVE_CONFIDENCE) :
+                FAST_MODE(_FAST_MODE), QUIET(_QUIET), CHECK(_CHECK), ADAPTIVE_ERROR(_ADAPTIVE_ERROR),
+                ADAPTIVE_CONFIDENCE(_ADAPTIVE_CONFIDENCE) {}
+
         /** Simulate architecture for the given network
         * @param network   Network we want to calculate work reduction
         * @param control
         */
         void run(const base::Network<T> &network, const std::shared_ptr<Control<T>> &control);
 
+        /** Simulate several architectures for the given network sharing a single dataflow traversal
+         * The first control generates the on-chip steps and the off-chip nodes, the rest replay them in their own
+         * memory hierarchy and architecture. All controls must use the same dataflow and the same array dimensions.
+         * @param network   Network we want to calculate work reduction
+         * @param controls  Controls of the architectures to simulate
+         * @param trace     Memory trace where to record the simulation (nullptr to not record), only for one control
+         */
+        void run(const base::Network<T> &network, const std::vector<std::shared_ptr<Control<T>>> &controls,
+                const std::shared_ptr<MemoryTrace<T>> &trace = nullptr);
+
+        /** Simulate only the memory system for the given network replaying a recorded memory trace
+         * The DRAM, global buffer and local buffers of the control are simulated with the recorded steps and
+         * compute delays, so the architecture and the dataflow are not simulated again.
+         * @param network   Network we want to calculate work reduction
+         * @param control   Control with the memory system to simulate and the architecture that was recorded
+         * @param trace     Memory trace recorded with the same architecture and dataflow parameters
+         */
+        void replay(const base::Network<T> &network, const std::shared_ptr<Control<T>> &control,
+                const std::shared_ptr<MemoryTrace<T>> &trace);
+
         /** Calculate potentials for the given network
          * @param network   Network we want to calculate work reduction
          * @param arch      Pointer to the architecture to simulate
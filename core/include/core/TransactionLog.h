@@ -0,0 +1,135 @@
+#ifndef DNNSIM_TRANSACTION_LOG_H
+#define DNNSIM_TRANSACTION_LOG_H
+
+#include "Utils.h"
+#include <deque>
+
+namespace core {
+
+    /**
+     * Binary log of the DRAM transaction stream with the latency of each transaction
+     * The transactions are recorded in request order with the cycles since the previous request. When the log file
+     * was recorded with the same memory configuration, the recorded latencies are replayed as long as the requested
+     * transactions and their request cycles match the recorded stream, so the replayed latencies are the simulated
+     * ones. After the first mismatch the timing model simulates the rest of the transactions without the state left
+     * by the replayed ones, so the timing from that point is approximate, and the log is removed to be recorded
+     * again by the next simulation. The log is streamed from and to the file. A file recorded with another memory
+     * configuration is never overwritten.
+     * File format: magic, configuration key length and key, and for each transaction the address with the write
+     * flag in the top bit, the cycles since the previous request and the latency (UINT32_MAX if never completed).
+     */
+    class TransactionLog {
+
+    private:
+
+        /** Transaction of the stream */
+        struct Transaction {
+
+            /** Address with the write flag in the top bit */
+            uint64_t address = 0;
+
+            /** Cycles since the previous request */
+            uint64_t delta = 0;
+
+            /** Latency, UINT32_MAX if never completed */
+            uint32_t latency = UINT32_MAX;
+
+        };
+
+        /** Log file */
+        const std::string PATH;
+
+        /** Memory configuration key */
+        const std::string KEY;
+
+        /** Temporary file where the transaction stream is recorded */
+        std::string record_path;
+
+        /** Recorded transaction stream */
+        std::ofstream record_file;
+
+        /** Replayed transaction stream */
+        std::ifstream replay_file;
+
+        /** Next transaction of the replayed stream */
+        Transaction next;
+
+        /** True if there is a next transaction in the replayed stream */
+        bool has_next = false;
+
+        /** Transactions requested and not recorded yet, in request order */
+        std::deque<Transaction> pending;
+
+        /** Sequence number of the first pending transaction */
+        uint64_t first_pending = 0;
+
+        /** Transactions requested */
+        uint64_t transactions = 0;
+
+        /** Cycle of the last transaction request */
+        uint64_t last_request = 0;
+
+        /** Transactions in flight per address and type: sequence number and request cycle, in request order */
+        std::unordered_map<uint64_t, std::deque<std::pair<uint64_t, uint64_t>>> in_flight;
+
+        /** True while the requested transactions match the recorded stream */
+        bool replaying = false;
+
+        /** True if the requested transactions stopped matching the recorded stream */
+        bool diverged = false;
+
+        /**
+         * Return the address with the write flag in the top bit
+         * @param address Address requested
+         * @param isWrite Transaction type: True = Write, False = Read
+         * @return Tagged address
+         */
+        static uint64_t tag(uint64_t address, bool isWrite);
+
+        /** Read the next transaction of the replayed stream */
+        void read_next();
+
+        /** Write the completed transactions at the head of the pending transactions */
+        void write_completed();
+
+    public:
+
+        /**
+         * Constructor
+         * @param _PATH Log file
+         * @param _KEY  Memory configuration key
+         */
+        TransactionLog(const std::string &_PATH, const std::string &_KEY);
+
+        /** Destructor: write the log file if the stream changed, or remove it if the transactions diverged */
+        ~TransactionLog();
+
+        /**
+         * Record a new transaction request
+         * @param address   Address requested
+         * @param isWrite   Transaction type: True = Write, False = Read
+         * @param cycle     Request cycle
+         * @param latency   Recorded latency if the transaction is replayed
+         * @return True if the recorded latency can be replayed, False if the transaction has to be simulated
+         */
+        bool request(uint64_t address, bool isWrite, uint64_t cycle, uint32_t &latency);
+
+        /**
+         * Check if the requested transactions still match the recorded stream
+         * @return True while the recorded latencies are replayed
+         */
+        bool matching() const;
+
+        /**
+         * Record the completion of the oldest transaction in flight for an address
+         * @param address   Address requested
+         * @param isWrite   Transaction type: True = Write, False = Read
+         * @param cycle     Completion cycle
+         */
+        void complete(uint64_t address, bool isWrite, uint64_t cycle);
+
+    };
+
+}
+
+#endif //DNNSIM_TRANSACTION_LOG_H
@@ -73,16 +73,16 @@ namespace core {
         /** 1D Output activations mapped addresses */
         AddressBufferRow out_addresses;
 
-        /** 2D Input activation mapped on-chip banks */
+        /** 2D Input activation mapped on-chip bank slots, interleaved over the activation banks */
         BankBufferSet act_banks;
 
-        /** 1D Partial sum mapped on-chip banks */
+        /** 1D Partial sum mapped on-chip bank slots, interleaved over the output banks */
         BankBufferRow psum_banks;
 
-        /** 1D Weight mapped on-chip banks */
+        /** 1D Weight mapped on-chip bank slots, interleaved over the weight banks */
         BankBufferRow wgt_banks;
 
-        /** 1D Output activation mapped on-chip banks */
+        /** 1D Output activation mapped on-chip bank slots, interleaved over the output banks */
         BankBufferRow out_banks;
 
         /** Current time in the 2D input buffer (for Tactical) */
@@ -115,6 +115,18 @@ namespace core {
         /** Read weights flag */
         bool read_wgt = false;
 
+        /** Position of the on-chip step in the layer */
+        uint64_t step = 0;
+
+        /** True if first on-chip step of a simulated window-filter set when sampling */
+        bool set_start = false;
+
+        /** True if the set started by this step is measured */
+        bool set_measured = false;
+
+        /** True if the set started by this step only warms up the pipeline, its cycles are extrapolated */
+        bool set_warm = false;
+
         /**
          * Constructor
          * @param _tiles Total number of tiles
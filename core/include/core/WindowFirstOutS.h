@@ -14,12 +14,206 @@ namespace core {
 
     private:
 
+        /** On-chip sizes of the data of a convolutional layer for each memory policy */
+        struct ConvSizes {
+
+            /** Size of all the input activations */
+            uint64_t all_input_size = 0;
+
+            /** Size of the input activations of one window set */
+            uint64_t subset_windows_size = 0;
+
+            /** Size of one buffer row of input activations */
+            uint64_t row_input_size = 0;
+
+            /** Size of all the filters */
+            uint64_t all_filters_size = 0;
+
+            /** Number of filters in one filter set */
+            uint32_t subset_filters = 0;
+
+            /** Size of one filter set */
+            uint64_t subset_filters_size = 0;
+
+            /** Size of one buffer row of filters */
+            uint64_t row_filter_size = 0;
+
+            /** Size of all the output activations */
+            uint64_t all_output_size = 0;
+
+            /** Size of the output activations of one filter set */
+            uint64_t subset_filters_output_size = 0;
+
+            /** Size of the output activations of one window set */
+            uint64_t subset_windows_output_size = 0;
+
+            /** Size of the output activations of one window set and one filter set */
+            uint64_t subsets_output_size = 0;
+
+            /** Number of filter sets */
+            uint32_t total_filter_sets = 0;
+
+        };
+
+        /** Memory policies and tiling of a convolutional layer */
+        struct ConvMapping {
+
+            /** Activation memory policy */
+            MemPolicy act_policy = ALL;
+
+            /** Weight memory policy */
+            MemPolicy wgt_policy = ALL;
+
+            /** Maximum filter sets per filter step allowed */
+            uint32_t max_filter_sets_per_step = UINT32_MAX;
+
+            /** Filter sets per filter step */
+            uint32_t filter_sets_per_step = 0;
+
+            /** Number of filter steps */
+            uint32_t filter_steps = 0;
+
+            /** Window sets of each window step */
+            std::vector<std::vector<int>> window_steps;
+
+            /** Number of time steps */
+            uint32_t time_steps = 1;
+
+            /** Buffer time per time step */
+            uint32_t max_time_per_step = 0;
+
+            /** True if the mapping keeps the invariants of its policies, only searched candidates may break them */
+            bool valid = true;
+
+            /** Estimated DRAM traffic in bytes */
+            uint64_t dram_traffic = 0;
+
+            /** Number of off-chip stages */
+            uint64_t nodes = 0;
+
+        };
+
+        /** Search the memory policies and tiling of convolutional layers instead of taking the first that fits */
+        const bool MAPPING_SEARCH = false;
+
+        /** Memory policies and tiling of the current layer */
+        std::string mapping = "-";
+
+        /** Estimated DRAM traffic of the mapping of the current layer */
+        uint64_t mapping_traffic = 0;
+
+        /** Window-filter set sampling: None, Random, Stratified */
+        const std::string SAMPLING = "None";
+
+        /** Fraction of window-filter sets simulated when sampling */
+        const double SAMPLING_RATE = 1.0;
+
+        /** Confidence level for the extrapolated cycles */
+        const double SAMPLING_CONFIDENCE = 0.95;
+
+        /** Random generator for the sampled sets */
+        std::mt19937 generator;
+
+        /** Measured window-filter sets of the current layer per group, window set, and filter tile set */
+        std::vector<bool> sampled_sets;
+
+        /** Sets simulated without measuring them, to warm up the pipeline before a sampled set after skipped ones */
+        std::vector<bool> warm_sets;
+
+        /** Window sets of the current layer per group with at least one simulated filter set */
+        std::vector<bool> sampled_windows;
+
+        /** Number of filter tile sets per window set of the current layer */
+        uint64_t tile_sets_per_window = 0;
+
+        /** True until the first step of the current simulated set is returned */
+        bool new_set = false;
+
+        /** True if the current simulated set is measured */
+        bool measured_set = false;
+
+        /** True if the current simulated set only warms up the pipeline */
+        bool warm_set = false;
+
+        /** True once a set of the current node is simulated. The first set always is, as it waits for the node reads */
+        bool node_set_simulated = false;
+
+        /**
+         * Choose the simulated window-filter sets of the current layer. Every set keeps the same choice in all the
+         * off-chip nodes and time steps of the layer, so the partial sums of a simulated set are always produced.
+         * A sampled set after skipped ones is preceded by a warm-up set, so it is measured with the pipeline as full
+         * as in the complete simulation.
+         */
+        void sample_window_filter_sets();
+
+        /**
+         * Return if a window-filter set of the current layer is simulated, and count the visit. The first set of
+         * every node is simulated, measured only if sampled.
+         * @param group_idx     Group index
+         * @param window_set    Window set index
+         * @param filter_set    First filter set of the tiles
+         * @return True if simulated, False if skipped
+         */
+        bool sample_window_filter_set(uint64_t group_idx, uint64_t window_set, uint64_t filter_set);
+
         /**
          * Return name for the dataflow
          * @return Name of the dataflow
          */
         std::string dataflow() override;
 
+        /**
+         * Return the on-chip sizes of the data of the current convolutional layer
+         * @return Data sizes
+         */
+        ConvSizes conv_sizes();
+
+        /**
+         * Check if the activation memory policy fits in the global buffer
+         * @param sizes         Data sizes of the layer
+         * @param act_policy    Activation memory policy
+         * @return True if it fits
+         */
+        bool act_policy_fits(const ConvSizes &sizes, MemPolicy act_policy);
+
+        /**
+         * Check if the weight memory policy fits in the global buffer
+         * @param sizes         Data sizes of the layer
+         * @param wgt_policy    Weight memory policy
+         * @return True if it fits
+         */
+        bool wgt_policy_fits(const ConvSizes &sizes, MemPolicy wgt_policy);
+
+        /**
+         * Compute the tiling of a convolutional layer for the memory policies of the mapping
+         * @param sizes     Data sizes of the layer
+         * @param mapping   Mapping with the memory policies and the maximum filter sets per step (Overwritten)
+         */
+        void map_conv_layer(const ConvSizes &sizes, ConvMapping &mapping);
+
+        /**
+         * Estimate the DRAM traffic and off-chip stages of a convolutional layer mapping
+         * @param sizes     Data sizes of the layer
+         * @param mapping   Mapping to estimate (Overwritten)
+         */
+        void estimate_conv_mapping(const ConvSizes &sizes, ConvMapping &mapping);
+
+        /**
+         * Search the mapping of a convolutional layer with the least estimated DRAM traffic, and the least off-chip
+         * stages for the same traffic. Candidates are all the memory policies that fit, with the filter sets per
+         * step halved down to one. The loop order is fixed by the window first dataflow.
+         * @param sizes Data sizes of the layer
+         * @return Best mapping
+         */
+        ConvMapping search_conv_mapping(const ConvSizes &sizes);
+
+        /**
+         * Return the description of a convolutional layer mapping
+         * @param mapping   Mapping to describe
+         * @return Memory policies, filter sets per step, window steps, and time steps
+         */
+        static std::string describe_conv_mapping(const ConvMapping &mapping);
+
         /**
          * Generate execution graph for convolutional layers
          */
@@ -75,6 +269,48 @@ namespace core {
 
     public:
 
+        /**
+         * Return True if the dataflow only simulates a sample of the window-filter sets
+         * @return True if sampling
+         */
+        bool sampling() const override;
+
+        /**
+         * Return the number of cycles for the current layer extrapolated from the sampled window-filter sets
+         * @return Estimated cycles
+         */
+        double getEstimatedCycles() const override;
+
+        /**
+         * Return the half-width of the confidence interval for the estimated cycles
+         * @return Confidence interval half-width
+         */
+        double getEstimatedCyclesInterval() const override;
+
+        /**
+         * Return the fraction of window-filter set visits simulated in the current layer
+         * @return Simulated fraction
+         */
+        double getSimulatedFraction() const override;
+
+        /**
+         * Return True if the dataflow searches the mapping of each layer
+         * @return True if mapping search
+         */
+        bool mapping_search() const override;
+
+        /**
+         * Return the memory policies and tiling chosen for the current layer
+         * @return Mapping description
+         */
+        std::string getMapping() const override;
+
+        /**
+         * Return the estimated DRAM traffic in bytes of the mapping chosen for the current layer
+         * @return Estimated DRAM traffic
+         */
+        uint64_t getMappingTraffic() const override;
+
         /**
          * Constructor
          * @param _scheduler    Weight buffer scheduler
@@ -94,6 +330,31 @@ namespace core {
                 const std::shared_ptr<PPU<T>> &_ppu) : OutputStationary<T>(_scheduler, _dram, _gbuffer, _abuffer,
                 _pbuffer, _wbuffer, _obuffer, _composer, _ppu) {}
 
+        /**
+         * Constructor
+         * @param _scheduler            Weight buffer scheduler
+         * @param _dram                 Dram model
+         * @param _gbuffer              Global Buffer model
+         * @param _abuffer              Activation Buffer model
+         * @param _pbuffer              Weight Buffer model
+         * @param _wbuffer              Partial Sum Buffer model
+         * @param _obuffer              Output Buffer model
+         * @param _composer             Composer column model
+         * @param _ppu                  Post-Processing Unit model
+         * @param _SAMPLING             Window-filter set sampling: None, Random, Stratified
+         * @param _SAMPLING_RATE        Fraction of window-filter sets simulated
+         * @param _SAMPLING_CONFIDENCE  Confidence level for the extrapolated cycles
+         * @param _MAPPING_SEARCH       Search the memory policies and tiling of convolutional layers
+         */
+        WindowFirstOutS(const std::shared_ptr<BitTactical<T>> &_scheduler, const std::shared_ptr<DRAM<T>> &_dram,
+                const std::shared_ptr<GlobalBuffer<T>> &_gbuffer, const std::shared_ptr<LocalBuffer<T>> &_abuffer,
+                const std::shared_ptr<LocalBuffer<T>> &_pbuffer, const std::shared_ptr<LocalBuffer<T>> &_wbuffer,
+                const std::shared_ptr<LocalBuffer<T>> &_obuffer, const std::shared_ptr<Composer<T>> &_composer,
+                const std::shared_ptr<PPU<T>> &_ppu, const std::string &_SAMPLING, double _SAMPLING_RATE,
+                double _SAMPLING_CONFIDENCE, bool _MAPPING_SEARCH) : OutputStationary<T>(_scheduler, _dram, _gbuffer,
+                _abuffer, _pbuffer, _wbuffer, _obuffer, _composer, _ppu), MAPPING_SEARCH(_MAPPING_SEARCH),
+                SAMPLING(_SAMPLING), SAMPLING_RATE(_SAMPLING_RATE), SAMPLING_CONFIDENCE(_SAMPLING_CONFIDENCE) {}
+
     };
 
 }
@@ -0,0 +1,43 @@
+
+#include <core/BankDRAM.h>
+
+namespace core {
+
+    std::string BankDRAM::name() {
+        return "Bank latency " + std::to_string(LATENCY) + " cycles, bandwidth " + std::to_string(BANDWIDTH) +
+                " transactions per cycle, row miss " + std::to_string(ROW_MISS_LATENCY) + " cycles, " +
+                std::to_string(BANKS) + " banks of " + std::to_string(ROW_SIZE) + " bytes rows";
+    }
+
+    bool BankDRAM::will_accept_transaction() {
+        return true;
+    }
+
+    void BankDRAM::add_transaction(uint64_t address, bool isWrite) {
+        auto row_id = address / ROW_SIZE;
+        auto bank = row_id % BANKS;
+        auto row = row_id / BANKS;
+
+        auto ready = std::max((double)now, bank_free[bank]);
+        if (open_row[bank] != row) {
+            ready += ROW_MISS_LATENCY;
+            open_row[bank] = row;
+        }
+
+        auto start = std::max(ready, channel_free);
+        channel_free = start + 1. / BANDWIDTH;
+        bank_free[bank] = channel_free;
+        in_flight.emplace((uint64_t)ceil(channel_free) + LATENCY, sent++, address, isWrite);
+    }
+
+    void BankDRAM::cycle() {
+        now++;
+        while (!in_flight.empty() && std::get<0>(in_flight.top()) <= now) {
+            auto transaction = in_flight.top();
+            in_flight.pop();
+            if (std::get<3>(transaction)) write_done(std::get<2>(transaction));
+            else read_done(std::get<2>(transaction));
+        }
+    }
+
+}
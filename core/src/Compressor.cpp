@@ -0,0 +1,92 @@
+
+#include <core/Compressor.h>
+
+namespace core {
+
+    template <typename T>
+    uint64_t Compressor<T>::zero_rle_bits(const std::vector<T> &values, uint32_t data_size) const {
+        const uint64_t MAX_RUN = (1u << RUN_BITS) - 1;
+
+        uint64_t pairs = 0;
+        uint64_t run = 0;
+        for (const auto &value : values) {
+            if (value == 0 && run < MAX_RUN) {
+                run++;
+                continue;
+            }
+            pairs++;
+            run = 0;
+        }
+
+        auto count_bits = (uint64_t)ceil(log2(values.size() + 1));
+        return count_bits + pairs * (RUN_BITS + data_size);
+    }
+
+    template <typename T>
+    uint64_t Compressor<T>::bitmask_bits(const std::vector<T> &values, uint32_t data_size) const {
+        auto non_zeros = values.size() - std::count(values.begin(), values.end(), (T)0);
+        return values.size() + non_zeros * data_size;
+    }
+
+    template <typename T>
+    uint64_t Compressor<T>::csr_bits(const std::vector<T> &values, uint32_t data_size) const {
+        auto non_zeros = values.size() - std::count(values.begin(), values.end(), (T)0);
+        auto index_bits = (uint64_t)std::max(ceil(log2(values.size())), 1.);
+        auto count_bits = (uint64_t)ceil(log2(values.size() + 1));
+        return count_bits + non_zeros * (index_bits + data_size);
+    }
+
+    template <typename T>
+    uint32_t Compressor<T>::value_bits(T value, uint32_t data_size, bool signed_data) const {
+        if (std::is_floating_point<T>::value)
+            return data_size;
+
+        uint64_t mask = data_size >= 64 ? UINT64_MAX : (1ull << data_size) - 1;
+        auto bits = (uint64_t)value & mask;
+        if (signed_data && ((bits >> (data_size - 1)) & 1u))
+            bits ^= mask;
+
+        uint32_t width = 0;
+        while (width < 64 && (bits >> width) != 0)
+            width++;
+        return std::max(width + signed_data, 1u);
+    }
+
+    template <typename T>
+    uint64_t Compressor<T>::compressed_bits(const std::vector<T> &values, uint32_t data_size) const {
+        uint64_t dense_bits = values.size() * data_size;
+
+        uint64_t bits = dense_bits;
+        if (SCHEME == "ZeroRLE") bits = zero_rle_bits(values, data_size);
+        else if (SCHEME == "Bitmask") bits = bitmask_bits(values, data_size);
+        else if (SCHEME == "CSR") bits = csr_bits(values, data_size);
+
+        return std::min(bits, dense_bits);
+    }
+
+    template <typename T>
+    const std::string &Compressor<T>::getScheme() const {
+        return SCHEME;
+    }
+
+    template <typename T>
+    bool Compressor<T>::enabled() const {
+        return SCHEME != "None" || DYNAMIC_PRECISION;
+    }
+
+    template <typename T>
+    uint64_t Compressor<T>::block_bits(const std::vector<T> &values, uint32_t data_size, bool signed_data) const {
+        if (!DYNAMIC_PRECISION)
+            return compressed_bits(values, data_size);
+
+        uint32_t block_precision = 1;
+        for (const auto &value : values)
+            block_precision = std::max(block_precision, value_bits(value, data_size, signed_data));
+
+        auto header_bits = (uint64_t)std::max(ceil(log2(data_size)), 1.);
+        return header_bits + compressed_bits(values, block_precision);
+    }
+
+    INITIALISE_DATA_TYPES(Compressor);
+
+}
@@ -14,6 +14,12 @@ namespace core {
         *global_cycle += 1;
     }
 
+    template <typename T>
+    void Control<T>::skip_cycles(uint64_t cycles) {
+        dram->skip_cycles(cycles);
+        *global_cycle += cycles;
+    }
+
     template <typename T>
     const std::shared_ptr<DRAM<T>> &Control<T>::getDram() const {
         return dram;
@@ -72,6 +78,13 @@ namespace core {
 
         act = _act;
         wgt = _wgt;
+        configure_models(act_prec, wgt_prec, act->isSigned(), wgt->isSigned(), _linear, __3dim, _stride);
+    }
+
+    template <typename T>
+    void Control<T>::configure_models(uint32_t act_prec, uint32_t wgt_prec, bool signed_act, bool signed_wgt,
+            bool _linear, bool __3dim, int _stride) {
+
         linear = _linear;
         _3dim = __3dim;
 
@@ -94,6 +107,18 @@ namespace core {
 
         auto act_dram_width = std::max(dram->getBaseDataSize(), (uint32_t)pow(2, ceil(log2(act_prec))));
         auto wgt_dram_width = std::max(dram->getBaseDataSize(), (uint32_t)pow(2, ceil(log2(wgt_prec))));
+        if (dram->packed()) {
+            act_dram_width = std::min(std::max(act_prec, 1u), dram->getBaseDataSize());
+            wgt_dram_width = std::min(std::max(wgt_prec, 1u), dram->getBaseDataSize());
+        }
+
+        set_visits = 0;
+        simulated_sets = 0;
+        set_open = false;
+        set_cycles.clear();
+        skipped_cycles = 0;
+        warm_sets = 0;
+        warm_cycles = 0;
 
         *global_cycle = 0;
         dram->configure_layer(act_dram_width, wgt_dram_width);
@@ -102,8 +127,9 @@ namespace core {
         pbuffer->configure_layer();
         wbuffer->configure_layer();
         obuffer->configure_layer();
-        arch->configure_layer(act_prec, wgt_prec, ACT_BLKS, WGT_BLKS, -1, arch->diffy() || act->isSigned(),
-                arch->diffy() || wgt->isSigned(), _linear, EF_COLUMNS);
+        ppu->configure_layer();
+        arch->configure_layer(act_prec, wgt_prec, ACT_BLKS, WGT_BLKS, -1, arch->diffy() || signed_act,
+                arch->diffy() || signed_wgt, _linear, EF_COLUMNS);
     }
 
     template <typename T>
@@ -121,11 +147,42 @@ namespace core {
         return on_chip_graph.front()->read_wgt_addresses;
     }
 
+    template <typename T>
+    bool Control<T>::hasNextNode() const {
+        return on_chip_graph.size() > 1;
+    }
+
+    template <typename T>
+    const std::vector<AddressRange> &Control<T>::getNextReadActAddresses() const {
+        return on_chip_graph[1]->read_act_addresses;
+    }
+
+    template <typename T>
+    const std::vector<AddressRange> &Control<T>::getNextReadPsumAddresses() const {
+        return on_chip_graph[1]->read_psum_addresses;
+    }
+
+    template <typename T>
+    const std::vector<AddressRange> &Control<T>::getNextReadWgtAddresses() const {
+        return on_chip_graph[1]->read_wgt_addresses;
+    }
+
     template <typename T>
     const std::vector<AddressRange> &Control<T>::getWriteAddresses() const {
         return on_chip_graph.front()->write_addresses;
     }
 
+    template <typename T>
+    std::vector<AddressRange> Control<T>::getLayerReadAddresses() const {
+        auto addresses = std::vector<AddressRange>();
+        for (const auto &node : on_chip_graph) {
+            addresses.insert(addresses.end(), node->read_act_addresses.begin(), node->read_act_addresses.end());
+            addresses.insert(addresses.end(), node->read_psum_addresses.begin(), node->read_psum_addresses.end());
+            addresses.insert(addresses.end(), node->read_wgt_addresses.begin(), node->read_wgt_addresses.end());
+        }
+        return addresses;
+    }
+
     template <typename T>
     bool Control<T>::getIfEvictAct() const {
         return on_chip_graph.front()->evict_act;
@@ -152,6 +209,27 @@ namespace core {
         return !on_chip_graph.empty();
     }
 
+    template <typename T>
+    std::vector<std::vector<std::shared_ptr<TilesData<T>>>> Control<T>::generate_layer_steps() {
+        auto graph = on_chip_graph;
+
+        std::vector<std::vector<std::shared_ptr<TilesData<T>>>> node_steps;
+        uint64_t step = 0;
+        do {
+            node_steps.emplace_back();
+            while (true) {
+                auto tiles_data = std::make_shared<TilesData<T>>(arch->getTiles());
+                if (!still_on_chip_data(*tiles_data))
+                    break;
+                tiles_data->step = step++;
+                node_steps.back().push_back(tiles_data);
+            }
+        } while (still_off_chip_data());
+
+        on_chip_graph = graph;
+        return node_steps;
+    }
+
     template <typename T>
     bool Control<T>::check_if_write_output(const std::shared_ptr<TilesData<T>> &tiles_data) {
         for (const auto &tile_data : tiles_data->data)
@@ -160,6 +238,100 @@ namespace core {
         return false;
     }
 
+    template <typename T>
+    uint64_t Control<T>::calculate_step_outputs(const std::shared_ptr<TilesData<T>> &tiles_data) {
+        uint64_t outputs = 0;
+        for (const auto &tile_data : tiles_data->data) {
+            if (!tile_data.valid || tile_data.out_addresses.empty()) continue;
+
+            // Linear layers repeat the single output window in every column
+            auto windows = linear ? std::min<uint64_t>(tile_data.windows.size(), 1) : tile_data.windows.size();
+            outputs += windows * tile_data.filters.size();
+        }
+        return outputs;
+    }
+
+    template <typename T>
+    void Control<T>::close_set() {
+        if (!set_open) return;
+        if (set_measured) set_cycles.push_back(getCycles() - set_start_cycle);
+        else if (set_warm) {
+            warm_sets++;
+            warm_cycles += getCycles() - set_start_cycle;
+        }
+        set_open = false;
+    }
+
+    template <typename T>
+    void Control<T>::start_set(bool measured, bool warm) {
+        close_set();
+        set_start_cycle = getCycles();
+        set_open = true;
+        set_measured = measured;
+        set_warm = warm;
+    }
+
+    template <typename T>
+    void Control<T>::end_node_sets(const Control<T> &leader) {
+        close_set();
+        set_visits = leader.set_visits;
+        simulated_sets = leader.simulated_sets;
+    }
+
+    template <typename T>
+    uint64_t Control<T>::getSkippedSets() const {
+        return set_visits - simulated_sets;
+    }
+
+    template <typename T>
+    uint64_t Control<T>::getExtrapolatedSets() const {
+        return getSkippedSets() + warm_sets;
+    }
+
+    template <typename T>
+    uint64_t Control<T>::skip_sets(uint64_t sets) {
+        close_set();
+        if (set_cycles.empty()) return 0;
+        auto cycles = (uint64_t)round(sets * sys::get_average(set_cycles));
+        skipped_cycles += cycles;
+        return cycles;
+    }
+
+    template <typename T>
+    bool Control<T>::sampling() const {
+        return false;
+    }
+
+    template <typename T>
+    double Control<T>::getEstimatedCycles() const {
+        return getCycles();
+    }
+
+    template <typename T>
+    double Control<T>::getEstimatedCyclesInterval() const {
+        return 0;
+    }
+
+    template <typename T>
+    double Control<T>::getSimulatedFraction() const {
+        return 1;
+    }
+
+    template <typename T>
+    bool Control<T>::mapping_search() const {
+        return false;
+    }
+
+    template <typename T>
+    std::string Control<T>::getMapping() const {
+        return "-";
+    }
+
+    template <typename T>
+    uint64_t Control<T>::getMappingTraffic() const {
+        return 0;
+    }
+
     INITIALISE_DATA_TYPES(Control);
 
 }
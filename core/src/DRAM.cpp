@@ -78,9 +78,63 @@ namespace core {
     std::string DRAM<T>::header() {
         std::string header = "Starting activation address: " + addr_to_hex(START_ACT_ADDRESS, SIZE) + "\n";
         header += "Starting weight address: " + addr_to_hex(START_WGT_ADDRESS, SIZE) + "\n";
+        header += "Backend: " + backend->name() + "\n";
+        if (wgt_backend) header += "Weights backend: " + wgt_backend->name() + "\n";
+        if (compressor.getScheme() != "None") header += "Compression: " + compressor.getScheme() + "\n";
+        if (PACKING != "None") header += "Packing: " + PACKING + "\n";
+        if (LAYOUT != "NHWC") header += "Activations layout: " + LAYOUT + "\n";
         return header;
     }
 
+    template <typename T>
+    bool DRAM<T>::packed() const {
+        return PACKING != "None";
+    }
+
+    template <typename T>
+    bool DRAM<T>::compression() const {
+        return compressor.enabled();
+    }
+
+    template <typename T>
+    uint64_t DRAM<T>::block_bits(const std::vector<T> &values, uint32_t data_size, bool signed_data) const {
+        return compressor.enabled() ? compressor.block_bits(values, data_size, signed_data) : WIDTH;
+    }
+
+    template <typename T>
+    uint64_t DRAM<T>::pack_block(uint64_t bits, uint64_t &next_address, uint64_t &line_bits) const {
+        if (line_bits + bits > WIDTH) close_line(next_address, line_bits);
+        line_bits += bits;
+        return next_address;
+    }
+
+    template <typename T>
+    const std::string &DRAM<T>::getLayout() const {
+        return LAYOUT;
+    }
+
+    template <typename T>
+    void DRAM<T>::align_unit(uint64_t start_address, uint64_t &next_address, uint64_t &line_bits,
+            uint64_t unit_size) const {
+        if (LAYOUT != "Auto" || unit_size > ROW_SIZE)
+            return;
+
+        auto next_line = next_address + (line_bits == 0 ? 0 : WIDTH);
+        auto row_offset = (start_address + next_line) % ROW_SIZE;
+        if (row_offset == 0 || row_offset + unit_size <= ROW_SIZE)
+            return;
+
+        close_line(next_address, line_bits);
+        next_address += ROW_SIZE - row_offset;
+    }
+
+    template <typename T>
+    void DRAM<T>::close_line(uint64_t &next_address, uint64_t &line_bits) const {
+        if (line_bits == 0) return;
+        next_address += WIDTH;
+        line_bits = 0;
+    }
+
     template <typename T>
     void DRAM<T>::configure_layer(uint32_t _ACT_DATA_SIZE, uint32_t _WGT_DATA_SIZE) {
         ACT_DATA_SIZE = _ACT_DATA_SIZE;
@@ -93,10 +147,26 @@ namespace core {
         *this->out_addresses = {NULL_ADDR, 0};
         *this->wgt_addresses = {NULL_ADDR, 0};
         this->tracked_data->clear();
+        prefetched.clear();
+        prefetched_addresses = 0;
+        stage_reads_in_flight = 0;
+        waiting_blocks[0].clear();
+        waiting_blocks[1].clear();
+        waiting_addresses = 0;
+        writes_staged = false;
 
         act_reads = 0;
         wgt_reads = 0;
         out_writes = 0;
+
+        if (!trace_dir.empty()) {
+            if (trace_file.is_open()) trace_file.close();
+            auto path = trace_dir + "/mase_" + trace_network + "_L" + std::to_string(trace_layers++) + ".trc";
+            trace_file.open(path);
+            if (!trace_file.good())
+                throw std::runtime_error("Error creating DRAM trace " + path);
+            layer_start = now;
+        }
     }
 
     template <typename T>
@@ -125,14 +195,79 @@ namespace core {
         return compressed_addresses;
     }
 
+    template <typename T>
+    std::shared_ptr<DRAMBackend> DRAM<T>::create_backend(const std::string &_backend, const std::string &_dram_conf,
+            const std::string &_system_conf, const std::string &_name, uint64_t _clock_freq, uint32_t _latency,
+            double _bandwidth, uint32_t _row_miss_latency, uint32_t _banks, uint32_t _row_size, bool _vis_output) {
+
+        auto read_done = [this](uint64_t address) { read_transaction_done(address); };
+        auto write_done = [this](uint64_t address) { write_transaction_done(address); };
+
+        if (_backend == "DRAMSim2")
+            return std::make_shared<DRAMSimBackend>(read_done, write_done, _dram_conf, _system_conf, _name, SIZE,
+                    _clock_freq, _vis_output);
+        else if (_backend == "Ideal")
+            return std::make_shared<IdealDRAM>(read_done, write_done);
+        else if (_backend == "Fixed")
+            return std::make_shared<FixedDRAM>(read_done, write_done, _latency, _bandwidth);
+        else if (_backend == "Bank")
+            return std::make_shared<BankDRAM>(read_done, write_done, _latency, _bandwidth, _row_miss_latency, _banks,
+                    _row_size);
+        else throw std::runtime_error("Incorrect DRAM backend");
+    }
+
+    template <typename T>
+    uint32_t DRAM<T>::memory(uint64_t address) const {
+        if (!wgt_backend)
+            return 0;
+        auto wgt_region = START_WGT_ADDRESS > START_ACT_ADDRESS ? 1 : 0;
+        auto region = address >= region_start[1] ? 1 : 0;
+        return region == wgt_region ? 1 : 0;
+    }
+
+    template <typename T>
+    void DRAM<T>::update_backends(uint64_t cycle) {
+        for (; backend_now < cycle; ++backend_now) {
+            backend->cycle();
+            if (wgt_backend) wgt_backend->cycle();
+        }
+    }
+
     template <typename T>
     void DRAM<T>::cycle() {
-        dram_interface->update();
+        if (!transaction_log || !transaction_log->matching())
+            update_backends(now + 1);
+
+        while (!replay_in_flight.empty() && std::get<0>(replay_in_flight.top()) <= now) {
+            auto transaction = replay_in_flight.top();
+            replay_in_flight.pop();
+            if (std::get<3>(transaction)) write_transaction_done(std::get<2>(transaction));
+            else read_transaction_done(std::get<2>(transaction));
+        }
+
+        now++;
     }
 
     template <typename T>
     bool DRAM<T>::data_ready() {
-        return waiting_addresses.empty();
+        return waiting_addresses == 0;
+    }
+
+    template <typename T>
+    bool DRAM<T>::busy() const {
+        return transactions_in_flight != 0;
+    }
+
+    template <typename T>
+    bool DRAM<T>::reading() const {
+        return stage_reads_in_flight != 0;
+    }
+
+    template <typename T>
+    void DRAM<T>::skip_cycles(uint64_t cycles) {
+        assert(!busy());
+        now += cycles;
+        backend_now += cycles;
     }
 
     template <typename T>
@@ -147,15 +282,15 @@ namespace core {
                     for (const auto &act_addr_row : tile_data.act_addresses)
                         for (const auto &act_addr : act_addr_row)
                             if (act_addr != NULL_ADDR && (*this->tracked_data).at(act_addr) == 0)
-                                waiting_addresses.insert(act_addr);
+                                wait_address(act_addr);
 
                 for (const auto &psum_addr : tile_data.psum_addresses)
                     if (psum_addr != NULL_ADDR && (*this->tracked_data).at(psum_addr) == 0)
-                        waiting_addresses.insert(psum_addr);
+                        wait_address(psum_addr);
 
                 for (const auto &wgt_addr : tile_data.wgt_addresses)
                     if (wgt_addr != NULL_ADDR && (*this->tracked_data).at(wgt_addr) == 0)
-                        waiting_addresses.insert(wgt_addr);
+                        wait_address(wgt_addr);
 
             }
         } catch (std::exception &exception) {
@@ -164,40 +299,211 @@ namespace core {
     }
 
 
+    template <typename T>
+    void DRAM<T>::reserve_addresses(const std::vector<AddressRange> &addresses) {
+        for (const auto &addr_range : addresses) {
+            auto start_addr = std::get<0>(addr_range);
+            auto end_addr = std::get<1>(addr_range);
+            if (start_addr == NULL_ADDR) continue;
+            if (start_addr < region_start[0])
+                throw std::runtime_error("DRAM address " + std::to_string(start_addr) +
+                        " below the start addresses.");
+
+            // A range crossing the higher start address fills the lower region
+            auto region = end_addr >= region_start[1] ? 1 : 0;
+            if (region == 1 && start_addr < region_start[1])
+                waiting_blocks[0].resize(std::max(waiting_blocks[0].size(),
+                        ((region_start[1] - region_start[0]) / WIDTH + 63) / 64), 0);
+
+            auto block = (end_addr - region_start[region]) / WIDTH;
+            auto &blocks = waiting_blocks[region];
+            if (block / 64 >= blocks.size())
+                blocks.resize(block / 64 + 1, 0);
+        }
+    }
+
+    template <typename T>
+    uint64_t DRAM<T>::waiting_block(uint64_t address, int &region) const {
+        region = address >= region_start[1] ? 1 : 0;
+        auto block = (address - region_start[region]) / WIDTH;
+        if (address < region_start[0] || block / 64 >= waiting_blocks[region].size())
+            throw std::runtime_error("DRAM address " + std::to_string(address) + " outside the layer addresses.");
+        return block;
+    }
+
+    template <typename T>
+    void DRAM<T>::wait_address(uint64_t address) {
+        int region;
+        auto block = waiting_block(address, region);
+        auto &blocks = waiting_blocks[region];
+
+        auto mask = 1ull << (block % 64);
+        if ((blocks[block / 64] & mask) == 0) {
+            blocks[block / 64] |= mask;
+            waiting_addresses++;
+        }
+    }
+
+    template <typename T>
+    void DRAM<T>::release_address(uint64_t address) {
+        int region;
+        auto block = waiting_block(address, region);
+        auto &blocks = waiting_blocks[region];
+
+        auto mask = 1ull << (block % 64);
+        if ((blocks[block / 64] & mask) != 0) {
+            blocks[block / 64] &= ~mask;
+            waiting_addresses--;
+        }
+    }
+
     template <typename T>
     void DRAM<T>::transaction_request(uint64_t address, bool isWrite) {
-        if (dram_interface->willAcceptTransaction()) {
-            dram_interface->addTransaction(isWrite, address);
+        if (trace_file.is_open()) {
+            auto stamp = (uint64_t)((now - layer_start) * trace_clock_ratio);
+            trace_file << "0x" << std::hex << std::uppercase << address << std::dec << (isWrite ? " WRITE " : " READ ")
+                    << stamp << '\n';
+        }
+
+        uint32_t latency = 0;
+        if (transaction_log && transaction_log->request(address, isWrite, now, latency)) {
+            if (latency != UINT32_MAX) {
+                replay_in_flight.emplace(now + latency, replay_sent++, address, isWrite);
+                transactions_in_flight++;
+            }
+            return;
+        }
+
+        // Idle since the replayed transactions
+        update_backends(now);
+        send_transaction(address, isWrite);
+        transactions_in_flight++;
+    }
+
+    template <typename T>
+    void DRAM<T>::send_transaction(uint64_t address, bool isWrite) {
+        auto mem = memory(address);
+        const auto &target = mem == 0 ? backend : wgt_backend;
+        if (target->will_accept_transaction()) {
+            target->add_transaction(address, isWrite);
         } else {
-            request_queue.push({address, isWrite});
+            auto &queue = request_queue[mem];
+            auto &head = request_head[mem];
+            auto &count = request_count[mem];
+            if (count == queue.size()) {
+                std::rotate(queue.begin(), queue.begin() + head, queue.end());
+                queue.resize(2 * queue.size());
+                head = 0;
+            }
+            queue[(head + count) % queue.size()] = std::make_tuple(address, isWrite);
+            count++;
         }
     }
 
     template <typename T>
-    void DRAM<T>::read_transaction_done(unsigned id, uint64_t address, uint64_t _clock_cycle) {
+    void DRAM<T>::dequeue_request(uint32_t mem) {
+        if (request_count[mem] == 0)
+            return;
+
+        const auto &queue = request_queue[mem];
+        auto tuple = queue[request_head[mem]];
+        request_head[mem] = (request_head[mem] + 1) % queue.size();
+        request_count[mem]--;
+        send_transaction(std::get<0>(tuple), std::get<1>(tuple));
+    }
+
+    template <typename T>
+    void DRAM<T>::read_transaction_done(uint64_t address) {
         try {
-            (*this->tracked_data).at(address) = 1;
+            transactions_in_flight--;
+            if (transaction_log) transaction_log->complete(address, false, now);
+
+            // Prefetched for a stage that has not started yet
+            if (prefetched_addresses != 0 && prefetched.find(address) != NULL_SLOT) {
+                prefetched.insert(address, 1);
+                dequeue_request(memory(address));
+                return;
+            }
 
-            auto it = waiting_addresses.find(address);
-            if (it != waiting_addresses.end())
-                waiting_addresses.erase(address);
+            (*this->tracked_data).at(address) = 1;
+            stage_reads_in_flight--;
 
-            if (!request_queue.empty()) {
-                auto tuple = request_queue.front();
-                transaction_request(std::get<0>(tuple), std::get<1>(tuple));
-                request_queue.pop();
-            }
+            release_address(address);
+            dequeue_request(memory(address));
         } catch (std::exception &exception) {
             throw std::runtime_error("DRAM waiting for a memory address not requested.");
         }
     }
 
+    template <typename T>
+    bool DRAM<T>::claim_prefetched(uint64_t address) {
+        if (prefetched_addresses == 0)
+            return false;
+
+        auto state = prefetched.find(address);
+        if (state == NULL_SLOT)
+            return false;
+
+        prefetched.erase(address);
+        prefetched_addresses--;
+        this->tracked_data->insert({address, state});
+        if (state == 0) stage_reads_in_flight++;
+        return true;
+    }
+
+    template <typename T>
+    void DRAM<T>::prefetch_addresses(const std::vector<AddressRange> &addresses, uint64_t &reads, uint64_t &free) {
+        for (const auto &addr_range : addresses) {
+            auto start_addr = std::get<0>(addr_range);
+            auto end_addr = std::get<1>(addr_range);
+            if (start_addr == NULL_ADDR) continue;
+
+            for (uint64_t addr = start_addr; addr <= end_addr; addr += WIDTH) {
+                if (free == 0)
+                    return;
+
+                if (this->tracked_data->find(addr) != this->tracked_data->end() || prefetched.find(addr) != NULL_SLOT)
+                    continue;
+
+                prefetched.insert(addr, 0);
+                prefetched_addresses++;
+                transaction_request(addr, false);
+                reads++;
+                free--;
+            }
+        }
+    }
+
+    template <typename T>
+    uint64_t DRAM<T>::resident_addresses(const AddressRange &range) const {
+        if (std::get<0>(range) == NULL_ADDR)
+            return 0;
+        return std::distance(this->tracked_data->lower_bound(std::get<0>(range)),
+                this->tracked_data->upper_bound(std::get<1>(range)));
+    }
+
+    template <typename T>
+    void DRAM<T>::wait_range(const AddressRange &range) {
+        if (std::get<0>(range) == NULL_ADDR)
+            return;
+
+        auto end = this->tracked_data->upper_bound(std::get<1>(range));
+        for (auto it = this->tracked_data->lower_bound(std::get<0>(range)); it != end; ++it)
+            if (it->second == 0)
+                wait_address(it->first);
+    }
+
+    template <typename T>
+    void DRAM<T>::wait_read_data() {
+        wait_range(*this->act_addresses);
+        wait_range(*this->out_addresses);
+        wait_range(*this->wgt_addresses);
+    }
+
     template <typename T>
     void DRAM<T>::read_data(const std::vector<AddressRange> &act_addresses,
             const std::vector<AddressRange> &psum_addresses, const std::vector<AddressRange> &wgt_addresses) {
 
-        const uint32_t OVERLAP = 16;
-
         uint32_t act_addr_idx = 0;
         uint64_t act_start_addr = NULL_ADDR;
         uint64_t act_end_addr = 0;
@@ -213,7 +519,7 @@ namespace core {
         uint64_t wgt_end_addr = 0;
         bool wgt_first = true;
 
-        int count = 0;
+        uint32_t count = 0;
         bool still_data = true;
         while (still_data) {
 
@@ -242,13 +548,16 @@ namespace core {
                 }
 
                 while (act_start_addr <= act_end_addr) {
-                    if (count == OVERLAP)
+                    if (count == ACT_BURST)
                         break;
 
-                    this->tracked_data->insert({act_start_addr, 0});
-                    transaction_request(act_start_addr, false);
+                    if (!claim_prefetched(act_start_addr)) {
+                        this->tracked_data->insert({act_start_addr, 0});
+                        transaction_request(act_start_addr, false);
+                        stage_reads_in_flight++;
+                        act_reads++;
+                    }
                     still_data = true;
-                    act_reads++;
 
                     act_start_addr += WIDTH;
                     count++;
@@ -285,13 +594,16 @@ namespace core {
                 }
 
                 while (psum_start_addr <= psum_end_addr) {
-                    if (count == OVERLAP)
+                    if (count == ACT_BURST)
                         break;
 
-                    this->tracked_data->insert({psum_start_addr, 0});
-                    transaction_request(psum_start_addr, false);
+                    if (!claim_prefetched(psum_start_addr)) {
+                        this->tracked_data->insert({psum_start_addr, 0});
+                        transaction_request(psum_start_addr, false);
+                        stage_reads_in_flight++;
+                        psum_reads++;
+                    }
                     still_data = true;
-                    psum_reads++;
 
                     psum_start_addr += WIDTH;
                     count++;
@@ -329,13 +641,16 @@ namespace core {
 
                 while (wgt_start_addr <= wgt_end_addr) {
 
-                    if (count == OVERLAP)
+                    if (count == WGT_BURST)
                         break;
 
-                    this->tracked_data->insert({wgt_start_addr, 0});
-                    transaction_request(wgt_start_addr, false);
+                    if (!claim_prefetched(wgt_start_addr)) {
+                        this->tracked_data->insert({wgt_start_addr, 0});
+                        transaction_request(wgt_start_addr, false);
+                        stage_reads_in_flight++;
+                        wgt_reads++;
+                    }
                     still_data = true;
-                    wgt_reads++;
 
                     wgt_start_addr += WIDTH;
                     count++;
@@ -354,16 +669,74 @@ namespace core {
     }
 
     template <typename T>
-    void DRAM<T>::write_transaction_done(unsigned id, uint64_t address, uint64_t _clock_cycle) {
-        if (!request_queue.empty()) {
-            auto tuple = request_queue.front();
-            transaction_request(std::get<0>(tuple), std::get<1>(tuple));
-            request_queue.pop();
+    bool DRAM<T>::prefetch() const {
+        return PREFETCH;
+    }
+
+    template <typename T>
+    void DRAM<T>::prefetch_data(const std::vector<AddressRange> &act_addresses,
+            const std::vector<AddressRange> &psum_addresses, const std::vector<AddressRange> &wgt_addresses,
+            uint64_t act_capacity, uint64_t wgt_capacity) {
+
+        // Only the capacity not used by the data of the current stage is available
+        auto act_resident = resident_addresses(*this->act_addresses) + resident_addresses(*this->out_addresses);
+        auto act_free = act_capacity > act_resident ? act_capacity - act_resident : 0;
+        auto wgt_resident = resident_addresses(*this->wgt_addresses);
+        auto wgt_free = wgt_capacity > wgt_resident ? wgt_capacity - wgt_resident : 0;
+
+        prefetch_addresses(act_addresses, act_reads, act_free);
+        prefetch_addresses(psum_addresses, psum_reads, act_free);
+        prefetch_addresses(wgt_addresses, wgt_reads, wgt_free);
+    }
+
+    template <typename T>
+    void DRAM<T>::write_transaction_done(uint64_t address) {
+        transactions_in_flight--;
+        if (transaction_log) transaction_log->complete(address, true, now);
+        dequeue_request(memory(address));
+    }
+
+    template <typename T>
+    void DRAM<T>::stage_writes(const std::vector<AddressRange> &write_addresses) {
+        staged_writes.clear();
+        for (const auto &addr_range : write_addresses) {
+            auto start_addr = std::get<0>(addr_range);
+            auto end_addr = std::get<1>(addr_range);
+            if (start_addr == NULL_ADDR) continue;
+
+            for (uint64_t addr = start_addr; addr <= end_addr; addr += WIDTH)
+                staged_writes.push_back(addr);
+        }
+
+        writes_staged = true;
+        staged_written = 0;
+        staged_values = 0;
+    }
+
+    template <typename T>
+    void DRAM<T>::write_request(uint64_t outputs) {
+        if (!writes_staged)
+            return;
+
+        staged_values += outputs;
+        while (staged_values >= BASE_VALUES_PER_BLOCK && staged_written < staged_writes.size()) {
+            transaction_request(staged_writes[staged_written++], true);
+            out_writes++;
+            staged_values -= BASE_VALUES_PER_BLOCK;
         }
     }
 
     template <typename T>
     void DRAM<T>::write_data(const std::vector<AddressRange> &write_addresses) {
+        if (writes_staged) {
+            for (; staged_written < staged_writes.size(); ++staged_written) {
+                transaction_request(staged_writes[staged_written], true);
+                out_writes++;
+            }
+            writes_staged = false;
+            return;
+        }
+
         for (const auto &addr_range : write_addresses) {
             auto start_addr = std::get<0>(addr_range);
             auto end_addr = std::get<1>(addr_range);
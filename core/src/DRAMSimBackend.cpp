@@ -0,0 +1,114 @@
+
+#include <core/DRAMSimBackend.h>
+
+namespace core {
+
+    std::map<std::string, std::vector<DRAMSim::MultiChannelMemorySystem*>> DRAMPool::idle;
+    std::mutex DRAMPool::idle_lock;
+
+    std::string DRAMPool::key(const std::string &dram_conf, const std::string &system_conf, const std::string &trace,
+            uint32_t size, bool vis_output) {
+        return dram_conf + "|" + system_conf + "|" + trace + "|" + std::to_string(size) + "|" +
+                std::to_string(vis_output);
+    }
+
+    DRAMSim::MultiChannelMemorySystem* DRAMPool::acquire(const std::string &dram_conf, const std::string &system_conf,
+            const std::string &trace, uint32_t size, bool vis_output) {
+        std::unique_lock<std::mutex> lock(idle_lock);
+        auto &instances = idle[key(dram_conf, system_conf, trace, size, vis_output)];
+        if (instances.empty()) {
+            lock.unlock();
+            std::map<std::string, std::string> overrides = {{"VIS_FILE_OUTPUT", vis_output ? "true" : "false"}};
+            return DRAMSim::getMemorySystemInstance(dram_conf, system_conf, "./DRAMSim2/", trace, size, nullptr,
+                    &overrides);
+        }
+
+        auto dram_interface = instances.back();
+        instances.pop_back();
+        lock.unlock();
+        dram_interface->reset();
+        return dram_interface;
+    }
+
+    void DRAMPool::release(const std::string &key, DRAMSim::MultiChannelMemorySystem *dram_interface) {
+        dram_interface->RegisterCallbacks(nullptr, nullptr, nullptr);
+        dram_interface->closeOutputFiles();
+        std::lock_guard<std::mutex> lock(idle_lock);
+        idle[key].push_back(dram_interface);
+    }
+
+    DRAMSimBackend::DRAMSimBackend(const TransactionDone &_read_done, const TransactionDone &_write_done,
+            const std::string &_dram_conf, const std::string &_system_conf, const std::string &_trace,
+            uint32_t _SIZE, uint64_t _clock_freq, bool _vis_output) : DRAMBackend(_read_done, _write_done),
+            DRAM_CONF(_dram_conf), CLOCK_FREQ(_clock_freq) {
+
+        dram_key = DRAMPool::key(_dram_conf, _system_conf, _trace, _SIZE, _vis_output);
+        dram_interface = DRAMPool::acquire(_dram_conf, _system_conf, _trace, _SIZE, _vis_output);
+
+        read_cb = new DRAMSim::Callback<DRAMSimBackend, void, unsigned, uint64_t, uint64_t>(this,
+                &DRAMSimBackend::read_transaction_done);
+
+        write_cb = new DRAMSim::Callback<DRAMSimBackend, void, unsigned, uint64_t, uint64_t>(this,
+                &DRAMSimBackend::write_transaction_done);
+
+        dram_interface->RegisterCallbacks(read_cb, write_cb, nullptr);
+
+        dram_interface->setCPUClockSpeed(_clock_freq);
+    }
+
+    DRAMSimBackend::~DRAMSimBackend() {
+        DRAMPool::release(dram_key, dram_interface);
+        delete read_cb;
+        delete write_cb;
+    }
+
+    std::string DRAMSimBackend::name() {
+        return "DRAMSim2 " + DRAM_CONF;
+    }
+
+    void DRAMSimBackend::catch_up() {
+        if (skipped_cycles > 0) {
+            dram_interface->skipIdleCycles(skipped_cycles);
+            skipped_cycles = 0;
+        }
+        idle_cycles = 0;
+    }
+
+    bool DRAMSimBackend::will_accept_transaction() {
+        catch_up();
+        return dram_interface->willAcceptTransaction();
+    }
+
+    void DRAMSimBackend::add_transaction(uint64_t address, bool isWrite) {
+        catch_up();
+        dram_interface->addTransaction(isWrite, address);
+    }
+
+    void DRAMSimBackend::cycle() {
+        if (idle_cycles > 0) {
+            idle_cycles--;
+            skipped_cycles++;
+            return;
+        }
+
+        catch_up();
+        dram_interface->update();
+        idle_cycles = dram_interface->getIdleCycles();
+    }
+
+    double DRAMSimBackend::memory_cycles_per_cycle() {
+        float tCK = 0;
+        if (dram_interface->getIniFloat("tCK", &tCK) != 0 || tCK <= 0 || CLOCK_FREQ == 0)
+            return 1.0;
+        return 1e9 / tCK / CLOCK_FREQ;
+    }
+
+    void DRAMSimBackend::read_transaction_done(unsigned, uint64_t address, uint64_t) {
+        read_done(address);
+    }
+
+    void DRAMSimBackend::write_transaction_done(unsigned, uint64_t address, uint64_t) {
+        write_done(address);
+    }
+
+}
@@ -4,21 +4,33 @@
 namespace core {
 
     void FIFO::flush() {
-        fifo = std::queue<uint64_t>();
+        first = 0;
+        size = 0;
     }
 
     bool FIFO::free_entry() {
-        return fifo.size() < this->MAX_SIZE;
+        return size < this->MAX_SIZE;
     }
 
     void FIFO::insert_addr(uint64_t addr) {
-        fifo.emplace(addr);
+        if (size == fifo.size()) {
+            // Grow the ring buffer unwrapping the addresses from the oldest one
+            std::rotate(fifo.begin(), fifo.begin() + first, fifo.end());
+            first = 0;
+            fifo.push_back(addr);
+        } else {
+            auto pos = first + size;
+            if (pos >= fifo.size()) pos -= fifo.size();
+            fifo[pos] = addr;
+        }
+        size++;
     }
 
     uint64_t FIFO::evict_addr() {
-        assert(!fifo.empty());
-        auto addr = fifo.front();
-        fifo.pop();
+        assert(size > 0);
+        auto addr = fifo[first];
+        if (++first == fifo.size()) first = 0;
+        size--;
         return addr;
     }
 
@@ -0,0 +1,31 @@
+
+#include <core/FixedDRAM.h>
+
+namespace core {
+
+    std::string FixedDRAM::name() {
+        return "Fixed latency " + std::to_string(LATENCY) + " cycles, bandwidth " + std::to_string(BANDWIDTH) +
+                " transactions per cycle";
+    }
+
+    bool FixedDRAM::will_accept_transaction() {
+        return true;
+    }
+
+    void FixedDRAM::add_transaction(uint64_t address, bool isWrite) {
+        auto start = std::max((double)now, channel_free);
+        channel_free = start + 1. / BANDWIDTH;
+        in_flight.emplace((uint64_t)ceil(channel_free) + LATENCY, address, isWrite);
+    }
+
+    void FixedDRAM::cycle() {
+        now++;
+        while (!in_flight.empty() && std::get<0>(in_flight.front()) <= now) {
+            auto transaction = in_flight.front();
+            in_flight.pop();
+            if (std::get<2>(transaction)) write_done(std::get<1>(transaction));
+            else read_done(std::get<1>(transaction));
+        }
+    }
+
+}
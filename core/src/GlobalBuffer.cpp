@@ -132,6 +132,11 @@ namespace core {
         wgt_bank_conflicts = std::vector<uint64_t>(WGT_LEVELS, 0);
         out_bank_conflicts = std::vector<uint64_t>(ACT_LEVELS, 0);
 
+        *current_step = 0;
+        act_future->clear();
+        out_future->clear();
+        wgt_future->clear();
+
         for (int lvl = 1; lvl < ACT_LEVELS; ++lvl) {
             for (int bank = 0; bank < ACT_BANKS; ++bank) {
                 act_eviction_policy[lvl][bank]->flush();
@@ -148,6 +153,44 @@ namespace core {
         }
     }
 
+    template <typename T>
+    bool GlobalBuffer<T>::lookahead() const {
+        return (ACT_POLICY == "OPT" && ACT_LEVELS > 1) || (WGT_POLICY == "OPT" && WGT_LEVELS > 1);
+    }
+
+    template <typename T>
+    void GlobalBuffer<T>::plan_steps(const std::vector<std::shared_ptr<TilesData<T>>> &steps) {
+        act_future->clear();
+        out_future->clear();
+        wgt_future->clear();
+
+        for (const auto &tiles_data : steps) {
+            for (const auto &tile_data : tiles_data->data) {
+
+                if (!tile_data.valid)
+                    continue;
+
+                for (const auto &row : tile_data.act_addresses)
+                    for (const auto &act_addr : row)
+                        if (act_addr != NULL_ADDR) act_future->add(act_addr, tiles_data->step);
+
+                for (const auto &psum_addr : tile_data.psum_addresses)
+                    if (psum_addr != NULL_ADDR) out_future->add(psum_addr, tiles_data->step);
+
+                for (const auto &out_addr : tile_data.out_addresses)
+                    if (out_addr != NULL_ADDR) out_future->add(out_addr, tiles_data->step);
+
+                for (const auto &wgt_addr : tile_data.wgt_addresses)
+                    if (wgt_addr != NULL_ADDR) wgt_future->add(wgt_addr, tiles_data->step);
+
+            }
+        }
+
+        act_future->build();
+        out_future->build();
+        wgt_future->build();
+    }
+
     template<typename T>
     bool GlobalBuffer<T>::write_done() {
         return write_ready_cycle <= *this->global_cycle;
@@ -159,7 +202,8 @@ namespace core {
 
         try {
 
-            auto bank_addr_reads = std::vector<std::vector<int>>(ACT_LEVELS, std::vector<int>(ACT_BANKS, 0));
+            *current_step = std::max(*current_step, tiles_data->step);
+            act_bank_reads.clear();
 
             for (const auto &tile_data : tiles_data->data) {
 
@@ -186,9 +230,9 @@ namespace core {
 
                         read_act = true;
                         const auto &act_lvl = (*this->tracked_data).at(act_addr);
-                        const auto &act_bank = tile_data.act_banks[row][idx];
+                        assert(tile_data.act_banks[row][idx] != -1);
+                        auto act_bank = tile_data.act_banks[row][idx] % ACT_BANKS;
 
-                        assert(act_bank != -1);
                         assert(act_lvl >= 1 && act_lvl <= ACT_LEVELS);
 
                         for (int lvl = ACT_LEVELS; lvl > act_lvl; --lvl) {
@@ -201,7 +245,7 @@ namespace core {
                         }
 
                         for (int lvl = ACT_LEVELS; lvl >= 1; --lvl) {
-                            if (lvl >= act_lvl) bank_addr_reads[lvl - 1][act_bank]++;
+                            if (lvl >= act_lvl) act_bank_reads.increment(lvl - 1, act_bank);
                             else if (lvl != 1) act_eviction_policy[lvl - 1][act_bank]->update_status(act_addr);
                         }
 
@@ -213,18 +257,11 @@ namespace core {
             }
 
             uint64_t start_time = read_act ? *this->global_cycle : 0;
+            const auto &bank_steps = act_bank_reads.steps(ACT_ADDRS_PER_ACCESS, act_reads);
             for (int lvl = 0; lvl < ACT_LEVELS; ++lvl) {
 
-                auto bank_steps = 0;
-                for (const auto &reads : bank_addr_reads[lvl]) {
-                    auto bank_reads = ceil(reads / (double)ACT_ADDRS_PER_ACCESS);
-                    act_reads[lvl] += bank_reads;
-                    if (bank_reads > bank_steps)
-                        bank_steps = bank_reads;
-                }
-
-                start_time += bank_steps * ACT_READ_DELAY[lvl];
-                act_bank_conflicts[lvl] += bank_steps > 0 ? bank_steps - 1 : 0;
+                start_time += bank_steps[lvl] * ACT_READ_DELAY[lvl];
+                act_bank_conflicts[lvl] += bank_steps[lvl] > 0 ? bank_steps[lvl] - 1 : 0;
 
             }
 
@@ -241,7 +278,8 @@ namespace core {
 
         try {
 
-            auto bank_addr_reads = std::vector<std::vector<int>>(ACT_LEVELS, std::vector<int>(OUT_BANKS, 0));
+            *current_step = std::max(*current_step, tiles_data->step);
+            psum_bank_reads.clear();
 
             for (const auto &tile_data : tiles_data->data) {
 
@@ -259,9 +297,9 @@ namespace core {
 
                     read_psum = true;
                     const auto &psum_lvl = (*this->tracked_data).at(psum_addr);
-                    const auto &psum_bank = tile_data.psum_banks[idx];
+                    assert(tile_data.psum_banks[idx] != -1);
+                    auto psum_bank = tile_data.psum_banks[idx] % OUT_BANKS;
 
-                    assert(psum_bank != -1);
                     assert(psum_lvl >= 1 && psum_lvl <= ACT_LEVELS);
 
                     for (int lvl = ACT_LEVELS; lvl > psum_lvl; --lvl) {
@@ -274,7 +312,7 @@ namespace core {
                     }
 
                     for (int lvl = ACT_LEVELS; lvl >= 1; --lvl) {
-                        if (lvl >= psum_lvl) bank_addr_reads[lvl - 1][psum_bank]++;
+                        if (lvl >= psum_lvl) psum_bank_reads.increment(lvl - 1, psum_bank);
                         else if (lvl != 1) out_eviction_policy[lvl - 1][psum_bank]->update_status(psum_addr);
                     }
 
@@ -285,18 +323,11 @@ namespace core {
             }
 
             uint64_t start_time = read_psum ? std::max(*this->global_cycle, write_ready_cycle) : 0;
+            const auto &bank_steps = psum_bank_reads.steps(ACT_ADDRS_PER_ACCESS, psum_reads);
             for (int lvl = 0; lvl < ACT_LEVELS; ++lvl) {
 
-                auto bank_steps = 0;
-                for (const auto &reads : bank_addr_reads[lvl]) {
-                    auto bank_reads = ceil(reads / (double)ACT_ADDRS_PER_ACCESS);
-                    psum_reads[lvl] += bank_reads;
-                    if (bank_reads > bank_steps)
-                        bank_steps = bank_reads;
-                }
-
-                start_time += bank_steps * ACT_READ_DELAY[lvl];
-                psum_bank_conflicts[lvl] += bank_steps > 0 ? bank_steps - 1 : 0;
+                start_time += bank_steps[lvl] * ACT_READ_DELAY[lvl];
+                psum_bank_conflicts[lvl] += bank_steps[lvl] > 0 ? bank_steps[lvl] - 1 : 0;
 
             }
 
@@ -314,7 +345,8 @@ namespace core {
 
         try {
 
-            auto bank_addr_reads = std::vector<std::vector<int>>(WGT_LEVELS, std::vector<int>(WGT_BANKS, 0));
+            *current_step = std::max(*current_step, tiles_data->step);
+            wgt_bank_reads.clear();
 
             for (const auto &tile_data : tiles_data->data) {
 
@@ -332,9 +364,9 @@ namespace core {
 
                     read_wgt = true;
                     const auto &wgt_lvl = (*this->tracked_data).at(wgt_addr);
-                    const auto &wgt_bank = tile_data.wgt_banks[idx];
+                    assert(tile_data.wgt_banks[idx] != -1);
+                    auto wgt_bank = tile_data.wgt_banks[idx] % WGT_BANKS;
 
-                    assert(wgt_bank != -1);
                     assert(wgt_lvl >= 1 && wgt_lvl <= WGT_LEVELS);
 
                     for (int lvl = WGT_LEVELS; lvl > wgt_lvl; --lvl) {
@@ -347,8 +379,8 @@ namespace core {
                     }
 
                     for (int lvl = WGT_LEVELS; lvl >= 1; --lvl) {
-                        if (lvl >= wgt_lvl) bank_addr_reads[lvl - 1][wgt_bank]++;
-                        else if (lvl != 1) act_eviction_policy[lvl - 1][wgt_bank]->update_status(wgt_addr);
+                        if (lvl >= wgt_lvl) wgt_bank_reads.increment(lvl - 1, wgt_bank);
+                        else if (lvl != 1) wgt_eviction_policy[lvl - 1][wgt_bank]->update_status(wgt_addr);
                     }
 
                     (*this->tracked_data).at(wgt_addr) = WGT_LEVELS;
@@ -358,18 +390,11 @@ namespace core {
             }
 
             uint64_t start_time = read_wgt ? *this->global_cycle : 0;
+            const auto &bank_steps = wgt_bank_reads.steps(WGT_ADDRS_PER_ACCESS, wgt_reads);
             for (int lvl = 0; lvl < WGT_LEVELS; ++lvl) {
 
-                auto bank_steps = 0;
-                for (const auto &reads : bank_addr_reads[lvl]) {
-                    auto bank_reads = ceil(reads / (double)WGT_ADDRS_PER_ACCESS);
-                    wgt_reads[lvl] += bank_reads;
-                    if (bank_reads > bank_steps)
-                        bank_steps = bank_reads;
-                }
-
-                start_time += bank_steps * WGT_READ_DELAY[lvl];
-                wgt_bank_conflicts[lvl] += bank_steps > 0 ? bank_steps - 1 : 0;
+                start_time += bank_steps[lvl] * WGT_READ_DELAY[lvl];
+                wgt_bank_conflicts[lvl] += bank_steps[lvl] > 0 ? bank_steps[lvl] - 1 : 0;
 
             }
 
@@ -384,7 +409,8 @@ namespace core {
     template <typename T>
     void GlobalBuffer<T>::write_request(const std::shared_ptr<TilesData<T>> &tiles_data) {
 
-        auto bank_addr_writes = std::vector<std::vector<int>>(ACT_LEVELS, std::vector<int>(OUT_BANKS, 0));
+        *current_step = std::max(*current_step, tiles_data->step);
+        out_bank_writes.clear();
 
         for (const auto &tile_data : tiles_data->data) {
 
@@ -412,13 +438,13 @@ namespace core {
                 }
 
                 const auto &out_lvl = (*this->tracked_data).at(out_addr);
-                const auto &out_bank = tile_data.out_banks[idx];
+                assert(tile_data.out_banks[idx] != -1);
+                auto out_bank = tile_data.out_banks[idx] % OUT_BANKS;
 
-                assert(out_bank != -1);
                 assert(out_lvl >= 1 && out_lvl <= ACT_LEVELS);
 
                 for (int lvl = ACT_LEVELS; lvl >= out_lvl; --lvl) {
-                    bank_addr_writes[lvl - 1][out_bank]++;
+                    out_bank_writes.increment(lvl - 1, out_bank);
 
                     if (lvl != 1 && out_lvl != ACT_LEVELS) {
                         if (!out_eviction_policy[lvl - 1][out_bank]->free_entry()) {
@@ -437,18 +463,11 @@ namespace core {
         }
 
         uint64_t start_time = std::max(*this->global_cycle, psum_read_ready_cycle);
+        const auto &bank_steps = out_bank_writes.steps(ACT_ADDRS_PER_ACCESS, out_writes);
         for (int lvl = 0; lvl < ACT_LEVELS; ++lvl) {
 
-            auto bank_steps = 0;
-            for (const auto &writes : bank_addr_writes[lvl]) {
-                auto bank_writes = ceil(writes / (double)ACT_ADDRS_PER_ACCESS);
-                out_writes[lvl] += bank_writes;
-                if (bank_writes > bank_steps)
-                    bank_steps = bank_writes;
-            }
-
-            start_time += bank_steps * ACT_WRITE_DELAY[lvl];
-            out_bank_conflicts[lvl] += bank_steps > 0 ? bank_steps - 1 : 0;
+            start_time += bank_steps[lvl] * ACT_WRITE_DELAY[lvl];
+            out_bank_conflicts[lvl] += bank_steps[lvl] > 0 ? bank_steps[lvl] - 1 : 0;
 
         }
 
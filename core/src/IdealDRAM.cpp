@@ -0,0 +1,31 @@
+
+#include <core/IdealDRAM.h>
+
+namespace core {
+
+    std::string IdealDRAM::name() {
+        return "Ideal";
+    }
+
+    bool IdealDRAM::will_accept_transaction() {
+        return true;
+    }
+
+    void IdealDRAM::add_transaction(uint64_t address, bool isWrite) {
+        in_flight.emplace_back(address, isWrite);
+    }
+
+    void IdealDRAM::cycle() {
+        if (in_flight.empty())
+            return;
+
+        // Callbacks may send new transactions for the next cycle
+        auto completed = std::vector<std::tuple<uint64_t, bool>>();
+        completed.swap(in_flight);
+        for (const auto &transaction : completed) {
+            if (std::get<1>(transaction)) write_done(std::get<0>(transaction));
+            else read_done(std::get<0>(transaction));
+        }
+    }
+
+}
@@ -3,32 +3,82 @@
 
 namespace core {
 
+    void LRU::unlink(uint32_t slot) {
+        if (prev[slot] != NULL_SLOT) next[prev[slot]] = next[slot];
+        else head = next[slot];
+        if (next[slot] != NULL_SLOT) prev[next[slot]] = prev[slot];
+        else tail = prev[slot];
+    }
+
+    void LRU::push_front(uint32_t slot) {
+        prev[slot] = NULL_SLOT;
+        next[slot] = head;
+        if (head != NULL_SLOT) prev[head] = slot;
+        else tail = slot;
+        head = slot;
+    }
+
     void LRU::flush() {
-        data.clear();
+        head = NULL_SLOT;
+        tail = NULL_SLOT;
+        size = 0;
         lru.clear();
+
+        // Chain all the allocated slots in the free list
+        free_slots = NULL_SLOT;
+        for (auto slot = (uint32_t)addrs.size(); slot > 0; --slot) {
+            next[slot - 1] = free_slots;
+            free_slots = slot - 1;
+        }
     }
 
     bool LRU::free_entry() {
-        return data.size() < this->MAX_SIZE;
+        return size < this->MAX_SIZE;
     }
 
     void LRU::insert_addr(uint64_t addr) {
-        data.push_front(addr);
-        lru[addr] = data.begin();
+        auto slot = lru.find(addr);
+        if (slot != NULL_SLOT) {
+            unlink(slot);
+            push_front(slot);
+            return;
+        }
+
+        if (free_slots != NULL_SLOT) {
+            slot = free_slots;
+            free_slots = next[slot];
+        } else {
+            assert(addrs.size() < NULL_SLOT);
+            slot = (uint32_t)addrs.size();
+            addrs.push_back(0);
+            prev.push_back(NULL_SLOT);
+            next.push_back(NULL_SLOT);
+        }
+
+        addrs[slot] = addr;
+        push_front(slot);
+        lru.insert(addr, slot);
+        size++;
     }
 
     uint64_t LRU::evict_addr() {
-        assert(!data.empty());
-        assert(!lru.empty());
-        auto last = data.back();
-        data.pop_back();
+        assert(size > 0);
+        auto slot = tail;
+        auto last = addrs[slot];
+        unlink(slot);
+        next[slot] = free_slots;
+        free_slots = slot;
         lru.erase(last);
+        size--;
         return last;
     }
 
     void LRU::update_status(uint64_t addr) {
-        data.erase(lru[addr]);
-        insert_addr(addr);
+        auto slot = lru.find(addr);
+        if (slot == NULL_SLOT)
+            return;
+        unlink(slot);
+        push_front(slot);
     }
 
 }
@@ -0,0 +1,59 @@
+
+#include <core/OPT.h>
+
+namespace core {
+
+    void OPT::flush() {
+        addrs.clear();
+        next_uses.clear();
+        positions.clear();
+    }
+
+    bool OPT::free_entry() {
+        return addrs.size() < this->MAX_SIZE;
+    }
+
+    void OPT::insert_addr(uint64_t addr) {
+        auto pos = positions.find(addr);
+        if (pos != NULL_SLOT) {
+            next_uses[pos] = future->next(addr, *now);
+            return;
+        }
+
+        positions.insert(addr, (uint32_t)addrs.size());
+        addrs.push_back(addr);
+        next_uses.push_back(future->next(addr, *now));
+    }
+
+    uint64_t OPT::evict_addr() {
+        assert(!addrs.empty());
+
+        uint64_t victim = 0;
+        for (uint64_t pos = 0; pos < addrs.size(); ++pos) {
+            if (next_uses[pos] <= *now)
+                next_uses[pos] = future->next(addrs[pos], *now);
+            if (next_uses[pos] > next_uses[victim])
+                victim = pos;
+            if (next_uses[victim] == NEVER_USED)
+                break;
+        }
+
+        auto addr = addrs[victim];
+        positions.erase(addr);
+        if (victim != addrs.size() - 1) {
+            addrs[victim] = addrs.back();
+            next_uses[victim] = next_uses.back();
+            positions.insert(addrs[victim], (uint32_t)victim);
+        }
+        addrs.pop_back();
+        next_uses.pop_back();
+        return addr;
+    }
+
+    void OPT::update_status(uint64_t addr) {
+        auto pos = positions.find(addr);
+        if (pos != NULL_SLOT)
+            next_uses[pos] = future->next(addr, *now);
+    }
+
+}
@@ -140,20 +140,59 @@ namespace core {
         act_address_map = std::vector<std::vector<std::vector<uint64_t>>>(Ny, std::vector<std::vector<uint64_t>>(Nx,
                 std::vector<uint64_t>(channel_blks)));
 
-        // Column third
-        for (int y = 0; y < Ny; ++y) {
-
-            // Row second
-            for (int x = 0; x < Nx; ++x) {
+        // Channel blocks stored together: all of them for NHWC, one plane per block for NCHW, one plane per group
+        // of the blocks read in an on-chip step for NCHWc
+        auto values_per_block = this->dram->getActValuesPerBlock();
+        const auto &layout = this->dram->getLayout();
+        uint64_t group_blks = channel_blks;
+        if (layout == "NCHW") group_blks = 1;
+        else if (layout == "NCHWc")
+            group_blks = std::min((uint64_t)ceil(this->EF_LANES / (double)values_per_block), (uint64_t)channel_blks);
+
+        // Channel group fourth
+        uint64_t line_bits = 0;
+        auto start_address = this->dram->getStartActAddress();
+        for (uint64_t g = 0; g < channel_blks; g += group_blks) {
+            auto end_blk = std::min(g + group_blks, (uint64_t)channel_blks);
+            auto position_size = (end_blk - g) * this->dram->getWidth();
+
+            // Column third
+            for (int y = 0; y < Ny; ++y) {
+                this->dram->align_unit(start_address, next_act_address, line_bits, Nx * position_size);
+
+                // Row second
+                for (int x = 0; x < Nx; ++x) {
+                    this->dram->align_unit(start_address, next_act_address, line_bits, position_size);
+
+                    // Store channel-first
+                    for (auto k = g; k < end_blk; ++k) {
+                        auto values = std::vector<T>();
+                        if (this->dram->compression()) {
+                            auto last_ch = std::min((k + 1) * values_per_block, act_channels);
+                            for (auto ch = k * values_per_block; ch < last_ch; ++ch)
+                                values.push_back(this->_3dim ? this->act->get(0, 0, ch) :
+                                        this->act->get(0, ch, x, y));
+                        }
 
-                // Store channel-first
-                for (int k = 0; k < channel_blks; ++k) {
-                    act_address_map[y][x][k] = this->dram->getStartActAddress() + next_act_address;
-                    next_act_address += this->dram->getWidth();
+                        auto bits = this->dram->block_bits(values, this->dram->getActDataSize(),
+                                this->act->isSigned());
+                        act_address_map[y][x][k] = start_address +
+                                this->dram->pack_block(bits, next_act_address, line_bits);
+                    }
                 }
             }
         }
+        this->dram->close_line(next_act_address, line_bits);
+
+        // The row-aligned layout leaves gaps between the rows, so the whole layer is not a single range
+        auto act_addresses = std::vector<uint64_t>();
+        act_addresses.reserve(Ny * Nx * channel_blks);
+        for (const auto &row : act_address_map)
+            for (const auto &position : row)
+                act_addresses.insert(act_addresses.end(), position.begin(), position.end());
+        act_layer_addresses = this->dram->compress_addresses(act_addresses);
 
+        // Bank slots, the global buffer interleaves them over its banks
         act_bank_map = ActBankMap(Ny, std::vector<int>(Nx));
 
         int bank = 0;
@@ -164,7 +203,7 @@ namespace core {
                     bank = bkp_bank;
 
                 act_bank_map[y][x] = bank;
-                bank = (bank + 1) % this->gbuffer->getActBanks();
+                bank++;
 
                 if (y % this->stride == 0 && x == out_x * this->stride - 1)
                     bkp_bank = bank;
@@ -173,6 +212,21 @@ namespace core {
 
     }
 
+    template <typename T>
+    std::vector<T> OutputStationary<T>::weight_block(const BufferRow<T> &row, uint64_t access) {
+        auto values_per_block = this->dram->getWgtValuesPerBlock();
+        auto blocks_per_filter = (uint64_t)ceil(this->EF_LANES / (double)values_per_block);
+
+        auto start_lane = (access % blocks_per_filter) * values_per_block;
+        auto end_lane = std::min(start_lane + values_per_block, (uint64_t)this->EF_LANES);
+        auto filter_pos = access / blocks_per_filter;
+
+        auto values = std::vector<T>();
+        for (auto lane = start_lane; lane < end_lane; ++lane)
+            values.push_back(std::get<0>(row[filter_pos * this->EF_LANES + lane]));
+        return values;
+    }
+
     template <typename T>
     void OutputStationary<T>::fill_weight_buffer() {
 
@@ -238,6 +292,7 @@ namespace core {
         // Addresses buffer
         auto accesses_per_filter = (uint64_t)ceil(this->EF_LANES / (double)this->dram->getWgtValuesPerBlock())
                 * this->EF_ROWS;//har lane ba har bar dastresi be bafer 4(wgt value per block) ta wgt ra mikhanad
+        auto value_accesses = accesses_per_filter;
         if (this->arch->schedule()) accesses_per_filter += (uint64_t)ceil(this->EF_LANES *
                 this->scheduler->getMetadataBits() / (double)this->dram->getWidth()) * this->EF_ROWS;
         wgt_address_buffer = AddressBuffer(filter_sets * groups, AddressBufferSet(max_buffer_time,
@@ -247,6 +302,8 @@ namespace core {
         auto filter_sets_per_set = ceil(filter_sets / (double)tiles);
         wgt_address_map = std::vector<AddressRange>(filter_sets_per_set * groups, AddressRange());
 
+        uint64_t line_bits = 0;
+
         // Filter Set third
         for (int g = 0; g < groups; ++g) {
 
@@ -277,12 +334,22 @@ namespace core {
 
                         // Buffer width first
                         for (int x = 0; x < accesses_per_filter; ++x) {
-                            this->wgt_address_buffer[mm][y][x] = this->dram->getStartWgtAddress() + next_wgt_address;
-                            next_wgt_address += this->dram->getWidth();
+                            // The BitTactical schedule metadata is stored dense
+                            auto bits = this->dram->getWidth();
+                            if (x < value_accesses) {
+                                auto values = std::vector<T>();
+                                if (this->dram->compression())
+                                    values = weight_block(this->weight_buffer[mm][y], x);
+                                bits = this->dram->block_bits(values, this->dram->getWgtDataSize(), this->wgt->isSigned());
+                            }
+
+                            this->wgt_address_buffer[mm][y][x] = this->dram->getStartWgtAddress() +
+                                    this->dram->pack_block(bits, next_wgt_address, line_bits);
                         }
 
                     }
                 }
+                this->dram->close_line(next_wgt_address, line_bits);
 
                 std::get<1>(wgt_address_map[g * filter_sets_per_set + m / tiles]) =
                         this->dram->getStartWgtAddress() + next_wgt_address - this->dram->getWidth();
@@ -291,7 +358,7 @@ namespace core {
         }
 
 
-        // Banks buffer
+        // Banks buffer with the bank slots, the global buffer interleaves them over its banks
         wgt_bank_buffer = BankBuffer(filter_sets * groups, BankBufferSet(max_buffer_time,
                 BankBufferRow(accesses_per_filter)));
         wgt_end_time = std::vector<uint64_t>(filter_sets * groups, 0);
@@ -317,7 +384,7 @@ namespace core {
                     this->wgt_bank_buffer[m][y][f] = bank;
                 }
 
-                bank = (bank + 1) % this->gbuffer->getWgtBanks();
+                bank++;
 
             }
         }
@@ -17,6 +17,28 @@ namespace core {
         *global_cycle += delay;
     }
 
+    template <typename T>
+    void PPU<T>::configure_layer() {
+        ready_cycle = 0;
+    }
+
+    template <typename T>
+    bool PPU<T>::stream() const {
+        return STREAM;
+    }
+
+    template <typename T>
+    void PPU<T>::stream_outputs(uint64_t outputs) {
+        auto input_steps = (uint64_t)ceil(outputs / (double)INPUTS);
+        ready_cycle = std::max(ready_cycle, *global_cycle) + input_steps * DELAY;
+    }
+
+    template <typename T>
+    void PPU<T>::wait_outputs() {
+        if (ready_cycle > *global_cycle)
+            *global_cycle = ready_cycle;
+    }
+
     INITIALISE_DATA_TYPES(PPU);
 
 }
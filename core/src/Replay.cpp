@@ -0,0 +1,111 @@
+
+#include <core/Replay.h>
+
+namespace core {
+
+    template <typename T>
+    void NodeTrace<T>::record_step(const TilesData<T> &tiles_data) {
+        auto step = std::make_shared<TilesData<T>>(tiles_data.data.size());
+        step->read_act = tiles_data.read_act;
+        step->read_psum = tiles_data.read_psum;
+        step->read_wgt = tiles_data.read_wgt;
+        step->step = tiles_data.step;
+        step->set_start = tiles_data.set_start;
+        step->set_measured = tiles_data.set_measured;
+        step->set_warm = tiles_data.set_warm;
+
+        for (int t = 0; t < tiles_data.data.size(); ++t) {
+            const auto &tile_data = tiles_data.data[t];
+            auto &recorded = step->data[t];
+            recorded.valid = tile_data.valid;
+
+            // Only the number of windows and filters is replayed, to count the outputs
+            recorded.windows.resize(tile_data.windows.size());
+            recorded.filters.resize(tile_data.filters.size());
+            recorded.act_addresses = tile_data.act_addresses;
+            recorded.wgt_addresses = tile_data.wgt_addresses;
+            recorded.psum_addresses = tile_data.psum_addresses;
+            recorded.out_addresses = tile_data.out_addresses;
+            recorded.act_banks = tile_data.act_banks;
+            recorded.psum_banks = tile_data.psum_banks;
+            recorded.wgt_banks = tile_data.wgt_banks;
+            recorded.out_banks = tile_data.out_banks;
+        }
+
+        steps.push_back(step);
+    }
+
+    INITIALISE_DATA_TYPES(NodeTrace);
+
+    /* AUXILIARY FUNCTIONS */
+
+    template <typename T>
+    std::string Replay<T>::name() {
+        return arch->name();
+    }
+
+    template <typename T>
+    void Replay<T>::replay_layer(const LayerTrace<T> &_trace) {
+        trace = &_trace;
+        step = 0;
+        this->scheduled_pe = trace->scheduled_pe;
+        this->idle_pe = trace->idle_pe;
+    }
+
+    template <typename T>
+    uint64_t Replay<T>::getCycles() const {
+        return trace ? trace->compute_cycles : 0;
+    }
+
+    /* CYCLES */
+
+    template <typename T>
+    std::string Replay<T>::filename() {
+        return arch->filename();
+    }
+
+    template <typename T>
+    std::string Replay<T>::header() {
+        return arch->header();
+    }
+
+    template <typename T>
+    bool Replay<T>::diffy() {
+        return arch->diffy();
+    }
+
+    template <typename T>
+    bool Replay<T>::schedule() {
+        return arch->schedule();
+    }
+
+    template <typename T>
+    void Replay<T>::process_tiles(const std::shared_ptr<TilesData<T>> &) {
+        if (step >= trace->delays.size())
+            throw std::runtime_error("Memory trace has fewer compute steps than replayed");
+
+        const auto &delay = trace->delays[step++];
+        this->ready_cycle = *this->global_cycle + delay.first;
+        this->done_cycle = *this->global_cycle + delay.second;
+    }
+
+    /* POTENTIALS */
+
+    template <typename T>
+    std::string Replay<T>::filename_pot() {
+        return "";
+    }
+
+    template <typename T>
+    std::string Replay<T>::header_pot() {
+        return "";
+    }
+
+    template <typename T>
+    uint16_t Replay<T>::computeBits(T, T) {
+        throw std::runtime_error("Replay architecture has no potentials");
+    }
+
+    INITIALISE_DATA_TYPES(Replay);
+
+}
@@ -220,8 +220,8 @@ namespace core {
 
             if (!QUIET) std::cout << "Simulating layer: " << layer.getName() << std::endl;
 
-            base::Array<T> act = layer.getActivations();
-            base::Array<T> wgt = layer.getWeights();
+            base::Array<T> act = network.getActivations(layer_it);
+            base::Array<T> wgt = network.getWeights(layer_it);
             if(wgt.getDimensions() == 2) wgt.reshape_to_4D();
 
             if(fc || act.getDimensions() == 2) {
@@ -96,37 +96,177 @@ namespace core {
     /* CYCLES */
 
     template <typename T>
-    void Simulator<T>::run(const base::Network<T> &network, const std::shared_ptr<Control<T>> &control) {
+    double Simulator<T>::relative_interval(const std::vector<double> &values) {
+        if (values.size() < 2) return 0;
+        auto mean = sys::get_average(values);
+        if (mean == 0) return 0;
+        auto t = sys::get_t_value(ADAPTIVE_CONFIDENCE, values.size() - 1);
+        return t * sys::get_stdev(values) / sqrt(values.size()) / mean;
+    }
 
-        // Get components from control
-        auto dram = control->getDram();
-        auto gbuffer = control->getGbuffer();
-        auto abuffer = control->getAbuffer();
-        auto pbuffer = control->getPbuffer();
-        auto wbuffer = control->getWbuffer();
-        auto obuffer = control->getObuffer();
-        auto composer = control->getComposer();
-        auto ppu = control->getPPU();
-        auto arch = control->getArch();
+    template <typename T>
+    void Simulator<T>::cycle_pipeline(Pipeline<T> &pipeline, const std::shared_ptr<Control<T>> &control,
+            bool layer_act_on_chip, LayerTrace<T> *trace) {
+
+        const auto &gbuffer = control->getGbuffer();
+        const auto &abuffer = control->getAbuffer();
+        const auto &pbuffer = control->getPbuffer();
+        const auto &wbuffer = control->getWbuffer();
+        const auto &obuffer = control->getObuffer();
+        const auto &composer = control->getComposer();
+        const auto &dram = control->getDram();
+        const auto &arch = control->getArch();
+
+        if (pipeline.isValid(WRITEBACK_III) && gbuffer->write_done()) {
+            obuffer->erase();
+            pipeline.end_stage(WRITEBACK_III);
+        }
 
-        //paria
-        float primaryRow = arch->primaryRow();
-        float primaryColumn = arch->primaryColumn();
-        float primaryLane = arch->primaryLane();
+        if (pipeline.isValid(WRITEBACK_II) && pipeline.isFree(WRITEBACK_III) && obuffer->write_done()) {
+            const auto &tiles_data = pipeline.getData(WRITEBACK_II);
+            gbuffer->write_request(tiles_data);
+            if (control->getPPU()->stream()) {
+                auto outputs = control->calculate_step_outputs(tiles_data);
+                control->getPPU()->stream_outputs(outputs);
+                dram->write_request(outputs);
+            }
+            pipeline.move_stage(WRITEBACK_II);
+        }
 
-        if(!QUIET) std::cout << "Starting cycles simulation for architecture " << arch->name() << std::endl;
+        if (pipeline.isValid(WRITEBACK_I) && pipeline.isFree(WRITEBACK_II) && arch->flush()) {
+            const auto &tiles_data = pipeline.getData(WRITEBACK_I);
+            auto delay = composer->calculate_delay(tiles_data);
+            obuffer->write_request(delay);
+            obuffer->insert();
+            pipeline.move_stage(WRITEBACK_I);
+        }
 
-        if ( noSource == true )
-        {
-            noSourceDNNs(control);
+        if (pipeline.isValid(EXECUTION) && obuffer->isFree() && abuffer->data_ready() && pbuffer->data_ready() &&
+                wbuffer->data_ready() && arch->ready()) {
+            const auto &tiles_data = pipeline.getData(EXECUTION);
+            arch->process_tiles(tiles_data);
+            if (trace) {
+                auto now = control->getCycles();
+                auto ready = arch->getReadyCycle(), done = arch->getDoneCycle();
+                trace->delays.emplace_back(ready > now ? ready - now : 0, done > now ? done - now : 0);
+            }
+            abuffer->erase(tiles_data->read_act);
+            pbuffer->erase(tiles_data->read_psum);
+            wbuffer->erase(tiles_data->read_wgt);
+            if (control->check_if_write_output(tiles_data)) pipeline.move_stage(EXECUTION);
+            else pipeline.end_stage(EXECUTION);
+        }
+
+        if (pipeline.isValid(MEMORY_II) && pipeline.isFree(EXECUTION) && gbuffer->data_ready()) {
+            const auto &tiles_data = pipeline.getData(MEMORY_II);
+            abuffer->read_request(tiles_data->read_act);
+            pbuffer->read_request(tiles_data->read_psum);
+            wbuffer->read_request(tiles_data->read_wgt);
+            pipeline.move_stage(MEMORY_II);
         }
-        else
-            {
+
+        if (pipeline.isValid(MEMORY_I) && dram->data_ready() && abuffer->isFree() && pbuffer->isFree() &&
+                wbuffer->isFree()) {
+            const auto &tiles_data = pipeline.getData(MEMORY_I);
+            gbuffer->act_read_request(tiles_data, layer_act_on_chip, tiles_data->read_act);
+            gbuffer->psum_read_request(tiles_data, tiles_data->read_psum);
+            gbuffer->wgt_read_request(tiles_data, tiles_data->read_wgt);
+            abuffer->insert(tiles_data->read_act);
+            pbuffer->insert(tiles_data->read_psum);
+            wbuffer->insert(tiles_data->read_wgt);
+            pipeline.move_stage(MEMORY_I);
+        }
+
+    }
+
+    template <typename T>
+    void Simulator<T>::skip_sets(const std::shared_ptr<Control<T>> &control, uint64_t sets) {
+        auto cycles = control->skip_sets(sets);
+        for (; cycles > 0 && control->getDram()->busy(); --cycles)
+            control->cycle();//global_cycle++
+        control->skip_cycles(cycles);
+    }
+
+    template <typename T>
+    void Simulator<T>::run(const base::Network<T> &network, const std::shared_ptr<Control<T>> &control) {
+        run(network, std::vector<std::shared_ptr<Control<T>>>(1, control));
+    }
+
+    template <typename T>
+    void Simulator<T>::run(const base::Network<T> &network,
+            const std::vector<std::shared_ptr<Control<T>>> &controls, const std::shared_ptr<MemoryTrace<T>> &trace) {
+
+        if (trace && controls.size() != 1)
+            throw std::runtime_error("Memory traces can only be recorded for one architecture");
+
+        /** Cycles statistics for one architecture */
+        struct CycleStats {
+
+            /** Statistics file */
+            std::shared_ptr<sys::Stats> stats;
+
+            // Time stats
+            std::shared_ptr<sys::stat_uint_t> cycles, compute_cycles;
+
+            // Sampling stats
+            std::shared_ptr<sys::stat_double_t> estimated_cycles, estimated_cycles_interval, simulated_fraction;
+
+            // Mapping stats
+            std::shared_ptr<sys::stat_string_t> mapping;
+            std::shared_ptr<sys::stat_uint_t> estimated_dram_traffic;
+
+            // Architecture stats
+            std::shared_ptr<sys::stat_uint_t> scheduled_pe, idle_pe;
+
+            // DRAM stats
+            std::shared_ptr<sys::stat_uint_t> dram_act_reads, dram_psum_reads, dram_wgt_reads, dram_out_writes;
+
+            // Global Buffer stats
+            std::vector<std::shared_ptr<sys::stat_uint_t>> gbuffer_act_reads, gbuffer_psum_reads, gbuffer_wgt_reads,
+                    gbuffer_out_writes;
+            std::vector<std::shared_ptr<sys::stat_uint_t>> gbuffer_act_bank_conflicts, gbuffer_psum_bank_conflicts,
+                    gbuffer_wgt_bank_conflicts, gbuffer_out_bank_conflicts;
+
+            // Layer stats
+            std::shared_ptr<sys::stat_uint_t> act_precision, wgt_precision, activation_channel, outputWindows,
+                    number_filters, lanes, columns, rows, Kxw, Kyw;
+
+            //Paria-all computes
+            std::shared_ptr<sys::stat_uint_t> computeNumbers, allPEclocked;
+
+            // Adaptive number of samples stats
+            std::shared_ptr<sys::stat_double_t> cycles_interval;
+
+            /** Per layer cycles of the simulated samples */
+            std::vector<std::vector<double>> sampled_cycles;
+
+            //paria
+            float primaryRow = 0, primaryColumn = 0, primaryLane = 0;
+        };
+
+        auto batch_size = this->FAST_MODE ? 1 : network.getBatchSize();
+        auto all_stats = std::vector<CycleStats>(controls.size());
+        if (trace) trace->layers = std::vector<std::vector<LayerTrace<T>>>(batch_size,
+                std::vector<LayerTrace<T>>(network.getNumLayers()));
+
+        for (int c = 0; c < controls.size(); ++c) {
+
+            const auto &control = controls[c];
+            const auto &gbuffer = control->getGbuffer();
+            const auto &arch = control->getArch();
+            auto &cs = all_stats[c];
+
+            //paria
+            cs.primaryRow = arch->primaryRow();
+            cs.primaryColumn = arch->primaryColumn();
+            cs.primaryLane = arch->primaryLane();
+
+            if(!QUIET) std::cout << "Starting cycles simulation for architecture " << arch->name() << std::endl;
+
             // Initialize statistics
             //std::string filename = arch->name() + gbuffer->filename() + arch->filename() + "_cycles";
             // Initialize statistics
             std::string filename = "";
-            auto batch_size = this->FAST_MODE ? 1 : network.getBatchSize();
 
             if (RowConfig == true && ColConfig == true) {
                 filename = "full_Config_" + arch->name() + "_" + network.getName() + arch->filename() + "_BatchSize" +
@@ -155,130 +295,166 @@ namespace core {
                            ;
             }
 
-
-            sys::Stats stats = sys::Stats(network.getNumLayers(), batch_size, filename);
-
+            cs.stats = std::make_shared<sys::Stats>(network.getNumLayers(), batch_size, filename);
+            auto &stats = *cs.stats;
 
             // Time stats
-            auto cycles = stats.register_uint_t("cycles", 0, sys::AverageTotal);
-            auto compute_cycles = stats.register_uint_t("compute_cycles", 0, sys::AverageTotal);
+            cs.cycles = stats.register_uint_t("cycles", 0, sys::AverageTotal);
+            cs.compute_cycles = stats.register_uint_t("compute_cycles", 0, sys::AverageTotal);
+
+            // Sampling stats
+            if (control->sampling()) {
+                cs.estimated_cycles = stats.register_double_t("estimated_cycles", 0, sys::AverageTotal);
+                cs.estimated_cycles_interval = stats.register_double_t("estimated_cycles_interval", 0,
+                        sys::AverageTotal);
+                cs.simulated_fraction = stats.register_double_t("simulated_fraction", 0, sys::Average);
+            }
+
+            // Mapping stats
+            if (control->mapping_search()) {
+                cs.mapping = stats.register_string_t("mapping", sys::No_Measure);
+                cs.estimated_dram_traffic = stats.register_uint_t("estimated_dram_traffic", 0, sys::AverageTotal);
+            }
 
             // Architecture stats
-            auto scheduled_pe = stats.register_uint_t("scheduled PEs", 0, sys::AverageTotal);
-            auto idle_pe = stats.register_uint_t("idle PEs", 0, sys::AverageTotal);
+            cs.scheduled_pe = stats.register_uint_t("scheduled PEs", 0, sys::AverageTotal);
+            cs.idle_pe = stats.register_uint_t("idle PEs", 0, sys::AverageTotal);
             //auto idle_lanes = stats.register_uint_t("idle Lanes", 0, sys::AverageTotal);
 
             // DRAM stats
-            auto dram_act_reads = stats.register_uint_t("dram_act_reads", 0, sys::AverageTotal);
-            auto dram_psum_reads = stats.register_uint_t("dram_psum_reads", 0, sys::AverageTotal);
-            auto dram_wgt_reads = stats.register_uint_t("dram_wgt_reads", 0, sys::AverageTotal);
-            auto dram_out_writes = stats.register_uint_t("dram_out_writes", 0, sys::AverageTotal);
+            cs.dram_act_reads = stats.register_uint_t("dram_act_reads", 0, sys::AverageTotal);
+            cs.dram_psum_reads = stats.register_uint_t("dram_psum_reads", 0, sys::AverageTotal);
+            cs.dram_wgt_reads = stats.register_uint_t("dram_wgt_reads", 0, sys::AverageTotal);
+            cs.dram_out_writes = stats.register_uint_t("dram_out_writes", 0, sys::AverageTotal);
 
             // Global Buffer stats
-            auto gbuffer_act_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
-            auto gbuffer_psum_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
-            auto gbuffer_wgt_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getWgtLevels());
-            auto gbuffer_out_writes = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+            cs.gbuffer_act_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+            cs.gbuffer_psum_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+            cs.gbuffer_wgt_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getWgtLevels());
+            cs.gbuffer_out_writes = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
 
             for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
-                gbuffer_act_reads[lvl] =
+                cs.gbuffer_act_reads[lvl] =
                         stats.register_uint_t("gbuffer_act_reads." + std::to_string(lvl), 0, sys::AverageTotal);
             }
 
             for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
-                gbuffer_psum_reads[lvl] =
+                cs.gbuffer_psum_reads[lvl] =
                         stats.register_uint_t("gbuffer_psum_reads." + std::to_string(lvl), 0, sys::AverageTotal);
             }
 
             for (int lvl = 0; lvl < gbuffer->getWgtLevels(); ++lvl) {
-                gbuffer_wgt_reads[lvl] =
+                cs.gbuffer_wgt_reads[lvl] =
                         stats.register_uint_t("gbuffer_wgt_reads." + std::to_string(lvl), 0, sys::AverageTotal);
             }
 
             for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
-                gbuffer_out_writes[lvl] =
+                cs.gbuffer_out_writes[lvl] =
                         stats.register_uint_t("gbuffer_out_writes." + std::to_string(lvl), 0, sys::AverageTotal);
             }
 
-            auto gbuffer_act_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
-            auto gbuffer_psum_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
-            auto gbuffer_wgt_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getWgtLevels());
-            auto gbuffer_out_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+            cs.gbuffer_act_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+            cs.gbuffer_psum_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+            cs.gbuffer_wgt_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getWgtLevels());
+            cs.gbuffer_out_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
 
             for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
-                gbuffer_act_bank_conflicts[lvl] =
+                cs.gbuffer_act_bank_conflicts[lvl] =
                         stats.register_uint_t("gbuffer_act_bank_conflicts." + std::to_string(lvl), 0,
                                               sys::AverageTotal);
             }
 
             for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
-                gbuffer_psum_bank_conflicts[lvl] =
+                cs.gbuffer_psum_bank_conflicts[lvl] =
                         stats.register_uint_t("gbuffer_psum_bank_conflicts." + std::to_string(lvl), 0,
                                               sys::AverageTotal);
             }
 
             for (int lvl = 0; lvl < gbuffer->getWgtLevels(); ++lvl) {
-                gbuffer_wgt_bank_conflicts[lvl] =
+                cs.gbuffer_wgt_bank_conflicts[lvl] =
                         stats.register_uint_t("gbuffer_wgt_bank_conflicts." + std::to_string(lvl), 0,
                                               sys::AverageTotal);
             }
 
             for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
-                gbuffer_out_bank_conflicts[lvl] =
+                cs.gbuffer_out_bank_conflicts[lvl] =
                         stats.register_uint_t("gbuffer_out_bank_conflicts." + std::to_string(lvl), 0,
                                               sys::AverageTotal);
             }
 
-            auto act_precision = stats.register_uint_t("activations precision", 0, sys::Average);
-            auto wgt_precision = stats.register_uint_t("weights precision", 0, sys::Average);
+            cs.act_precision = stats.register_uint_t("activations precision", 0, sys::Average);
+            cs.wgt_precision = stats.register_uint_t("weights precision", 0, sys::Average);
 
-            auto activation_channel = stats.register_uint_t("activations channel(N)", 0, sys::Average);
+            cs.activation_channel = stats.register_uint_t("activations channel(N)", 0, sys::Average);
 //        auto weigth_channel = stats.register_uint_t("weights channel(N)", 0, sys::Average);
 
-            auto outputWindows = stats.register_uint_t("Output Windows (M)", 0, sys::Average);
+            cs.outputWindows = stats.register_uint_t("Output Windows (M)", 0, sys::Average);
 
-            auto number_filters = stats.register_uint_t("filter numbers(R)", 0, sys::Average);
+            cs.number_filters = stats.register_uint_t("filter numbers(R)", 0, sys::Average);
 
-            auto lanes = stats.register_uint_t("LANES", 0, sys::Average);
-            auto columns = stats.register_uint_t("COLUMNS", 0, sys::Average);
-            auto rows = stats.register_uint_t("ROWS", 0, sys::Average);
+            cs.lanes = stats.register_uint_t("LANES", 0, sys::Average);
+            cs.columns = stats.register_uint_t("COLUMNS", 0, sys::Average);
+            cs.rows = stats.register_uint_t("ROWS", 0, sys::Average);
 
-            auto Kxw = stats.register_uint_t("Kx", 0, sys::Average);
-            auto Kyw = stats.register_uint_t("Ky", 0, sys::Average);
+            cs.Kxw = stats.register_uint_t("Kx", 0, sys::Average);
+            cs.Kyw = stats.register_uint_t("Ky", 0, sys::Average);
 
             //Paria-all computes
-            auto computeNumbers = stats.register_uint_t("computeNumbers", 0, sys::AverageTotal);
-            auto allPEclocked = stats.register_uint_t("allPEclocked", 0, sys::AverageTotal);
+            cs.computeNumbers = stats.register_uint_t("computeNumbers", 0, sys::AverageTotal);
+            cs.allPEclocked = stats.register_uint_t("allPEclocked", 0, sys::AverageTotal);
+
+            // Adaptive number of samples stats
+            if (ADAPTIVE_ERROR > 0)
+                cs.cycles_interval = stats.register_double_t("cycles_relative_interval", 0, sys::Average);
+
+            cs.sampled_cycles = std::vector<std::vector<double>>(network.getNumLayers());
+        }
+
+        // Iterate over the samples
+        for (auto sample = 0; sample < batch_size; ++sample) {
 
-            // Iterate over the samples
-            for (auto sample = 0; sample < batch_size; ++sample) {
+            // Iterate over the layers
+            for (auto layer_it = 0; layer_it < network.getNumLayers(); ++layer_it) {
 
-                // Iterate over the layers
-                for (auto layer_it = 0; layer_it < network.getNumLayers(); ++layer_it) {
+                const base::Layer<T> &layer = network.getLayers()[layer_it];
+                bool conv = layer.getType() == "Convolution";
+                bool rnn = layer.getType() == "RNN";
+                bool fc = layer.getType() == "InnerProduct";
 
-                    const base::Layer<T> &layer = network.getLayers()[layer_it];
-                    bool conv = layer.getType() == "Convolution";
-                    bool rnn = layer.getType() == "RNN";
-                    bool fc = layer.getType() == "InnerProduct";
+                if (!QUIET)
+                    printf("\n Simulating sample: %d/%lu for layer: %s\n", sample + 1, batch_size,
+                           layer.getName().c_str());
 
-                    if (!QUIET)
-                        printf("\n Simulating sample: %d/%lu for layer: %s\n", sample + 1, batch_size,
-                               layer.getName().c_str());
+                // Architectures that go through the on-chip pipeline, the first one generates the dataflow steps
+                std::vector<int> pipelined;
+                std::vector<std::shared_ptr<base::Array<T>>> acts, wgts;
+                auto layer_trace = trace ? &trace->layers[sample][layer_it] : nullptr;
+                auto layer_act = network.getActivations(layer_it);
+                auto layer_wgt = network.getWeights(layer_it);
+                OutputTensor sim_output;
+                uint64_t Ox = 0, Oy = 0;
+                int stride = 0;
 
-                    auto act = std::make_shared<base::Array<T>>(layer.getActivations());
+                for (int c = 0; c < controls.size(); ++c) {
+
+                    const auto &control = controls[c];
+                    const auto &arch = control->getArch();
+                    auto &cs = all_stats[c];
+
+                    auto act = std::make_shared<base::Array<T>>(layer_act);
                     arch->dataConversion(*act);
                     if (fc && act->getDimensions() == 4) act->reshape_to_2D();
                     if (act->getDimensions() == 2) act->reshape_to_4D();
                     act->get_sample(sample);
 
-                    auto wgt = std::make_shared<base::Array<T>>(layer.getWeights());
+                    auto wgt = std::make_shared<base::Array<T>>(layer_wgt);
                     arch->dataConversion(*wgt);
 
                     if (!((network.getName() == "vgg_cnn_m_2048" || (arch->name() == "ShapeShifter")) && !conv )) {
                         if (wgt->getDimensions() == 2) wgt->reshape_to_4D();
                     }
                     int padding = layer.getPadding();
-                    int stride = layer.getStride();
+                    stride = layer.getStride();
 
                     if (conv) act->zero_pad(padding);
 
@@ -333,8 +509,8 @@ namespace core {
                       //  Ky = 1;
                     //}
 
-                    auto Ox = (Nx - Kx) / stride + 1;
-                    auto Oy = (Ny - Ky) / stride + 1;
+                    Ox = (Nx - Kx) / stride + 1;
+                    Oy = (Ny - Ky) / stride + 1;
 
                     auto act_prec = layer.getActPrecision();
                     auto wgt_prec = layer.getWgtPrecision();
@@ -353,195 +529,315 @@ namespace core {
                             arch->pariaApproach(act_channels, output_windows, num_filters, layer_it, RowConfig, ColConfig);
                         }
                     }
+
+                    cs.number_filters->value[layer_it][sample] = num_filters;
+
+                    cs.activation_channel->value[layer_it][sample] = wgt_channels;
+                    //weigth_channel->value[layer_it][image] = wgt_channels;
+
+                    cs.outputWindows->value[layer_it][sample] = output_windows;
+
+                    cs.Kxw->value[layer_it][sample] = Kx;
+                    cs.Kyw->value[layer_it][sample] = Ky;
+
+                    //paria
+                    cs.computeNumbers->value[layer_it][sample] = output_windows * num_filters * act_channels * Kx * Ky;
+
                     //Paria
                     if ((network.getName() == "vgg_cnn_m_2048"
                      || (arch->name() == "ShapeShifter")
                     ) && !conv ) {
                         // Dump stats
-                        compute_cycles->value[layer_it][sample] =
+                        cs.compute_cycles->value[layer_it][sample] =
                                 ceil((float) num_filters / (arch->getRows() * arch->getTiles())) * //ROW
                                 ceil((float) output_windows / arch->getColumns()) * //Columnn
                                 ceil((float) act_channels / arch->getLanes()) * Kx * Ky;
+                        cs.sampled_cycles[layer_it].push_back(cs.compute_cycles->value[layer_it][sample]);
+                        if (layer_trace) layer_trace->compute_cycles = cs.compute_cycles->value[layer_it][sample];
 
-                        number_filters->value[layer_it][sample] = num_filters;
+                        cs.lanes->value[layer_it][sample] = arch->getLanes();
+                        cs.columns->value[layer_it][sample] = arch->getColumns();
+                        cs.rows->value[layer_it][sample] = arch->getRows();
 
-                        activation_channel->value[layer_it][sample] = wgt_channels;
-                        //weigth_channel->value[layer_it][image] = wgt_channels;
+                        cs.allPEclocked->value[layer_it][sample] = arch->getallPEsclocked();
 
-                        outputWindows->value[layer_it][sample] = output_windows;
-
-                        lanes->value[layer_it][sample] = arch->getLanes();
-                        columns->value[layer_it][sample] = arch->getColumns();
-                        rows->value[layer_it][sample] = arch->getRows();
-                        Kxw->value[layer_it][sample] = Kx;
-                        Kyw->value[layer_it][sample] = Ky;
+                        //idle_pe->value[layer_it][sample] = arch->UnusedPEs(act_channels, output_windows, num_filters, Kx, Ky);
+                        cs.idle_pe->value[layer_it][sample] = arch->UnusedPEsandTiles(act_channels, output_windows, num_filters, Kx, Ky);
 
-                        //paria
-                        computeNumbers->value[layer_it][sample] = output_windows * num_filters * act_channels * Kx * Ky;
-                        allPEclocked->value[layer_it][sample] = arch->getallPEsclocked();
+                        //Paria back to defult dimention size
+                        arch->LANES = cs.primaryLane;
+                        arch->COLUMNS = cs.primaryColumn;
+                        arch->ROWS = cs.primaryRow;
 
-                        //idle_pe->value[layer_it][sample] = arch->UnusedPEs(act_channels, output_windows, num_filters, Kx, Ky);
-                        idle_pe->value[layer_it][sample] = arch->UnusedPEsandTiles(act_channels, output_windows, num_filters, Kx, Ky);
                     } else {
 
-                        control->configure_layer(act, wgt, act_prec, wgt_prec, fc || rnn, rnn, stride);
-
-                        OutputTensor sim_output = OutputTensor(num_filters, std::vector<std::vector<double>>(Ox,
-                                                                                                             std::vector<double>(
-                                                                                                                     Oy,
-                                                                                                                     0)));
-
-                        Pipeline<T> pipeline = Pipeline<T>(Stage::Last + 1);
-                        do {
-                            gbuffer->evict_data(control->getIfEvictAct(), control->getIfEvictOut(),
-                                                control->getIfEvictWgt());
-                            dram->read_data(control->getReadActAddresses(), control->getReadPsumAddresses(),
-                                            control->getReadWgtAddresses());
-
-                            auto init_data = TilesData<T>(arch->getTiles());
-                            bool still_data = control->still_on_chip_data(init_data);
-                            if (still_data) {
-                                if (this->CHECK) calculate_output(sim_output, init_data);
-                                dram->read_request(init_data, control->getIfLayerActOnChip());
-                                pipeline.fetch_data(init_data);
+                        // Only the first architecture traverses the dataflow, the others just configure the models
+                        if (pipelined.empty()) {
+                            control->configure_layer(act, wgt, act_prec, wgt_prec, fc || rnn, rnn, stride);
+                            if (layer_trace) {
+                                layer_trace->pipelined = true;
+                                layer_trace->signed_act = act->isSigned();
+                                layer_trace->signed_wgt = wgt->isSigned();
+                                layer_trace->act_prec = act_prec;
+                                layer_trace->wgt_prec = wgt_prec;
+                                layer_trace->linear = fc || rnn;
+                                layer_trace->rnn = rnn;
+                                layer_trace->stride = stride;
                             }
+                            if (this->CHECK) sim_output = OutputTensor(num_filters,
+                                    std::vector<std::vector<double>>(Ox, std::vector<double>(Oy, 0)));
+                        } else {
+                            control->Control<T>::configure_layer(act, wgt, act_prec, wgt_prec, fc || rnn, rnn,
+                                    stride);
+                        }
 
-                            while (still_data || !pipeline.isEmpty()) {
+                        cs.act_precision->value[layer_it][sample] = act_prec;
+                        cs.wgt_precision->value[layer_it][sample] = wgt_prec;
 
-                                if (pipeline.isValid(WRITEBACK_III) && gbuffer->write_done()) {
-                                    obuffer->erase();
-                                    pipeline.end_stage(WRITEBACK_III);
-                                }
+                        pipelined.push_back(c);
+                        acts.push_back(act);
+                        wgts.push_back(wgt);
+                    }
 
-                                if (pipeline.isValid(WRITEBACK_II) && pipeline.isFree(WRITEBACK_III) &&
-                                    obuffer->write_done()) {
-                                    const auto &tiles_data = pipeline.getData(WRITEBACK_II);
-                                    gbuffer->write_request(tiles_data);
-                                    pipeline.move_stage(WRITEBACK_II);
-                                }
+                }
 
-                                if (pipeline.isValid(WRITEBACK_I) && pipeline.isFree(WRITEBACK_II) && arch->flush()) {
-                                    const auto &tiles_data = pipeline.getData(WRITEBACK_I);
-                                    auto delay = composer->calculate_delay(tiles_data);
-                                    obuffer->write_request(delay);
-                                    obuffer->insert();
-                                    pipeline.move_stage(WRITEBACK_I);
-                                }
+                if (!pipelined.empty()) {
+
+                    const auto &leader = controls[pipelined.front()];
+                    auto pipelines = std::vector<Pipeline<T>>(pipelined.size(), Pipeline<T>(Stage::Last + 1));
+
+                    // The DRAM waiting lists hold the addresses read by the whole layer
+                    auto layer_reads = leader->getLayerReadAddresses();
+                    for (auto c : pipelined)
+                        controls[c]->getDram()->reserve_addresses(layer_reads);
+
+                    // The OPT eviction policy plans the on-chip steps of the whole layer before they are requested
+                    bool lookahead = false;
+                    for (auto c : pipelined)
+                        lookahead |= controls[c]->getGbuffer()->lookahead();
+
+                    std::vector<std::vector<std::shared_ptr<TilesData<T>>>> planned_nodes;
+                    if (lookahead) {
+                        planned_nodes = leader->generate_layer_steps();
+                        std::vector<std::shared_ptr<TilesData<T>>> planned_steps;
+                        for (const auto &node_steps : planned_nodes)
+                            planned_steps.insert(planned_steps.end(), node_steps.begin(), node_steps.end());
+                        for (auto c : pipelined)
+                            controls[c]->getGbuffer()->plan_steps(planned_steps);
+                    }
 
-                                if (pipeline.isValid(EXECUTION) && obuffer->isFree() && abuffer->data_ready() &&
-                                    pbuffer->data_ready() && wbuffer->data_ready() && arch->ready()) {
-                                    const auto &tiles_data = pipeline.getData(EXECUTION);
-                                    arch->process_tiles(tiles_data);
-                                    abuffer->erase(tiles_data->read_act);
-                                    pbuffer->erase(tiles_data->read_psum);
-                                    wbuffer->erase(tiles_data->read_wgt);
-                                    if (control->check_if_write_output(tiles_data)) pipeline.move_stage(EXECUTION);
-                                    else pipeline.end_stage(EXECUTION);
-                                }
+                    uint64_t step = 0;
+                    uint64_t node = 0;
+                    uint64_t skipped_sets = 0;
+                    do {
+                        for (auto c : pipelined) {
+                            const auto &control = controls[c];
+                            control->getGbuffer()->evict_data(leader->getIfEvictAct(), leader->getIfEvictOut(),
+                                    leader->getIfEvictWgt());
+                            control->getDram()->read_data(leader->getReadActAddresses(),
+                                    leader->getReadPsumAddresses(), leader->getReadWgtAddresses());
+                        }
+
+                        // Load the next node in the free global buffer capacity while this one computes
+                        for (auto c : pipelined) {
+                            const auto &control = controls[c];
+                            const auto &dram = control->getDram();
+                            if (!dram->prefetch() || !leader->hasNextNode())
+                                continue;
+
+                            const auto &gbuffer = control->getGbuffer();
+                            dram->prefetch_data(leader->getNextReadActAddresses(), leader->getNextReadPsumAddresses(),
+                                    leader->getNextReadWgtAddresses(), gbuffer->getActSize() * 8 / dram->getWidth(),
+                                    gbuffer->getWgtSize() * 8 / dram->getWidth());
+                        }
+
+                        // Write back the outputs of this node as the post-processing unit produces them
+                        for (auto c : pipelined) {
+                            const auto &control = controls[c];
+                            if (control->getPPU()->stream())
+                                control->getDram()->stage_writes(leader->getWriteAddresses());
+                        }
+
+                        NodeTrace<T> *node_trace = nullptr;
+                        if (layer_trace) {
+                            layer_trace->nodes.emplace_back();
+                            node_trace = &layer_trace->nodes.back();
+                            node_trace->evict_act = leader->getIfEvictAct();
+                            node_trace->evict_out = leader->getIfEvictOut();
+                            node_trace->evict_wgt = leader->getIfEvictWgt();
+                            node_trace->layer_act_on_chip = leader->getIfLayerActOnChip();
+                            node_trace->read_act_addresses = leader->getReadActAddresses();
+                            node_trace->read_psum_addresses = leader->getReadPsumAddresses();
+                            node_trace->read_wgt_addresses = leader->getReadWgtAddresses();
+                        }
 
-                                if (pipeline.isValid(MEMORY_II) && pipeline.isFree(EXECUTION) &&
-                                    gbuffer->data_ready()) {
-                                    const auto &tiles_data = pipeline.getData(MEMORY_II);
-                                    abuffer->read_request(tiles_data->read_act);
-                                    pbuffer->read_request(tiles_data->read_psum);
-                                    wbuffer->read_request(tiles_data->read_wgt);
-                                    pipeline.move_stage(MEMORY_II);
+                        std::vector<std::shared_ptr<TilesData<T>>> planned_steps;
+                        if (lookahead)
+                            planned_steps = std::move(planned_nodes[node++]);
+
+                        // Fan out every on-chip step to all the architectures
+                        auto layer_act_on_chip = leader->getIfLayerActOnChip();
+                        uint64_t next_planned = 0;
+                        while (true) {
+
+                            for (int p = 0; p < pipelined.size(); ++p) {
+                                const auto &control = controls[pipelined[p]];
+                                auto &pipeline = pipelines[p];
+                                while (!pipeline.isFree(MEMORY_I)) {
+                                    cycle_pipeline(pipeline, control, layer_act_on_chip, layer_trace);
+                                    control->cycle();//global_cycle++
                                 }
+                            }
 
-                                if (pipeline.isValid(MEMORY_I) && dram->data_ready() && abuffer->isFree() &&
-                                    pbuffer->isFree()
-                                    && wbuffer->isFree()) {
-                                    const auto &tiles_data = pipeline.getData(MEMORY_I);
-                                    gbuffer->act_read_request(tiles_data, control->getIfLayerActOnChip(),
-                                                              tiles_data->read_act);
-                                    gbuffer->psum_read_request(tiles_data, tiles_data->read_psum);
-                                    gbuffer->wgt_read_request(tiles_data, tiles_data->read_wgt);
-                                    abuffer->insert(tiles_data->read_act);
-                                    pbuffer->insert(tiles_data->read_psum);
-                                    wbuffer->insert(tiles_data->read_wgt);
-                                    pipeline.move_stage(MEMORY_I);
+                            auto tiles_data = TilesData<T>(leader->getArch()->getTiles());
+                            if (lookahead) {
+                                if (next_planned == planned_steps.size())
+                                    break;
+                                tiles_data = *planned_steps[next_planned++];
+                            } else {
+                                auto still_data = leader->still_on_chip_data(tiles_data);
+
+                                // The time of the skipped sets passes before the next sampled step
+                                auto skipped = leader->getSkippedSets() - skipped_sets;
+                                if (skipped > 0) {
+                                    for (auto c : pipelined)
+                                        skip_sets(controls[c], skipped);
+                                    skipped_sets += skipped;
                                 }
 
-                                control->cycle();//global_cycle++
+                                if (!still_data)
+                                    break;
+                                tiles_data.step = step++;
+                            }
 
-                                if (pipeline.isFree(MEMORY_I) && still_data) {
-                                    auto next_data = TilesData<T>(arch->getTiles());
-                                    still_data = control->still_on_chip_data(next_data);
-                                    if (still_data) {
-                                        if (this->CHECK) calculate_output(sim_output, next_data);
-                                        dram->read_request(next_data, control->getIfLayerActOnChip());
-                                        pipeline.fetch_data(next_data);
-                                    }
-                                }
+                            if (this->CHECK) calculate_output(sim_output, tiles_data);
+                            if (node_trace) node_trace->record_step(tiles_data);
 
+                            for (int p = 0; p < pipelined.size(); ++p) {
+                                const auto &control = controls[pipelined[p]];
+                                control->getDram()->read_request(tiles_data, layer_act_on_chip);
+                                if (tiles_data.set_start) control->start_set(tiles_data.set_measured, tiles_data.set_warm);
+                                pipelines[p].fetch_data(tiles_data);
                             }
 
-                            ppu->calculate_delay(
-                                    control->calculate_outputs());//post proccessing unit //Number of inputs in parallel:
-                            dram->write_data(control->getWriteAddresses());
+                        }
+
+                        // Every architecture measures the sampled sets with its own cycles
+                        if (leader->sampling())
+                            for (auto c : pipelined)
+                                controls[c]->end_node_sets(*leader);
+
+                        auto outputs = leader->calculate_outputs();
+                        if (node_trace) {
+                            node_trace->outputs = outputs;
+                            node_trace->write_addresses = leader->getWriteAddresses();
+                        }
 
-                        } while (control->still_off_chip_data());
+                        for (int p = 0; p < pipelined.size(); ++p) {
+                            const auto &control = controls[pipelined[p]];
+                            auto &pipeline = pipelines[p];
 
-                        //Paria
-                        //arch->UnusedLanes(act_channels, output_windows, num_filters, Kx, Ky);
+                            while (!pipeline.isEmpty()) {
+                                cycle_pipeline(pipeline, control, layer_act_on_chip, layer_trace);
+                                control->cycle();//global_cycle++
+                            }
 
-                        if (CHECK) check_result(sim_output, act, wgt, Ox, Oy, stride, rnn, arch->diffy());
+                            // The skipped sets still receive their off-chip data before the next node evicts it
+                            if (leader->sampling()) {
+                                control->getDram()->wait_read_data();
+                                while (!control->getDram()->data_ready())
+                                    control->cycle();
+                            }
+
+                            if (control->getPPU()->stream()) control->getPPU()->wait_outputs();
+                            else control->getPPU()->calculate_delay(outputs);//post proccessing unit //Number of inputs in parallel:
+                            control->getDram()->write_data(leader->getWriteAddresses());
+                        }
+
+                    } while (leader->still_off_chip_data());
+
+                    //Paria
+                    //arch->UnusedLanes(act_channels, output_windows, num_filters, Kx, Ky);
+
+                    if (CHECK && !leader->sampling())
+                        check_result(sim_output, acts.front(), wgts.front(), Ox, Oy, stride, rnn,
+                                leader->getArch()->diffy());
+
+                    for (auto c : pipelined) {
+
+                        const auto &control = controls[c];
+                        const auto &dram = control->getDram();
+                        const auto &gbuffer = control->getGbuffer();
+                        const auto &arch = control->getArch();
+                        auto &cs = all_stats[c];
+
+                        auto act_channels = cs.activation_channel->value[layer_it][sample];
+                        auto output_windows = cs.outputWindows->value[layer_it][sample];
+                        auto num_filters = cs.number_filters->value[layer_it][sample];
+                        auto Kx = cs.Kxw->value[layer_it][sample];
+                        auto Ky = cs.Kyw->value[layer_it][sample];
 
                         // Dump stats
-                        cycles->value[layer_it][sample] = control->getCycles();
-                        compute_cycles->value[layer_it][sample] = arch->getCycles();
+                        cs.cycles->value[layer_it][sample] = control->getCycles();
+                        cs.compute_cycles->value[layer_it][sample] = arch->getCycles();
+
+                        if (control->sampling()) {
+                            cs.estimated_cycles->value[layer_it][sample] = control->getEstimatedCycles();
+                            cs.estimated_cycles_interval->value[layer_it][sample] =
+                                    control->getEstimatedCyclesInterval();
+                            cs.simulated_fraction->value[layer_it][sample] = control->getSimulatedFraction();
+                        }
 
-                        scheduled_pe->value[layer_it][sample] = arch->getScheduledPe();
+                        if (control->mapping_search()) {
+                            cs.mapping->value[layer_it][sample] = control->getMapping();
+                            cs.estimated_dram_traffic->value[layer_it][sample] = control->getMappingTraffic();
+                        }
+
+                        cs.sampled_cycles[layer_it].push_back(control->getEstimatedCycles());
+
+                        cs.scheduled_pe->value[layer_it][sample] = arch->getScheduledPe();
+                        if (layer_trace) {
+                            layer_trace->compute_cycles = arch->getCycles();
+                            layer_trace->scheduled_pe = arch->getScheduledPe();
+                            layer_trace->idle_pe = arch->getIdlePe();
+                        }
                         //idle_pe->value[layer_it][sample] = arch->getIdlePe();
-                            idle_pe->value[layer_it][sample] = arch->UnusedPEsandTiles(act_channels, output_windows,
+                            cs.idle_pe->value[layer_it][sample] = arch->UnusedPEsandTiles(act_channels, output_windows,
                                     num_filters, Kx, Ky);//ghablan pe haye idle dar tile haye idle ra hesab nemikard ke man umadam barash ye function neveshtam
                                     //vali mishe in kar ro kard ke tedad cycleha ro dar abade accelerator zarb kard. injoori kole pe haii ke dare kelak mikhore be dast miad
                                     //bad scheduled ha ro az un kam kard
                         //idle_lanes->value[layer_it][sample] = arch->getIdleLane();
 
-                        dram_act_reads->value[layer_it][sample] = dram->getActReads();
-                        dram_psum_reads->value[layer_it][sample] = dram->getPsumReads();
-                        dram_wgt_reads->value[layer_it][sample] = dram->getWgtReads();
-                        dram_out_writes->value[layer_it][sample] = dram->getOutWrites();
+                        cs.dram_act_reads->value[layer_it][sample] = dram->getActReads();
+                        cs.dram_psum_reads->value[layer_it][sample] = dram->getPsumReads();
+                        cs.dram_wgt_reads->value[layer_it][sample] = dram->getWgtReads();
+                        cs.dram_out_writes->value[layer_it][sample] = dram->getOutWrites();
 
                         for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
-                            gbuffer_act_reads[lvl]->value[layer_it][sample] = gbuffer->getActReads(lvl);
-                            gbuffer_psum_reads[lvl]->value[layer_it][sample] = gbuffer->getPsumReads(lvl);
-                            gbuffer_out_writes[lvl]->value[layer_it][sample] = gbuffer->getOutWrites(lvl);
-
-                            gbuffer_act_bank_conflicts[lvl]->value[layer_it][sample] = gbuffer->getActBankConflicts(
-                                    lvl);
-                            gbuffer_psum_bank_conflicts[lvl]->value[layer_it][sample] = gbuffer->getPsumBankConflicts(
-                                    lvl);
-                            gbuffer_out_bank_conflicts[lvl]->value[layer_it][sample] = gbuffer->getOutBankConflicts(
-                                    lvl);
+                            cs.gbuffer_act_reads[lvl]->value[layer_it][sample] = gbuffer->getActReads(lvl);
+                            cs.gbuffer_psum_reads[lvl]->value[layer_it][sample] = gbuffer->getPsumReads(lvl);
+                            cs.gbuffer_out_writes[lvl]->value[layer_it][sample] = gbuffer->getOutWrites(lvl);
+
+                            cs.gbuffer_act_bank_conflicts[lvl]->value[layer_it][sample] =
+                                    gbuffer->getActBankConflicts(lvl);
+                            cs.gbuffer_psum_bank_conflicts[lvl]->value[layer_it][sample] =
+                                    gbuffer->getPsumBankConflicts(lvl);
+                            cs.gbuffer_out_bank_conflicts[lvl]->value[layer_it][sample] =
+                                    gbuffer->getOutBankConflicts(lvl);
                         }
 
                         for (int lvl = 0; lvl < gbuffer->getWgtLevels(); ++lvl) {
-                            gbuffer_wgt_reads[lvl]->value[layer_it][sample] = gbuffer->getWgtReads(lvl);
-                            gbuffer_wgt_bank_conflicts[lvl]->value[layer_it][sample] = gbuffer->getWgtBankConflicts(
-                                    lvl);
+                            cs.gbuffer_wgt_reads[lvl]->value[layer_it][sample] = gbuffer->getWgtReads(lvl);
+                            cs.gbuffer_wgt_bank_conflicts[lvl]->value[layer_it][sample] =
+                                    gbuffer->getWgtBankConflicts(lvl);
                         }
 
-                        act_precision->value[layer_it][sample] = act_prec;
-                        wgt_precision->value[layer_it][sample] = wgt_prec;
-
-                        number_filters->value[layer_it][sample] = num_filters;
-
-                        activation_channel->value[layer_it][sample] = wgt_channels;
-                        //weigth_channel->value[layer_it][image] = wgt_channels;
-
-                        outputWindows->value[layer_it][sample] = output_windows;
-
-                        lanes->value[layer_it][sample] = arch->getLanes();
-                        columns->value[layer_it][sample] = arch->getColumns();
-                        rows->value[layer_it][sample] = arch->getRows();
-                        Kxw->value[layer_it][sample] = Kx;
-                        Kyw->value[layer_it][sample] = Ky;
+                        cs.lanes->value[layer_it][sample] = arch->getLanes();
+                        cs.columns->value[layer_it][sample] = arch->getColumns();
+                        cs.rows->value[layer_it][sample] = arch->getRows();
 
                         //paria
-                        computeNumbers->value[layer_it][sample] = output_windows * num_filters * act_channels * Kx * Ky;
-                        allPEclocked->value[layer_it][sample] = arch->getallPEsclocked();
+                        cs.allPEclocked->value[layer_it][sample] = arch->getallPEsclocked();
 
 
                         arch->UnusedPEs(act_channels, output_windows, num_filters, Kx, Ky);
@@ -550,36 +846,245 @@ namespace core {
                             printf("\n IDLE_PE scheduling is wrong");
                         }
 
+                        //Paria back to defult dimention size
+                        arch->LANES = cs.primaryLane;
+                        arch->COLUMNS = cs.primaryColumn;
+                        arch->ROWS = cs.primaryRow;
+                    }
+
+                }
+
+            } // Layer
+
+            // Stop when the cycles mean of every layer is within the requested error
+            if (ADAPTIVE_ERROR > 0 && sample > 0) {
+                bool converged = true;
+                for (auto &cs : all_stats) {
+                    for (auto layer_it = 0; layer_it < network.getNumLayers(); ++layer_it) {
+                        auto error = relative_interval(cs.sampled_cycles[layer_it]);
+                        for (int s = 0; s <= sample; ++s)
+                            cs.cycles_interval->value[layer_it][s] = error;
+                        if (error > ADAPTIVE_ERROR) converged = false;
                     }
-                    //Paria back to defult dimention size
-                    arch->LANES = primaryLane;
-                    arch->COLUMNS = primaryColumn;
-                    arch->ROWS = primaryRow;
+                }
+
+                if (converged && sample + 1 < batch_size) {
+                    if (!QUIET) printf("\n Cycles converged after %d samples\n", sample + 1);
+                    for (auto &cs : all_stats)
+                        cs.stats->resize(sample + 1);
+                    if (trace) trace->layers.resize(sample + 1);
+                    break;
+                }
+            }
+
+        } // Sample
 
-                } // Layer
+        for (int c = 0; c < controls.size(); ++c) {
 
-            } // Sample
+            const auto &control = controls[c];
+            const auto &arch = control->getArch();
 
             //Dump statistics
             std::string header = arch->name() + " Number of Cycles for " + network.getName() + "\n";
             header += "Dataflow: " + control->dataflow() + "\n";
-            header += "--> DRAM: \n" + dram->header();
-            header += "--> Global Buffer: \n" + gbuffer->header();
-            header += "--> Activation Buffer: \n" + abuffer->header();
-            header += "--> Partial Sum Buffer: \n" + pbuffer->header();
-            header += "--> Weight Buffer: \n" + wbuffer->header();
-            header += "--> Output Buffer: \n" + obuffer->header();
-            header += "--> Composer: \n" + composer->header();
-            header += "--> Post-Processing Unit: \n" + ppu->header();
+            header += "--> DRAM: \n" + control->getDram()->header();
+            header += "--> Global Buffer: \n" + control->getGbuffer()->header();
+            header += "--> Activation Buffer: \n" + control->getAbuffer()->header();
+            header += "--> Partial Sum Buffer: \n" + control->getPbuffer()->header();
+            header += "--> Weight Buffer: \n" + control->getWbuffer()->header();
+            header += "--> Output Buffer: \n" + control->getObuffer()->header();
+            header += "--> Composer: \n" + control->getComposer()->header();
+            header += "--> Post-Processing Unit: \n" + control->getPPU()->header();
             header += "--> Architecture: \n" + arch->header();
 
             //stats.dump_csv(network.getName(), network.getLayersName(), header, QUIET);
-            stats.dump_csv(network.getName(), network.getLayersName(), header + arch->header(), arch->name(), QUIET);
+            all_stats[c].stats->dump_csv(network.getName(), network.getLayersName(), header + arch->header(),
+                    arch->name(), QUIET);
         }
     }
 
 
 
+    template <typename T>
+    void Simulator<T>::replay(const base::Network<T> &network, const std::shared_ptr<Control<T>> &control,
+            const std::shared_ptr<MemoryTrace<T>> &trace) {
+
+        // Get components from control
+        auto dram = control->getDram();
+        auto gbuffer = control->getGbuffer();
+        auto ppu = control->getPPU();
+        auto arch = control->getArch();
+
+        auto replay_arch = std::make_shared<Replay<T>>(arch);
+        control->setArch(replay_arch);
+
+        if(!QUIET) std::cout << "Starting memory replay for architecture " << arch->name() << std::endl;
+
+        // Initialize statistics
+        trace->replays++;
+        auto batch_size = trace->layers.size();
+        std::string filename = "Replay" + std::to_string(trace->replays) + "_" + arch->name() + "_" +
+                network.getName() + arch->filename() + gbuffer->filename() + "_cycles";
+        sys::Stats stats = sys::Stats(network.getNumLayers(), batch_size, filename);
+
+        // Time stats
+        auto cycles = stats.register_uint_t("cycles", 0, sys::AverageTotal);
+        auto compute_cycles = stats.register_uint_t("compute_cycles", 0, sys::AverageTotal);
+
+        // DRAM stats
+        auto dram_act_reads = stats.register_uint_t("dram_act_reads", 0, sys::AverageTotal);
+        auto dram_psum_reads = stats.register_uint_t("dram_psum_reads", 0, sys::AverageTotal);
+        auto dram_wgt_reads = stats.register_uint_t("dram_wgt_reads", 0, sys::AverageTotal);
+        auto dram_out_writes = stats.register_uint_t("dram_out_writes", 0, sys::AverageTotal);
+
+        // Global Buffer stats
+        auto gbuffer_act_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+        auto gbuffer_psum_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+        auto gbuffer_wgt_reads = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getWgtLevels());
+        auto gbuffer_out_writes = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+        auto gbuffer_act_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+        auto gbuffer_psum_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+        auto gbuffer_wgt_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getWgtLevels());
+        auto gbuffer_out_bank_conflicts = std::vector<std::shared_ptr<sys::stat_uint_t>>(gbuffer->getActLevels());
+
+        for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
+            auto level = std::to_string(lvl);
+            gbuffer_act_reads[lvl] = stats.register_uint_t("gbuffer_act_reads." + level, 0, sys::AverageTotal);
+            gbuffer_psum_reads[lvl] = stats.register_uint_t("gbuffer_psum_reads." + level, 0, sys::AverageTotal);
+            gbuffer_out_writes[lvl] = stats.register_uint_t("gbuffer_out_writes." + level, 0, sys::AverageTotal);
+            gbuffer_act_bank_conflicts[lvl] =
+                    stats.register_uint_t("gbuffer_act_bank_conflicts." + level, 0, sys::AverageTotal);
+            gbuffer_psum_bank_conflicts[lvl] =
+                    stats.register_uint_t("gbuffer_psum_bank_conflicts." + level, 0, sys::AverageTotal);
+            gbuffer_out_bank_conflicts[lvl] =
+                    stats.register_uint_t("gbuffer_out_bank_conflicts." + level, 0, sys::AverageTotal);
+        }
+
+        for (int lvl = 0; lvl < gbuffer->getWgtLevels(); ++lvl) {
+            auto level = std::to_string(lvl);
+            gbuffer_wgt_reads[lvl] = stats.register_uint_t("gbuffer_wgt_reads." + level, 0, sys::AverageTotal);
+            gbuffer_wgt_bank_conflicts[lvl] =
+                    stats.register_uint_t("gbuffer_wgt_bank_conflicts." + level, 0, sys::AverageTotal);
+        }
+
+        // Iterate over the samples
+        for (auto sample = 0; sample < batch_size; ++sample) {
+
+            // Iterate over the layers
+            for (auto layer_it = 0; layer_it < network.getNumLayers(); ++layer_it) {
+
+                const auto &layer_trace = trace->layers[sample][layer_it];
+
+                if (!QUIET)
+                    printf("\n Replaying sample: %d/%lu for layer: %s\n", sample + 1, batch_size,
+                           network.getLayers()[layer_it].getName().c_str());
+
+                compute_cycles->value[layer_it][sample] = layer_trace.compute_cycles;
+                if (!layer_trace.pipelined)
+                    continue;
+
+                control->configure_models(layer_trace.act_prec, layer_trace.wgt_prec, layer_trace.signed_act,
+                        layer_trace.signed_wgt, layer_trace.linear, layer_trace.rnn, layer_trace.stride);
+                replay_arch->replay_layer(layer_trace);
+
+                // The recorded steps of the whole layer are known, so the OPT eviction policy plans all of them
+                if (gbuffer->lookahead()) {
+                    std::vector<std::shared_ptr<TilesData<T>>> planned_steps;
+                    for (const auto &node : layer_trace.nodes)
+                        planned_steps.insert(planned_steps.end(), node.steps.begin(), node.steps.end());
+                    gbuffer->plan_steps(planned_steps);
+                }
+
+                // The DRAM waiting list holds the addresses read by the whole layer
+                for (const auto &node : layer_trace.nodes) {
+                    dram->reserve_addresses(node.read_act_addresses);
+                    dram->reserve_addresses(node.read_psum_addresses);
+                    dram->reserve_addresses(node.read_wgt_addresses);
+                }
+
+                Pipeline<T> pipeline = Pipeline<T>(Stage::Last + 1);
+                for (int n = 0; n < layer_trace.nodes.size(); ++n) {
+                    const auto &node = layer_trace.nodes[n];
+
+                    gbuffer->evict_data(node.evict_act, node.evict_out, node.evict_wgt);
+                    dram->read_data(node.read_act_addresses, node.read_psum_addresses, node.read_wgt_addresses);
+
+                    if (dram->prefetch() && n + 1 < layer_trace.nodes.size()) {
+                        const auto &next_node = layer_trace.nodes[n + 1];
+                        dram->prefetch_data(next_node.read_act_addresses, next_node.read_psum_addresses,
+                                next_node.read_wgt_addresses, gbuffer->getActSize() * 8 / dram->getWidth(),
+                                gbuffer->getWgtSize() * 8 / dram->getWidth());
+                    }
+
+                    if (ppu->stream())
+                        dram->stage_writes(node.write_addresses);
+
+                    for (const auto &tiles_data : node.steps) {
+                        while (!pipeline.isFree(MEMORY_I)) {
+                            cycle_pipeline(pipeline, control, node.layer_act_on_chip);
+                            control->cycle();//global_cycle++
+                        }
+
+                        dram->read_request(*tiles_data, node.layer_act_on_chip);
+                        pipeline.fetch_data(*tiles_data);
+                    }
+
+                    while (!pipeline.isEmpty()) {
+                        cycle_pipeline(pipeline, control, node.layer_act_on_chip);
+                        control->cycle();//global_cycle++
+                    }
+
+                    if (ppu->stream()) ppu->wait_outputs();
+                    else ppu->calculate_delay(node.outputs);
+                    dram->write_data(node.write_addresses);
+                }
+
+                // Dump stats
+                cycles->value[layer_it][sample] = control->getCycles();
+
+                dram_act_reads->value[layer_it][sample] = dram->getActReads();
+                dram_psum_reads->value[layer_it][sample] = dram->getPsumReads();
+                dram_wgt_reads->value[layer_it][sample] = dram->getWgtReads();
+                dram_out_writes->value[layer_it][sample] = dram->getOutWrites();
+
+                for (int lvl = 0; lvl < gbuffer->getActLevels(); ++lvl) {
+                    gbuffer_act_reads[lvl]->value[layer_it][sample] = gbuffer->getActReads(lvl);
+                    gbuffer_psum_reads[lvl]->value[layer_it][sample] = gbuffer->getPsumReads(lvl);
+                    gbuffer_out_writes[lvl]->value[layer_it][sample] = gbuffer->getOutWrites(lvl);
+                    gbuffer_act_bank_conflicts[lvl]->value[layer_it][sample] = gbuffer->getActBankConflicts(lvl);
+                    gbuffer_psum_bank_conflicts[lvl]->value[layer_it][sample] = gbuffer->getPsumBankConflicts(lvl);
+                    gbuffer_out_bank_conflicts[lvl]->value[layer_it][sample] = gbuffer->getOutBankConflicts(lvl);
+                }
+
+                for (int lvl = 0; lvl < gbuffer->getWgtLevels(); ++lvl) {
+                    gbuffer_wgt_reads[lvl]->value[layer_it][sample] = gbuffer->getWgtReads(lvl);
+                    gbuffer_wgt_bank_conflicts[lvl]->value[layer_it][sample] = gbuffer->getWgtBankConflicts(lvl);
+                }
+
+            } // Layer
+
+        } // Sample
+
+        control->setArch(arch);
+
+        //Dump statistics
+        std::string header = arch->name() + " Memory replay for " + network.getName() + "\n";
+        header += "Dataflow: " + control->dataflow() + "\n";
+        header += "--> DRAM: \n" + dram->header();
+        header += "--> Global Buffer: \n" + gbuffer->header();
+        header += "--> Activation Buffer: \n" + control->getAbuffer()->header();
+        header += "--> Partial Sum Buffer: \n" + control->getPbuffer()->header();
+        header += "--> Weight Buffer: \n" + control->getWbuffer()->header();
+        header += "--> Output Buffer: \n" + control->getObuffer()->header();
+        header += "--> Composer: \n" + control->getComposer()->header();
+        header += "--> Post-Processing Unit: \n" + ppu->header();
+        header += "--> Architecture: \n" + arch->header();
+
+        stats.dump_csv(network.getName(), network.getLayersName(), header, arch->name(), QUIET);
+    }
+
+
+
     /* POTENTIALS */
 
     template <typename T>
@@ -615,12 +1120,12 @@ namespace core {
 
             if (!QUIET) std::cout << "Simulating layer: " << layer.getName() << std::endl;
 
-            base::Array<T> act = layer.getActivations();
+            base::Array<T> act = network.getActivations(layer_it);
             arch->dataConversion(act);
             if (fc && act.getDimensions() == 4) act.reshape_to_2D();
             if (act.getDimensions() == 2) act.reshape_to_4D();
 
-            base::Array<T> wgt = layer.getWeights();
+            base::Array<T> wgt = network.getWeights(layer_it);
             arch->dataConversion(wgt);
             if (wgt.getDimensions() == 2) wgt.reshape_to_4D();
 
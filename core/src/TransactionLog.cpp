@@ -0,0 +1,137 @@
+#include <core/TransactionLog.h>
+#include <cstdio>
+
+namespace core {
+
+    static const char MAGIC[8] = {'D', 'N', 'N', 'T', 'X', 'L', 'G', '2'};
+
+    TransactionLog::TransactionLog(const std::string &_PATH, const std::string &_KEY) : PATH(_PATH), KEY(_KEY) {
+        auto key_size = (uint32_t)KEY.size();
+
+        replay_file.open(PATH, std::ios::binary);
+        if (replay_file.good()) {
+            char magic[8];
+            uint32_t recorded_key_size = 0;
+            replay_file.read(magic, sizeof(magic));
+            replay_file.read((char*)&recorded_key_size, sizeof(recorded_key_size));
+            if (!replay_file || !std::equal(magic, magic + sizeof(magic), MAGIC))
+                throw std::runtime_error("File " + PATH + " is not a DNNsim transaction log, remove it or use "
+                                         "another path");
+
+            std::string recorded_key(recorded_key_size, ' ');
+            replay_file.read(&recorded_key[0], recorded_key_size);
+            if (!replay_file || recorded_key != KEY)
+                throw std::runtime_error("Transaction log " + PATH + " was recorded with another DRAM "
+                                         "configuration, remove it or use another path");
+
+            replaying = true;
+            read_next();
+        }
+
+        // Several logs may record the same file at the same time
+        static uint64_t logs = 0;
+        record_path = PATH + ".tmp" + std::to_string(logs++);
+        record_file.open(record_path, std::ios::binary | std::ios::trunc);
+        if (!record_file.good())
+            throw std::runtime_error("Error creating the transaction log " + record_path);
+
+        record_file.write(MAGIC, sizeof(MAGIC));
+        record_file.write((const char*)&key_size, sizeof(key_size));
+        record_file.write(KEY.data(), key_size);
+    }
+
+    TransactionLog::~TransactionLog() {
+        for (const auto &transaction : pending) {
+            record_file.write((const char*)&transaction.address, sizeof(uint64_t));
+            record_file.write((const char*)&transaction.delta, sizeof(uint64_t));
+            record_file.write((const char*)&transaction.latency, sizeof(uint32_t));
+        }
+        record_file.close();
+        replay_file.close();
+
+        // Same stream as the recorded one
+        if (replaying && !has_next) {
+            std::remove(record_path.c_str());
+            return;
+        }
+
+        // The latencies after the mismatch are approximate, so the log is recorded again by the next simulation
+        if (diverged) {
+            std::remove(record_path.c_str());
+            std::remove(PATH.c_str());
+            return;
+        }
+
+        std::rename(record_path.c_str(), PATH.c_str());
+    }
+
+    uint64_t TransactionLog::tag(uint64_t address, bool isWrite) {
+        return address | ((uint64_t)isWrite << 63u);
+    }
+
+    void TransactionLog::read_next() {
+        replay_file.read((char*)&next.address, sizeof(uint64_t));
+        replay_file.read((char*)&next.delta, sizeof(uint64_t));
+        replay_file.read((char*)&next.latency, sizeof(uint32_t));
+        has_next = (bool)replay_file;
+    }
+
+    void TransactionLog::write_completed() {
+        while (!pending.empty() && pending.front().latency != UINT32_MAX) {
+            const auto &transaction = pending.front();
+            record_file.write((const char*)&transaction.address, sizeof(uint64_t));
+            record_file.write((const char*)&transaction.delta, sizeof(uint64_t));
+            record_file.write((const char*)&transaction.latency, sizeof(uint32_t));
+            pending.pop_front();
+            first_pending++;
+        }
+    }
+
+    bool TransactionLog::request(uint64_t address, bool isWrite, uint64_t cycle, uint32_t &latency) {
+        if (diverged)
+            return false;
+
+        auto tagged = tag(address, isWrite);
+        auto delta = cycle - last_request;
+        last_request = cycle;
+
+        Transaction transaction;
+        transaction.address = tagged;
+        transaction.delta = delta;
+        pending.push_back(transaction);
+        in_flight[tagged].emplace_back(transactions++, cycle);
+
+        if (replaying && (!has_next || next.address != tagged || next.delta != delta)) {
+            replaying = false;
+            diverged = true;
+            replay_file.close();
+        }
+
+        if (!replaying)
+            return false;
+
+        latency = next.latency;
+        read_next();
+        return true;
+    }
+
+    bool TransactionLog::matching() const {
+        return replaying;
+    }
+
+    void TransactionLog::complete(uint64_t address, bool isWrite, uint64_t cycle) {
+        auto it = in_flight.find(tag(address, isWrite));
+        if (it == in_flight.end() || it->second.empty())
+            return;
+
+        auto transaction = it->second.front();
+        it->second.pop_front();
+        if (it->second.empty())
+            in_flight.erase(it);
+
+        pending[transaction.first - first_pending].latency =
+                (uint32_t)std::min(cycle - transaction.second, (uint64_t)UINT32_MAX - 1);
+        write_completed();
+    }
+
+}
@@ -11,7 +11,7 @@ namespace core {
     }
 
     template <typename T>
-    void WindowFirstOutS<T>::generate_execution_graph_conv_layer() {
+    typename WindowFirstOutS<T>::ConvSizes WindowFirstOutS<T>::conv_sizes() {
 
         const std::vector<size_t> &act_shape = this->act->getShape();
         const std::vector<size_t> &wgt_shape = this->wgt->getShape();
@@ -27,67 +27,93 @@ namespace core {
 
         auto num_windows = this->out_x * this->out_y;
 
-        auto all_input_size = (uint32_t)ceil(act_channels * Nx * Ny * this->dram->getActDataSize() / 8.);
+        ConvSizes sizes;
+        sizes.all_input_size = (uint32_t)ceil(act_channels * Nx * Ny * this->dram->getActDataSize() / 8.);
         auto subset_windows = std::min((uint32_t)num_windows, this->EF_COLUMNS);
-        auto subset_windows_size = (uint32_t)(subset_windows * act_channels * Kx * Ky //TODO reduce worst case size
+        sizes.subset_windows_size = (uint32_t)(subset_windows * act_channels * Kx * Ky //TODO reduce worst case size
                 * this->dram->getActDataSize() / 8.);
-        auto row_input_size = (uint32_t)ceil(subset_windows_size / (double)this->max_buffer_time);
+        sizes.row_input_size = (uint32_t)ceil(sizes.subset_windows_size / (double)this->max_buffer_time);
 
-        auto all_filters_size = (uint32_t)ceil(num_filters * wgt_channels * Kx * Ky
+        sizes.all_filters_size = (uint32_t)ceil(num_filters * wgt_channels * Kx * Ky
                 * this->dram->getWgtDataSize() / 8.);
-        auto subset_filters = std::min((uint32_t)num_filters, this->EF_ROWS * this->arch->getTiles());
-        auto subset_filters_size = (uint32_t)ceil(subset_filters * wgt_channels * Kx * Ky
+        sizes.subset_filters = std::min((uint32_t)num_filters, this->EF_ROWS * this->arch->getTiles());
+        sizes.subset_filters_size = (uint32_t)ceil(sizes.subset_filters * wgt_channels * Kx * Ky
                 * this->dram->getWgtDataSize() / 8.);
-        auto row_filter_size = (uint32_t)ceil(subset_filters_size / (double)this->max_buffer_time);
+        sizes.row_filter_size = (uint32_t)ceil(sizes.subset_filters_size / (double)this->max_buffer_time);
 
-        auto all_output_size = (uint32_t)ceil(num_filters * num_windows * this->dram->getBaseDataSize() / 8.);
-        auto subset_filters_output_size = (uint32_t)ceil(subset_filters * num_windows
+        sizes.all_output_size = (uint32_t)ceil(num_filters * num_windows * this->dram->getBaseDataSize() / 8.);
+        sizes.subset_filters_output_size = (uint32_t)ceil(sizes.subset_filters * num_windows
                 * this->dram->getBaseDataSize() / 8.);
-        auto subset_windows_output_size = (uint32_t)ceil(num_filters * subset_windows
+        sizes.subset_windows_output_size = (uint32_t)ceil(num_filters * subset_windows
+                * this->dram->getBaseDataSize() / 8.);
+        sizes.subsets_output_size = (uint32_t)ceil(sizes.subset_filters * subset_windows
                 * this->dram->getBaseDataSize() / 8.);
-        auto subsets_output_size = (uint32_t)ceil(subset_filters * subset_windows * this->dram->getBaseDataSize() / 8.);
 
-        MemPolicy act_policy;
-        if (all_input_size + all_output_size <= this->gbuffer->getActSize()) act_policy = ALL;
-        else if (all_input_size + subset_filters_output_size <= this->gbuffer->getActSize()) act_policy = INPUTS;
-        else if (subset_windows_size + subset_windows_output_size <= this->gbuffer->getActSize()) act_policy = SET;
-        else if (subset_windows_size + subsets_output_size <= this->gbuffer->getActSize()) act_policy = SUBSET;
-        else if (row_input_size + subsets_output_size <= this->gbuffer->getActSize()) act_policy = CHANNELS;
-        else throw std::runtime_error("Activation memory size too small to allocate one buffer row and one set outputs.");
+        sizes.total_filter_sets = (uint32_t)ceil(num_filters / (double)sizes.subset_filters);
+        return sizes;
+    }
 
-        MemPolicy wgt_policy;
-        if (all_filters_size <= this->gbuffer->getWgtSize()) wgt_policy = ALL;
-        else if (subset_filters_size <= this->gbuffer->getWgtSize()) wgt_policy = SET;
-        else if (row_filter_size <= this->gbuffer->getWgtSize()) wgt_policy = CHANNELS;
-        else throw std::runtime_error("Weight memory size too small to allocate one buffer row.");
+    template <typename T>
+    bool WindowFirstOutS<T>::act_policy_fits(const ConvSizes &sizes, MemPolicy act_policy) {
+        auto act_size = this->gbuffer->getActSize();
+        switch (act_policy) {
+            case ALL: return sizes.all_input_size + sizes.all_output_size <= act_size;
+            case INPUTS: return sizes.all_input_size + sizes.subset_filters_output_size <= act_size;
+            case SET: return sizes.subset_windows_size + sizes.subset_windows_output_size <= act_size;
+            case SUBSET: return sizes.subset_windows_size + sizes.subsets_output_size <= act_size;
+            case CHANNELS: return sizes.row_input_size + sizes.subsets_output_size <= act_size;
+            default: return false;
+        }
+    }
+
+    template <typename T>
+    bool WindowFirstOutS<T>::wgt_policy_fits(const ConvSizes &sizes, MemPolicy wgt_policy) {
+        auto wgt_size = this->gbuffer->getWgtSize();
+        switch (wgt_policy) {
+            case ALL: return sizes.all_filters_size <= wgt_size;
+            case SET: return sizes.subset_filters_size <= wgt_size;
+            case CHANNELS: return sizes.row_filter_size <= wgt_size;
+            default: return false;
+        }
+    }
+
+    template <typename T>
+    void WindowFirstOutS<T>::map_conv_layer(const ConvSizes &sizes, ConvMapping &mapping) {
+
+        const auto &act_policy = mapping.act_policy;
+        const auto &wgt_policy = mapping.wgt_policy;
+        auto act_channels = this->act->getShape()[1];
 
         uint32_t time_steps_act = 1, time_steps_wgt = 1;
-        auto total_filter_sets = (uint32_t)ceil(num_filters / (double)subset_filters);
+        auto total_filter_sets = sizes.total_filter_sets;
         auto filter_sets_per_step_act = total_filter_sets, filter_sets_per_step_wgt = total_filter_sets;
 
         if (act_policy == ALL) {
-            this->next_layer_act_on_chip = true;
+            // None
         } else if (act_policy == INPUTS) {
-            auto output_left_size = this->gbuffer->getActSize() - all_input_size;
+            auto output_left_size = this->gbuffer->getActSize() - sizes.all_input_size;
             assert(output_left_size < this->gbuffer->getActSize());
 
-            filter_sets_per_step_act = output_left_size / subset_filters_output_size;
-            assert(filter_sets_per_step_act < total_filter_sets);
+            filter_sets_per_step_act = output_left_size / sizes.subset_filters_output_size;
+            mapping.valid &= filter_sets_per_step_act < total_filter_sets;
+            assert(MAPPING_SEARCH || mapping.valid);
         } else if (act_policy == SET) {
             // None
         } else if (act_policy == SUBSET) {
-            auto output_left_size = this->gbuffer->getActSize() - subset_windows_size;
+            auto output_left_size = this->gbuffer->getActSize() - sizes.subset_windows_size;
             assert(output_left_size < this->gbuffer->getActSize());
 
-            filter_sets_per_step_act = output_left_size / subsets_output_size;
-            assert(filter_sets_per_step_act < total_filter_sets);
+            filter_sets_per_step_act = output_left_size / sizes.subsets_output_size;
+            mapping.valid &= filter_sets_per_step_act < total_filter_sets;
+            assert(MAPPING_SEARCH || mapping.valid);
         } else {
-            auto input_left_size = this->gbuffer->getActSize() - subsets_output_size;
+            auto input_left_size = this->gbuffer->getActSize() - sizes.subsets_output_size;
             assert(input_left_size < this->gbuffer->getActSize());
 
             filter_sets_per_step_act = 1;
-            time_steps_act = (uint32_t)ceil(subset_windows_size / (double)input_left_size);
-            assert(time_steps_act != 1);
+            time_steps_act = (uint32_t)ceil(sizes.subset_windows_size / (double)input_left_size);
+            mapping.valid &= time_steps_act != 1;
+            assert(MAPPING_SEARCH || mapping.valid);
 
             assert(!this->layer_act_on_chip);
         }
@@ -95,30 +121,34 @@ namespace core {
         if (wgt_policy == ALL) {
             // None
         } else if (wgt_policy == SET) {
-            filter_sets_per_step_wgt = this->gbuffer->getWgtSize() / subset_filters_size;
-            assert(filter_sets_per_step_wgt < this->filter_sets);
+            filter_sets_per_step_wgt = this->gbuffer->getWgtSize() / sizes.subset_filters_size;
+            mapping.valid &= filter_sets_per_step_wgt < this->filter_sets;
+            assert(MAPPING_SEARCH || mapping.valid);
         } else {
             filter_sets_per_step_wgt = 1;
-            time_steps_wgt = (uint32_t)ceil(subset_filters_size / (double)this->gbuffer->getWgtSize());
-            assert(time_steps_wgt != 1);
+            time_steps_wgt = (uint32_t)ceil(sizes.subset_filters_size / (double)this->gbuffer->getWgtSize());
+            mapping.valid &= time_steps_wgt != 1;
+            assert(MAPPING_SEARCH || mapping.valid);
         }
 
-        auto filter_sets_per_step = std::min(filter_sets_per_step_act, filter_sets_per_step_wgt);
-        auto filter_steps = (uint32_t)ceil(total_filter_sets / (double)filter_sets_per_step);
+        mapping.filter_sets_per_step = std::min(std::min(filter_sets_per_step_act, filter_sets_per_step_wgt),
+                mapping.max_filter_sets_per_step);
+        mapping.filter_steps = (uint32_t)ceil(total_filter_sets / (double)mapping.filter_sets_per_step);
 
-        std::vector<std::vector<int>> window_steps;
+        mapping.window_steps.clear();
         if (wgt_policy == CHANNELS || act_policy == CHANNELS) {
             for (int w = 0; w < this->window_sets; ++w) {
-                window_steps.emplace_back(std::vector<int>(1, w));
+                mapping.window_steps.emplace_back(std::vector<int>(1, w));
             }
         } else if (act_policy == ALL || act_policy == INPUTS){
-            window_steps.emplace_back(std::vector<int>(this->window_sets, 0));
-            std::iota(window_steps.front().begin(), window_steps.front().end(), 0);
+            mapping.window_steps.emplace_back(std::vector<int>(this->window_sets, 0));
+            std::iota(mapping.window_steps.front().begin(), mapping.window_steps.front().end(), 0);
         } else {
-            auto window_out_size = (uint32_t)ceil(subset_filters * filter_sets_per_step
+            auto window_out_size = (uint32_t)ceil(sizes.subset_filters * mapping.filter_sets_per_step
                     * this->dram->getBaseDataSize() / 8.);
-            this->fill_window_steps(window_steps, window_out_size, act_channels);
-            assert(window_steps.size() > 1);
+            this->fill_window_steps(mapping.window_steps, window_out_size, act_channels);
+            mapping.valid &= mapping.window_steps.size() > 1;
+            assert(MAPPING_SEARCH || mapping.valid);
         }
 
         auto time_steps = std::max(time_steps_act, time_steps_wgt);
@@ -131,6 +161,170 @@ namespace core {
 
         assert(this->max_buffer_time >= time_steps);
 
+        mapping.time_steps = time_steps;
+        mapping.max_time_per_step = max_time_per_step;
+    }
+
+    template <typename T>
+    void WindowFirstOutS<T>::estimate_conv_mapping(const ConvSizes &sizes, ConvMapping &mapping) {
+
+        const std::vector<size_t> &act_shape = this->act->getShape();
+        const std::vector<size_t> &wgt_shape = this->wgt->getShape();
+
+        auto act_channels = act_shape[1];
+        auto Nx = act_shape[2];
+        auto Ny = act_shape[3];
+
+        auto Kx = wgt_shape[2];
+        auto Ky = wgt_shape[3];
+
+        auto num_windows = this->out_x * this->out_y;
+        auto window_steps = (uint64_t)mapping.window_steps.size();
+
+        // Activations: the whole input once, or the input positions of each window step
+        uint64_t act_traffic = 0;
+        if (mapping.act_policy == ALL || mapping.act_policy == INPUTS) {
+            if (!this->layer_act_on_chip) act_traffic = sizes.all_input_size;
+        } else {
+            auto position_step = std::vector<uint32_t>(Nx * Ny, 0);
+            for (int wstep = 0; wstep < window_steps; ++wstep) {
+                if (wstep == 0 && this->layer_act_on_chip && mapping.act_policy != CHANNELS)
+                    continue;
+
+                uint64_t positions = 0;
+                for (const auto &window_set : mapping.window_steps[wstep]) {
+                    auto start_window = window_set * this->EF_COLUMNS;
+                    auto end_window = std::min(start_window + this->EF_COLUMNS, (uint32_t)num_windows);
+                    for (auto w = start_window; w < end_window; ++w) {
+                        auto x_window = (w % this->out_x) * this->stride;
+                        auto y_window = (w / this->out_x) * this->stride;
+                        for (int y = 0; y < Ky; ++y) {
+                            for (int x = 0; x < Kx; ++x) {
+                                auto pos = (y_window + y) * Nx + x_window + x;
+                                if (position_step[pos] == wstep + 1) continue;
+                                position_step[pos] = wstep + 1;
+                                positions++;
+                            }
+                        }
+                    }
+                }
+                act_traffic += (uint64_t)ceil(positions * act_channels * this->dram->getActDataSize() / 8.);
+            }
+            if (mapping.act_policy == CHANNELS) act_traffic *= mapping.filter_steps;
+        }
+
+        // Weights: all the filters once, or the filters of each filter step for every window step
+        uint64_t wgt_traffic = sizes.all_filters_size;
+        if (mapping.wgt_policy != ALL) wgt_traffic *= window_steps;
+
+        // Outputs: written back unless they stay on-chip for the next layer
+        uint64_t out_traffic = mapping.act_policy == ALL ? 0 : sizes.all_output_size;
+
+        mapping.dram_traffic = act_traffic + wgt_traffic + out_traffic;
+        mapping.nodes = window_steps * mapping.filter_steps * mapping.time_steps;
+    }
+
+    template <typename T>
+    typename WindowFirstOutS<T>::ConvMapping WindowFirstOutS<T>::search_conv_mapping(const ConvSizes &sizes) {
+
+        const MemPolicy act_policies[] = {ALL, INPUTS, SET, SUBSET, CHANNELS};
+        const MemPolicy wgt_policies[] = {ALL, SET, CHANNELS};
+
+        ConvMapping best;
+        bool found = false;
+
+        for (const auto &act_policy : act_policies) {
+            if (!act_policy_fits(sizes, act_policy)) continue;
+            if (act_policy == CHANNELS && this->layer_act_on_chip) continue;
+
+            for (const auto &wgt_policy : wgt_policies) {
+                if (!wgt_policy_fits(sizes, wgt_policy)) continue;
+
+                auto max_filter_sets_per_step = UINT32_MAX;
+                while (max_filter_sets_per_step > 0) {
+                    ConvMapping candidate;
+                    candidate.act_policy = act_policy;
+                    candidate.wgt_policy = wgt_policy;
+                    candidate.max_filter_sets_per_step = max_filter_sets_per_step;
+                    map_conv_layer(sizes, candidate);
+
+                    bool tactical_fits = !(this->arch->schedule() && act_policy == CHANNELS &&
+                            candidate.max_time_per_step <= this->scheduler->getLookaheadH());
+                    if (candidate.valid && tactical_fits) {
+                        estimate_conv_mapping(sizes, candidate);
+                        if (!found || candidate.dram_traffic < best.dram_traffic ||
+                                (candidate.dram_traffic == best.dram_traffic && candidate.nodes < best.nodes)) {
+                            best = candidate;
+                            found = true;
+                        }
+                    }
+
+                    max_filter_sets_per_step = candidate.filter_sets_per_step / 2;
+                }
+            }
+        }
+
+        if (!found) throw std::runtime_error("Global buffer too small to allocate any mapping of the layer.");
+        return best;
+    }
+
+    template <typename T>
+    std::string WindowFirstOutS<T>::describe_conv_mapping(const ConvMapping &mapping) {
+        const std::string policy_names[] = {"ALL", "INPUTS", "SET", "SUBSET", "CHANNELS", "GROUPS"};
+        return "A:" + policy_names[mapping.act_policy] + " W:" + policy_names[mapping.wgt_policy] +
+                " F:" + std::to_string(mapping.filter_sets_per_step) +
+                " WS:" + std::to_string(mapping.window_steps.size()) + " T:" + std::to_string(mapping.time_steps);
+    }
+
+    template <typename T>
+    void WindowFirstOutS<T>::generate_execution_graph_conv_layer() {
+
+        const std::vector<size_t> &act_shape = this->act->getShape();
+        const std::vector<size_t> &wgt_shape = this->wgt->getShape();
+
+        auto act_channels = act_shape[1];
+
+        auto num_filters = wgt_shape[0];
+        auto Kx = wgt_shape[2];
+        auto Ky = wgt_shape[3];
+
+        auto num_windows = this->out_x * this->out_y;
+
+        auto sizes = conv_sizes();
+
+        ConvMapping mapping;
+        if (act_policy_fits(sizes, ALL)) mapping.act_policy = ALL;
+        else if (act_policy_fits(sizes, INPUTS)) mapping.act_policy = INPUTS;
+        else if (act_policy_fits(sizes, SET)) mapping.act_policy = SET;
+        else if (act_policy_fits(sizes, SUBSET)) mapping.act_policy = SUBSET;
+        else if (act_policy_fits(sizes, CHANNELS)) mapping.act_policy = CHANNELS;
+        else throw std::runtime_error("Activation memory size too small to allocate one buffer row and one set outputs.");
+
+        if (wgt_policy_fits(sizes, ALL)) mapping.wgt_policy = ALL;
+        else if (wgt_policy_fits(sizes, SET)) mapping.wgt_policy = SET;
+        else if (wgt_policy_fits(sizes, CHANNELS)) mapping.wgt_policy = CHANNELS;
+        else throw std::runtime_error("Weight memory size too small to allocate one buffer row.");
+
+        if (MAPPING_SEARCH) {
+            mapping = search_conv_mapping(sizes);
+            this->mapping = describe_conv_mapping(mapping);
+            mapping_traffic = mapping.dram_traffic;
+        } else {
+            map_conv_layer(sizes, mapping);
+        }
+
+        const auto &act_policy = mapping.act_policy;
+        const auto &wgt_policy = mapping.wgt_policy;
+        const auto &total_filter_sets = sizes.total_filter_sets;
+        const auto &filter_sets_per_step = mapping.filter_sets_per_step;
+        const auto &filter_steps = mapping.filter_steps;
+        const auto &window_steps = mapping.window_steps;
+        const auto &time_steps = mapping.time_steps;
+        const auto &max_time_per_step = mapping.max_time_per_step;
+
+        if (act_policy == ALL)
+            this->next_layer_act_on_chip = true;
+
         if (this->arch->schedule() && act_policy == CHANNELS && max_time_per_step <= this->scheduler->getLookaheadH())
             throw std::runtime_error("Activation memory is too small to hold necessary Tactical activations");
 
@@ -178,11 +372,8 @@ namespace core {
                     node->window_sets = window_steps[wstep];
 
                     if (act_policy == ALL || act_policy == INPUTS) {
-                        if (wstep == 0 && fstep == 0 && tstep == 0 && !this->layer_act_on_chip) {
-                            auto first_address = this->act_address_map[0][0][0];
-                            auto last_address = this->act_address_map[Ny - 1][Nx - 1][last_act_blk - 1];
-                            node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        }
+                        if (wstep == 0 && fstep == 0 && tstep == 0 && !this->layer_act_on_chip)
+                            node->read_act_addresses = this->act_layer_addresses;
 
                     } else if (act_policy == SET || act_policy == SUBSET) {
                         if (fstep == 0 && tstep == 0 && ((!this->layer_act_on_chip && wstep == 0) || wstep != 0)) {
@@ -436,11 +627,8 @@ namespace core {
                 node->window_sets = window_steps[wstep];
 
                 if (act_policy == ALL || act_policy == INPUTS) {
-                    if (gstep == 0 && wstep == 0 && !this->layer_act_on_chip) {
-                        auto first_address = this->act_address_map[0][0][0];
-                        auto last_address = this->act_address_map[Ny - 1][Nx - 1][last_act_blk - 1];
-                        node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                    }
+                    if (gstep == 0 && wstep == 0 && !this->layer_act_on_chip)
+                        node->read_act_addresses = this->act_layer_addresses;
 
                 } else {
                     if ((!this->layer_act_on_chip && wstep == 0) || wstep != 0) {
@@ -744,6 +932,8 @@ namespace core {
 
     template <typename T>
     void WindowFirstOutS<T>::generate_execution_graph() {
+        mapping = "-";
+        mapping_traffic = 0;
         if (this->linear) generate_execution_graph_linear_layer();
         else if (this->groups > 1) generate_execution_graph_grouped_layer();
         else generate_execution_graph_conv_layer();
@@ -763,6 +953,117 @@ namespace core {
         // Generate execution graph for on-chip memory
         generate_execution_graph();
 
+        new_set = false;
+        node_set_simulated = false;
+        if (sampling()) sample_window_filter_sets();
+
+    }
+
+    template <typename T>
+    void WindowFirstOutS<T>::sample_window_filter_sets() {
+        tile_sets_per_window = (uint64_t)ceil(this->filter_sets / (double)this->arch->getTiles());
+        auto total_sets = this->groups * this->window_sets * tile_sets_per_window;
+        sampled_sets = std::vector<bool>(total_sets, false);
+        sampled_windows = std::vector<bool>(this->groups * this->window_sets, false);
+
+        std::uniform_real_distribution<double> distribution(0, 1);
+        auto stratum = std::max((uint64_t)round(1. / SAMPLING_RATE), (uint64_t)1);
+        uint64_t stratum_offset = 0;
+        for (uint64_t idx = 0; idx < total_sets; ++idx) {
+            bool sampled;
+            if (SAMPLING == "Random") {
+                sampled = distribution(generator) < SAMPLING_RATE;
+            } else {
+                // Stratified: one random set per group of 1/rate consecutive sets
+                if (idx % stratum == 0) stratum_offset = generator() % stratum;
+                sampled = idx % stratum == stratum_offset;
+            }
+
+            sampled_sets[idx] = sampled;
+            if (sampled) sampled_windows[idx / tile_sets_per_window] = true;
+        }
+
+        // The cycles of consecutive sets can alternate, so one or two sets at random warm up the pipeline and the
+        // measured sets start on either phase
+        warm_sets = std::vector<bool>(total_sets, false);
+        for (uint64_t idx = 1; idx < total_sets; ++idx) {
+            if (!sampled_sets[idx] || sampled_sets[idx - 1])
+                continue;
+
+            auto warm_up = std::min((uint64_t)(1 + generator() % 2), idx);
+            for (uint64_t w = 1; w <= warm_up && !sampled_sets[idx - w]; ++w) {
+                warm_sets[idx - w] = true;
+                sampled_windows[(idx - w) / tile_sets_per_window] = true;
+            }
+        }
+    }
+
+    template <typename T>
+    bool WindowFirstOutS<T>::sample_window_filter_set(uint64_t group_idx, uint64_t window_set, uint64_t filter_set) {
+        this->set_visits++;
+        auto idx = (group_idx * this->window_sets + window_set) * tile_sets_per_window +
+                filter_set / this->arch->getTiles();
+
+        // The sets that wait for the node reads are all simulated and keep their own cycles
+        auto transient = !node_set_simulated || this->dram->reading();
+        if (!sampled_sets[idx] && !warm_sets[idx] && !transient) return false;
+        this->simulated_sets++;
+        measured_set = sampled_sets[idx] && !transient;
+        warm_set = warm_sets[idx] && !transient;
+        node_set_simulated = true;
+        return true;
+    }
+
+    template <typename T>
+    bool WindowFirstOutS<T>::sampling() const {
+        return SAMPLING != "None";
+    }
+
+    template <typename T>
+    double WindowFirstOutS<T>::getEstimatedCycles() const {
+        const auto &set_cycles = this->set_cycles;
+        if (set_cycles.empty()) return this->getCycles();
+
+        // The clock ran over the skipped sets at the mean known at that point, and the warm-up sets started with an
+        // empty pipeline: replace both with the final mean
+        auto extrapolated_cycles = this->skipped_cycles + this->warm_cycles;
+
+        return this->getCycles() - extrapolated_cycles + this->getExtrapolatedSets() * sys::get_average(set_cycles);
+    }
+
+    template <typename T>
+    double WindowFirstOutS<T>::getEstimatedCyclesInterval() const {
+        const auto &set_cycles = this->set_cycles;
+        auto n = set_cycles.size();
+        if (n == 0) return 0;
+        auto skipped = this->getExtrapolatedSets();
+        if (n == 1) return skipped * (double)set_cycles.front();
+
+        // Extrapolating the sets total: N * t * s / sqrt(n) * sqrt(1 - n/N)
+        auto N = (double)(skipped + n);
+        auto t = sys::get_t_value(SAMPLING_CONFIDENCE, n - 1);
+        return N * t * sys::get_stdev(set_cycles) / sqrt(n) * sqrt(1 - n / N);
+    }
+
+    template <typename T>
+    double WindowFirstOutS<T>::getSimulatedFraction() const {
+        if (!sampling() || this->set_visits == 0) return 1;
+        return this->simulated_sets / (double)this->set_visits;
+    }
+
+    template <typename T>
+    bool WindowFirstOutS<T>::mapping_search() const {
+        return MAPPING_SEARCH;
+    }
+
+    template <typename T>
+    std::string WindowFirstOutS<T>::getMapping() const {
+        return mapping;
+    }
+
+    template <typename T>
+    uint64_t WindowFirstOutS<T>::getMappingTraffic() const {
+        return mapping_traffic;
     }
 
     template <typename T>
@@ -784,6 +1085,14 @@ namespace core {
 
             while (this->window_set_it < window_sets.size()) {
 
+                // Skip window sets without simulated filter sets
+                if (!this->window_buffer_filled && sampling() && node_set_simulated && !this->dram->reading() &&
+                        !sampled_windows[group_idx * this->window_sets + window_sets[this->window_set_it]]) {
+                    this->set_visits += (uint64_t)ceil(filter_tile_sets.size() / (double)this->arch->getTiles());
+                    this->window_set_it++;
+                    continue;
+                }
+
                 // Fill window buffer
                 if (!this->window_buffer_filled) {
 
@@ -809,10 +1118,18 @@ namespace core {
 
                     auto filter_set = filter_tile_sets[this->filter_set_it];
 
+                    // Skip non-sampled sets
+                    if (!this->filter_buffer_filled && sampling() &&
+                            !sample_window_filter_set(group_idx, window_sets[this->window_set_it], filter_set)) {
+                        this->filter_set_it += this->arch->getTiles();
+                        continue;
+                    }
+
                     // Filter set
                     if (!this->filter_buffer_filled) {
 
                         if (time_step == 0) this->tiles_done = false;
+                        new_set = sampling();
 
                         this->filters = std::vector<std::vector<int>>(this->arch->getTiles(), std::vector<int>());
 
@@ -936,13 +1253,17 @@ namespace core {
                                     this->next_out_address += this->dram->getWidth();
 
                                     tiles_data[t].out_banks[o] = out_bank_idx;
-                                    out_bank_idx = (out_bank_idx + 1) % this->gbuffer->getOutBanks();
+                                    out_bank_idx++;
                                 }
                             }
                             this->requested = 0;
                             this->skip = std::vector<int>(this->arch->getTiles(), 0);
                         }
 
+                        _tiles_data.set_start = new_set;
+                        _tiles_data.set_measured = new_set && measured_set;
+                        _tiles_data.set_warm = new_set && warm_set;
+                        new_set = false;
                         return true;
                     }
 
@@ -964,6 +1285,7 @@ namespace core {
         } // Groups
 
         this->group_it = 0;
+        node_set_simulated = false;
         return false;
 
     }
@@ -1114,7 +1436,7 @@ namespace core {
                             this->next_out_address += this->dram->getWidth();
 
                             tiles_data[t].out_banks[o] = out_bank_idx;
-                            out_bank_idx = (out_bank_idx + 1) % this->gbuffer->getOutBanks();
+                            out_bank_idx++;
                         }
                     }
                     this->requested = 0;
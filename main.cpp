@@ -47,16 +47,26 @@ base::Network<T> read(const sys::Batch::Simulate &simulate, bool QUIET) {
         network.setQuantised(simulate.quantised);
         network.setNetworkWidth(simulate.data_width);
         reader.read_precision(network);
-        reader.read_weights_npy(network);
-        reader.read_activations_npy(network);
+        if (simulate.synthetic) {
+            reader.set_synthetic(network, simulate.synthetic_samples, simulate.synthetic_act_sparsity,
+                    simulate.synthetic_wgt_sparsity);
+        } else {
+            reader.read_weights_npy(network);
+            reader.read_activations_npy(network);
+        }
 
     } else if (simulate.model == "CSV") {
         network = reader.read_network_csv();
         network.setQuantised(simulate.quantised);
         network.setNetworkWidth(simulate.data_width);
         reader.read_precision(network);
-        reader.read_weights_npy(network);
-        reader.read_activations_npy(network);
+        if (simulate.synthetic) {
+            reader.set_synthetic(network, simulate.synthetic_samples, simulate.synthetic_act_sparsity,
+                    simulate.synthetic_wgt_sparsity);
+        } else {
+            reader.read_weights_npy(network);
+            reader.read_activations_npy(network);
+        }
 
     } else {
 		throw std::runtime_error("Input model option not recognized");
@@ -66,6 +76,319 @@ base::Network<T> read(const sys::Batch::Simulate &simulate, bool QUIET) {
 
 }
 
+/**
+ * Return the DRAM parameters of an experiment
+ * @param simulate      Simulation parameters
+ * @param experiment    Experiment parameters
+ * @param network       Network name
+ * @return DRAM parameters
+ */
+core::DRAMOptions dram_options(const sys::Batch::Simulate &simulate,
+        const sys::Batch::Simulate::Experiment &experiment, const std::string &network) {
+    core::DRAMOptions options;
+    options.width = experiment.dram_width;
+    options.size = experiment.dram_size;
+    options.data_size = simulate.data_width;
+    options.clock_freq = experiment.cpu_clock_freq;
+    options.start_act_address = experiment.dram_start_act_address;
+    options.start_wgt_address = experiment.dram_start_wgt_address;
+    options.dram_conf = experiment.dram_conf;
+    options.system_conf = "system.ini";
+    options.network = network;
+    options.backend = experiment.dram_backend;
+    options.latency = experiment.dram_latency;
+    options.bandwidth = experiment.dram_bandwidth;
+    options.row_miss_latency = experiment.dram_row_miss_latency;
+    options.banks = experiment.dram_banks;
+    options.row_size = experiment.dram_row_size;
+    options.vis_output = experiment.dram_vis_output;
+    options.transaction_log = experiment.dram_transaction_log;
+    options.trace_dir = experiment.dram_trace_dir;
+    options.prefetch = experiment.dram_prefetch;
+    options.compression = experiment.dram_compression;
+    options.packing = experiment.dram_packing;
+    options.layout = experiment.dram_layout;
+    options.wgt_backend = experiment.dram_wgt_backend;
+    options.wgt_dram_conf = experiment.dram_wgt_conf;
+    options.wgt_latency = experiment.dram_wgt_latency;
+    options.wgt_bandwidth = experiment.dram_wgt_bandwidth;
+    options.act_burst = experiment.dram_act_burst;
+    options.wgt_burst = experiment.dram_wgt_burst;
+    return options;
+}
+
+/**
+ * Create the memory hierarchy and the dataflow control of an experiment
+ * @tparam T Data type of the simulation
+ * @param simulate      Simulation parameters
+ * @param experiment    Experiment parameters
+ * @param network       Network name
+ * @return Control of the experiment, null if the dataflow is not recognized
+ */
+template <typename T>
+std::shared_ptr<core::Control<T>> create_control(const sys::Batch::Simulate &simulate,
+        const sys::Batch::Simulate::Experiment &experiment, const std::string &network) {
+
+    auto tracked_data = std::make_shared<std::map<uint64_t, uint32_t>>();
+    auto act_addresses = std::make_shared<core::AddressRange>();
+    auto out_addresses = std::make_shared<core::AddressRange>();
+    auto wgt_addresses = std::make_shared<core::AddressRange>();
+
+    auto dram = std::make_shared<core::DRAM<T>>(tracked_data, act_addresses, out_addresses, wgt_addresses,
+            dram_options(simulate, experiment, network));
+
+    auto gbuffer = std::make_shared<core::GlobalBuffer<T>>(tracked_data, act_addresses, out_addresses,
+            wgt_addresses, experiment.gbuffer_act_levels, experiment.gbuffer_wgt_levels, experiment.gbuffer_act_size,
+            experiment.gbuffer_wgt_size, experiment.gbuffer_act_banks, experiment.gbuffer_wgt_banks,
+            experiment.gbuffer_act_bank_width, experiment.gbuffer_wgt_bank_width, experiment.dram_width,
+            experiment.gbuffer_act_read_delay, experiment.gbuffer_act_write_delay, experiment.gbuffer_wgt_read_delay,
+            experiment.gbuffer_act_eviction_policy, experiment.gbuffer_wgt_eviction_policy);
+
+    auto abuffer = std::make_shared<core::LocalBuffer<T>>(tracked_data, act_addresses, out_addresses, wgt_addresses,
+            experiment.abuffer_rows, experiment.abuffer_read_delay, core::NULL_DELAY);
+
+    auto pbuffer = std::make_shared<core::LocalBuffer<T>>(tracked_data, act_addresses, out_addresses, wgt_addresses,
+            experiment.pbuffer_rows, experiment.pbuffer_read_delay, core::NULL_DELAY);
+
+    auto wbuffer = std::make_shared<core::LocalBuffer<T>>(tracked_data, act_addresses, out_addresses, wgt_addresses,
+            experiment.wbuffer_rows, experiment.wbuffer_read_delay, core::NULL_DELAY);
+
+    auto obuffer = std::make_shared<core::LocalBuffer<T>>(tracked_data, act_addresses, out_addresses, wgt_addresses,
+            experiment.obuffer_rows, core::NULL_DELAY, experiment.obuffer_write_delay);
+
+    auto composer = std::make_shared<core::Composer<T>>(experiment.composer_inputs, experiment.composer_delay);
+
+    auto ppu = std::make_shared<core::PPU<T>>(experiment.ppu_inputs, experiment.ppu_delay,
+            experiment.ppu_stream_writes);
+
+    auto scheduler = std::make_shared<core::BitTactical<T>>(experiment.lookahead_h, experiment.lookaside_d,
+            experiment.search_shape.c_str()[0]);
+
+    std::shared_ptr<core::Control<T>> control;
+    if (experiment.dataflow == "WindowFirstOutS")
+        control = std::make_shared<core::WindowFirstOutS<T>>(scheduler, dram, gbuffer, abuffer, pbuffer, wbuffer,
+                obuffer, composer, ppu, experiment.sampling, experiment.sampling_rate,
+                experiment.sampling_confidence, experiment.mapping_search);
+
+    return control;
+}
+
+/** Dataflow keys an experiment parameter takes part of */
+enum KeyScope {
+    /** Tiling and off-chip addresses: part of every key */
+    MAPPING,
+    /** On-chip steps: part of the dataflow stream key */
+    STREAM,
+    /** Architecture compute: part of the memory trace key */
+    TRACE
+};
+
+/** Experiment parameter taking part in the dataflow keys */
+struct KeyField {
+
+    /** Parameter name */
+    std::string name;
+
+    /** Keys the parameter takes part of */
+    KeyScope scope;
+
+    /** Parameter value as text */
+    std::function<std::string(const sys::Batch::Simulate::Experiment &)> value;
+
+};
+
+/**
+ * Return a parameter value as text for the dataflow keys
+ * @param value Parameter value
+ * @return Parameter value as text
+ */
+std::string key_value(const std::string &value) { return value; }
+
+template <typename V>
+std::string key_value(const V &value) { return std::to_string(value); }
+
+template <typename V>
+std::string key_value(const std::vector<V> &values) {
+    std::string value;
+    for (const auto &v : values) value += std::to_string(v) + ",";
+    return value;
+}
+
+/** Key field reading a parameter of the experiment */
+#define KEY_FIELD(scope, field) \
+    {#field, scope, [](const sys::Batch::Simulate::Experiment &experiment) { return key_value(experiment.field); }}
+
+/**
+ * Parameters that change the steps generated by the dataflow.
+ * The dataflow tiles the layers for the outermost global buffer level and maps the data to the DRAM layout, so these
+ * parameters set the mapping. The banks and the inner levels only change where the on-chip data is stored, so they
+ * only set the on-chip stream. The architecture parameters do not change the dataflow steps, but they change the
+ * compute cycles recorded in a memory trace. The DRAM timing and the on-chip delays are not part of any key.
+ */
+const std::vector<KeyField> KEY_FIELDS = {
+    KEY_FIELD(MAPPING, dataflow),
+    KEY_FIELD(MAPPING, lanes),
+    KEY_FIELD(MAPPING, columns),
+    KEY_FIELD(MAPPING, rows),
+    KEY_FIELD(MAPPING, tiles),
+    KEY_FIELD(MAPPING, pe_width),
+    KEY_FIELD(MAPPING, tactical),
+    KEY_FIELD(MAPPING, lookahead_h),
+    KEY_FIELD(MAPPING, lookaside_d),
+    KEY_FIELD(MAPPING, search_shape),
+    KEY_FIELD(MAPPING, diffy),
+    {"pow2_data", MAPPING, [](const sys::Batch::Simulate::Experiment &experiment) {
+        return key_value((experiment.architecture == "BitPragmatic" && !experiment.diffy) ||
+                experiment.architecture == "Laconic");
+    }},
+    KEY_FIELD(MAPPING, dram_width),
+    KEY_FIELD(MAPPING, dram_size),
+    KEY_FIELD(MAPPING, dram_start_act_address),
+    KEY_FIELD(MAPPING, dram_start_wgt_address),
+    KEY_FIELD(MAPPING, dram_compression),
+    KEY_FIELD(MAPPING, dram_packing),
+    KEY_FIELD(MAPPING, dram_layout),
+    KEY_FIELD(MAPPING, dram_row_size),
+    KEY_FIELD(MAPPING, gbuffer_act_size.front()),
+    KEY_FIELD(MAPPING, gbuffer_wgt_size.front()),
+    KEY_FIELD(MAPPING, gbuffer_act_bank_width),
+    KEY_FIELD(MAPPING, sampling),
+    KEY_FIELD(MAPPING, sampling_rate),
+    KEY_FIELD(MAPPING, sampling_confidence),
+    KEY_FIELD(MAPPING, mapping_search),
+    KEY_FIELD(STREAM, gbuffer_act_levels),
+    KEY_FIELD(STREAM, gbuffer_wgt_levels),
+    KEY_FIELD(STREAM, gbuffer_act_banks),
+    KEY_FIELD(STREAM, gbuffer_wgt_banks),
+    KEY_FIELD(STREAM, gbuffer_wgt_bank_width),
+    KEY_FIELD(STREAM, gbuffer_act_size),
+    KEY_FIELD(STREAM, gbuffer_wgt_size),
+    KEY_FIELD(TRACE, architecture),
+    KEY_FIELD(TRACE, column_registers),
+    KEY_FIELD(TRACE, booth),
+    KEY_FIELD(TRACE, group_size),
+    KEY_FIELD(TRACE, minor_bit),
+    KEY_FIELD(TRACE, bits_first_stage),
+    KEY_FIELD(TRACE, pe_serial_bits),
+    KEY_FIELD(TRACE, dynamic_weights)
+};
+
+#undef KEY_FIELD
+
+/**
+ * Return a key made of the parameters of an experiment that take part in the mapping and in a second scope
+ * @param experiment    Experiment parameters
+ * @param scope         Second scope of the key
+ * @return Key of the experiment, empty if the dataflow can not be shared
+ */
+std::string experiment_key(const sys::Batch::Simulate::Experiment &experiment, KeyScope scope) {
+    if (experiment.dataflow != "WindowFirstOutS") return "";
+
+    std::string key;
+    for (const auto &field : KEY_FIELDS)
+        if (field.scope == MAPPING || field.scope == scope)
+            key += field.name + "=" + field.value(experiment) + ";";
+    return key;
+}
+
+/**
+ * Return a key identifying the on-chip and off-chip steps generated by the dataflow of an experiment
+ * Experiments with the same key can share a single dataflow traversal
+ * @param experiment Experiment parameters
+ * @return Key of the dataflow stream, empty if the experiment can not be co-simulated
+ */
+std::string stream_key(const sys::Batch::Simulate::Experiment &experiment) {
+    return experiment_key(experiment, STREAM);
+}
+
+/**
+ * Return a key identifying the architecture and dataflow mapping of an experiment
+ * Experiments with the same key can replay a memory trace recorded by any of them, whatever their global buffer
+ * banks, inner levels and DRAM timing
+ * @param experiment Experiment parameters
+ * @return Key of the memory trace, empty if the experiment can not be replayed
+ */
+std::string trace_key(const sys::Batch::Simulate::Experiment &experiment) {
+    return experiment_key(experiment, TRACE);
+}
+
+/**
+ * Cycles experiments waiting to share a dataflow traversal and the last recorded memory trace
+ * @tparam T Data type of the simulation
+ */
+template <typename T>
+struct CyclesQueue {
+
+    /** Controls waiting to be co-simulated */
+    std::vector<std::shared_ptr<core::Control<T>>> controls;
+
+    /** Dataflow stream key of the waiting controls */
+    std::string stream_key;
+
+    /** Last recorded memory trace */
+    std::shared_ptr<core::MemoryTrace<T>> trace;
+
+    /** Key of the last recorded memory trace */
+    std::string trace_key;
+
+};
+
+/**
+ * Simulate the waiting co-simulated experiments
+ * @tparam T Data type of the simulation
+ * @param DNNsim    Simulator
+ * @param network   Network to simulate
+ * @param queue     Waiting experiments
+ */
+template <typename T>
+void flush_cycles(core::Simulator<T> &DNNsim, const base::Network<T> &network, CyclesQueue<T> &queue) {
+    if (!queue.controls.empty()) DNNsim.run(network, queue.controls);
+    queue.controls.clear();
+    queue.stream_key.clear();
+}
+
+/**
+ * Simulate the cycles of an experiment. Depending on the simulation options, the experiment is grouped with the
+ * previous experiments sharing the same dataflow stream, or replays the memory trace of a previous experiment with
+ * the same architecture.
+ * @tparam T Data type of the simulation
+ * @param DNNsim        Simulator
+ * @param network       Network to simulate
+ * @param control       Control of the experiment with the architecture already set
+ * @param simulate      Simulation parameters
+ * @param experiment    Experiment parameters
+ * @param queue         Waiting experiments
+ */
+template <typename T>
+void run_cycles(core::Simulator<T> &DNNsim, const base::Network<T> &network,
+        const std::shared_ptr<core::Control<T>> &control, const sys::Batch::Simulate &simulate,
+        const sys::Batch::Simulate::Experiment &experiment, CyclesQueue<T> &queue) {
+
+    if (simulate.memory_replay) {
+        auto key = trace_key(experiment);
+        if (key.empty()) {
+            DNNsim.run(network, control);
+        } else if (key == queue.trace_key) {
+            DNNsim.replay(network, control, queue.trace);
+        } else {
+            queue.trace = std::make_shared<core::MemoryTrace<T>>();
+            queue.trace_key = key;
+            DNNsim.run(network, {control}, queue.trace);
+        }
+        return;
+    }
+
+    auto key = simulate.cosimulate ? stream_key(experiment) : "";
+    if (key.empty()) {
+        DNNsim.run(network, control);
+        return;
+    }
+
+    if (key != queue.stream_key) flush_cycles(DNNsim, network, queue);
+    queue.stream_key = key;
+    queue.controls.push_back(control);
+}
+
 void check_options(const cxxopts::Options &options)
 {
     if(options.count("batch") == 0) {
@@ -93,6 +416,10 @@ cxxopts::Options parse_options(int argc, char *argv[]) {
     options.add_options("simulation")
     ("q,quiet", "Don't show stdout progress messages",cxxopts::value<bool>(),"<Boolean>")
     ("fast_mode", "Enable fast mode: simulate only one sample",cxxopts::value<bool>(),"<Boolean>")
+    ("adaptive_error", "Stop simulating samples when the per-layer cycles mean is within this relative error",
+            cxxopts::value<double>(),"<Positive Number>")
+    ("adaptive_confidence", "Confidence level for the adaptive relative error (default 0.95)",
+            cxxopts::value<double>(),"<Positive Number>")
     ("check_values", "Check the correctness of the output values of the simulations.", cxxopts::value<bool>(),
             "<Boolean>");
 
@@ -118,6 +445,11 @@ int main(int argc, char *argv[]) {
         bool QUIET = options.count("quiet") == 0 ? false : options["quiet"].as<bool>();
         bool FAST_MODE = options.count("fast_mode") == 0 ? false : options["fast_mode"].as<bool>();
         bool CHECK = options.count("check_values") == 0 ? false : options["check_values"].as<bool>();
+        double ADAPTIVE_ERROR = options.count("adaptive_error") == 0 ? 0 : options["adaptive_error"].as<double>();
+        double ADAPTIVE_CONFIDENCE = options.count("adaptive_confidence") == 0 ? 0.95 :
+                options["adaptive_confidence"].as<double>();
+        if (ADAPTIVE_CONFIDENCE <= 0 || ADAPTIVE_CONFIDENCE >= 1)
+            throw std::runtime_error("Adaptive confidence must be between 0 and 1.");
         std::string batch_path = options["batch"].as<std::string>();
         sys::Batch batch = sys::Batch(batch_path);
         batch.read_batch();
@@ -131,57 +463,12 @@ int main(int argc, char *argv[]) {
                 // Inference traces
                 if (simulate.data_type == "Float") {
                     auto network = read<float>(simulate, QUIET);
-                    for(const auto &experiment : simulate.experiments) {
-
-                        auto tracked_data = std::make_shared<std::map<uint64_t, uint32_t>>();
-                        auto act_addresses = std::make_shared<core::AddressRange>();
-                        auto out_addresses = std::make_shared<core::AddressRange>();
-                        auto wgt_addresses = std::make_shared<core::AddressRange>();
-
-                        auto dram = std::make_shared<core::DRAM<float>>(tracked_data, act_addresses, out_addresses,
-                                wgt_addresses, experiment.dram_width, experiment.dram_size, simulate.data_width,
-                                experiment.cpu_clock_freq, experiment.dram_start_act_address,
-                                experiment.dram_start_wgt_address, experiment.dram_conf, "system.ini", network.getName());
-
-                        auto gbuffer = std::make_shared<core::GlobalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.gbuffer_act_levels,
-                                experiment.gbuffer_wgt_levels, experiment.gbuffer_act_size, experiment.gbuffer_wgt_size,
-                                experiment.gbuffer_act_banks, experiment.gbuffer_wgt_banks,
-                                experiment.gbuffer_act_bank_width, experiment.gbuffer_wgt_bank_width,
-                                experiment.dram_width, experiment.gbuffer_act_read_delay,
-                                experiment.gbuffer_act_write_delay, experiment.gbuffer_wgt_read_delay,
-                                experiment.gbuffer_act_eviction_policy, experiment.gbuffer_wgt_eviction_policy);
-
-                        auto abuffer = std::make_shared<core::LocalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.abuffer_rows, experiment.abuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto pbuffer = std::make_shared<core::LocalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.pbuffer_rows, experiment.pbuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto wbuffer = std::make_shared<core::LocalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.wbuffer_rows, experiment.wbuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto obuffer = std::make_shared<core::LocalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.obuffer_rows, core::NULL_DELAY,
-                                experiment.obuffer_write_delay);
+                    core::Simulator<float> DNNsim(FAST_MODE, QUIET, CHECK, ADAPTIVE_ERROR, ADAPTIVE_CONFIDENCE);
+                    CyclesQueue<float> cycles_queue;
 
-                        auto composer = std::make_shared<core::Composer<float>>(experiment.composer_inputs,
-                                experiment.composer_delay);
-
-                        auto ppu = std::make_shared<core::PPU<float>>(experiment.ppu_inputs, experiment.ppu_delay);
-
-                        auto scheduler = std::make_shared<core::BitTactical<float>>(experiment.lookahead_h,
-                                experiment.lookaside_d, experiment.search_shape.c_str()[0]);
-
-                        std::shared_ptr<core::Control<float>> control;
-                        if (experiment.dataflow == "WindowFirstOutS")
-                            control = std::make_shared<core::WindowFirstOutS<float>>(scheduler, dram, gbuffer, abuffer,
-                                    pbuffer, wbuffer, obuffer, composer, ppu);
+                    for(const auto &experiment : simulate.experiments) {
 
-                        core::Simulator<float> DNNsim(FAST_MODE, QUIET, CHECK);
+                        auto control = create_control<float>(simulate, experiment, network.getName());
 
                         if (experiment.architecture == "SCNN") {
                             std::shared_ptr<core::Architecture<float>> arch =
@@ -199,12 +486,14 @@ int main(int argc, char *argv[]) {
 
                             if (experiment.task == "Cycles") {
                                 control->setArch(arch);
-                                DNNsim.run(network, control);
+                                run_cycles(DNNsim, network, control, simulate, experiment, cycles_queue);
                             } else if (experiment.task == "Potentials")
                                 DNNsim.potentials(network, arch);
                         }
                     }
 
+                    flush_cycles(DNNsim, network, cycles_queue);
+
                 } else if (simulate.data_type == "Fixed") {
                     base::Network<uint16_t> network;
                     {
@@ -213,57 +502,12 @@ int main(int argc, char *argv[]) {
                         network = tmp_network.fixed_point();
                     }
 
-                    for (const auto &experiment : simulate.experiments) {
-
-                        auto tracked_data = std::make_shared<std::map<uint64_t, uint32_t>>();
-                        auto act_addresses = std::make_shared<core::AddressRange>();
-                        auto out_addresses = std::make_shared<core::AddressRange>();
-                        auto wgt_addresses = std::make_shared<core::AddressRange>();
-
-                        auto dram = std::make_shared<core::DRAM<uint16_t>>(tracked_data, act_addresses, out_addresses,
-                                wgt_addresses, experiment.dram_width, experiment.dram_size, simulate.data_width,
-                                experiment.cpu_clock_freq, experiment.dram_start_act_address,
-                                experiment.dram_start_wgt_address, experiment.dram_conf, "system.ini", network.getName());
-
-                        auto gbuffer = std::make_shared<core::GlobalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.gbuffer_act_levels,
-                                experiment.gbuffer_wgt_levels, experiment.gbuffer_act_size, experiment.gbuffer_wgt_size,
-                                experiment.gbuffer_act_banks, experiment.gbuffer_wgt_banks,
-                                experiment.gbuffer_act_bank_width, experiment.gbuffer_wgt_bank_width,
-                                experiment.dram_width, experiment.gbuffer_act_read_delay,
-                                experiment.gbuffer_act_write_delay, experiment.gbuffer_wgt_read_delay,
-                                experiment.gbuffer_act_eviction_policy, experiment.gbuffer_wgt_eviction_policy);
+                    core::Simulator<uint16_t> DNNsim(FAST_MODE, QUIET, CHECK, ADAPTIVE_ERROR, ADAPTIVE_CONFIDENCE);
+                    CyclesQueue<uint16_t> cycles_queue;
 
-                        auto abuffer = std::make_shared<core::LocalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.abuffer_rows, experiment.abuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto pbuffer = std::make_shared<core::LocalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.pbuffer_rows, experiment.pbuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto wbuffer = std::make_shared<core::LocalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.wbuffer_rows, experiment.wbuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto obuffer = std::make_shared<core::LocalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.obuffer_rows, core::NULL_DELAY,
-                                experiment.obuffer_write_delay);
-
-                        auto composer = std::make_shared<core::Composer<uint16_t>>(experiment.composer_inputs,
-                                experiment.composer_delay);
-
-                        auto ppu = std::make_shared<core::PPU<uint16_t>>(experiment.ppu_inputs, experiment.ppu_delay);
-
-                        auto scheduler = std::make_shared<core::BitTactical<uint16_t>>(experiment.lookahead_h,
-                                experiment.lookaside_d, experiment.search_shape.c_str()[0]);
-
-                        std::shared_ptr<core::Control<uint16_t>> control;
-                        if (experiment.dataflow == "WindowFirstOutS")
-                            control = std::make_shared<core::WindowFirstOutS<uint16_t>>(scheduler, dram, gbuffer,
-                                    abuffer, pbuffer, wbuffer, obuffer, composer, ppu);
+                    for (const auto &experiment : simulate.experiments) {
 
-                        core::Simulator<uint16_t> DNNsim(FAST_MODE, QUIET, CHECK);
+                        auto control = create_control<uint16_t>(simulate, experiment, network.getName());
 
                         if (experiment.architecture == "SCNN") {
                             std::shared_ptr<core::Architecture<uint16_t>> arch =
@@ -282,7 +526,7 @@ int main(int argc, char *argv[]) {
 
                             if (experiment.task == "Cycles") {
                                 control->setArch(arch);
-                                DNNsim.run(network, control);
+                                run_cycles(DNNsim, network, control, simulate, experiment, cycles_queue);
                             } else if (experiment.task == "Potentials")
                                 DNNsim.potentials(network, arch);
 
@@ -293,7 +537,7 @@ int main(int argc, char *argv[]) {
 
                             if (experiment.task == "Cycles") {
                                 control->setArch(arch);
-                                DNNsim.run(network, control);
+                                run_cycles(DNNsim, network, control, simulate, experiment, cycles_queue);
                             } else if (experiment.task == "Potentials")
                                 DNNsim.potentials(network, arch);
 
@@ -306,7 +550,7 @@ int main(int argc, char *argv[]) {
 
                             if (experiment.task == "Cycles") {
                                 control->setArch(arch);
-                                DNNsim.run(network, control);
+                                run_cycles(DNNsim, network, control, simulate, experiment, cycles_queue);
                             } else if (experiment.task == "Potentials")
                                 DNNsim.potentials(network, arch);
 
@@ -318,7 +562,7 @@ int main(int argc, char *argv[]) {
 
                             if (experiment.task == "Cycles") {
                                 control->setArch(arch);
-                                DNNsim.run(network, control);
+                                run_cycles(DNNsim, network, control, simulate, experiment, cycles_queue);
                             } else if (experiment.task == "Potentials")
                                 DNNsim.potentials(network, arch);
 
@@ -331,7 +575,7 @@ int main(int argc, char *argv[]) {
 
                             if (experiment.task == "Cycles") {
                                 control->setArch(arch);
-                                DNNsim.run(network, control);
+                                run_cycles(DNNsim, network, control, simulate, experiment, cycles_queue);
                             } else if (experiment.task == "Potentials")
                                 DNNsim.potentials(network, arch);
 
@@ -342,13 +586,15 @@ int main(int argc, char *argv[]) {
 
                             if (experiment.task == "Cycles") {
                                 control->setArch(arch);
-                                DNNsim.run(network, control);
+                                run_cycles(DNNsim, network, control, simulate, experiment, cycles_queue);
                             } else if (experiment.task == "Potentials")
                                 DNNsim.potentials(network, arch);
 
                         }
 
                     }
+
+                    flush_cycles(DNNsim, network, cycles_queue);
                 }
             
 			} catch (std::exception &exception) {
@@ -116,6 +116,63 @@ namespace sys {
 
                 std::string dram_conf;
 
+                /** DRAM timing model */
+                std::string dram_backend;
+
+                /** DRAM transaction latency in cycles for the analytic models */
+                uint32_t dram_latency = 0;
+
+                /** DRAM transactions per cycle for the analytic models */
+                double dram_bandwidth = 0;
+
+                /** DRAM extra cycles to open a new row for the bank model */
+                uint32_t dram_row_miss_latency = 0;
+
+                /** DRAM banks for the bank model */
+                uint32_t dram_banks = 0;
+
+                /** DRAM row size in bytes for the bank model */
+                uint32_t dram_row_size = 0;
+
+                /** Write the DRAMSim2 visualization file */
+                bool dram_vis_output = false;
+
+                /** File to record and replay the DRAM transaction stream */
+                std::string dram_transaction_log;
+
+                /** Folder to export the DRAM transactions of each layer as DRAMSim2 traces */
+                std::string dram_trace_dir;
+
+                /** Prefetch the next on-chip stage while the current one computes */
+                bool dram_prefetch = false;
+
+                /** Zero-value compression of the off-chip activations and weights */
+                std::string dram_compression;
+
+                /** Off-chip layout of the values: power of two sizes, layer precision or block precision */
+                std::string dram_packing;
+
+                /** Off-chip layout of the activations */
+                std::string dram_layout;
+
+                /** Timing model of the dedicated weight memory, empty if weights share the memory */
+                std::string dram_wgt_backend;
+
+                /** DRAM configuration file of the dedicated weight memory */
+                std::string dram_wgt_conf;
+
+                /** Transaction latency in cycles of the dedicated weight memory */
+                uint32_t dram_wgt_latency = 0;
+
+                /** Transactions per cycle of the dedicated weight memory */
+                double dram_wgt_bandwidth = 0;
+
+                /** Consecutive activation and partial sum reads per round of the read arbitration */
+                uint32_t dram_act_burst = 0;
+
+                /** Consecutive weight reads per round of the read arbitration */
+                uint32_t dram_wgt_burst = 0;
+
                 uint32_t gbuffer_act_levels = 0;
 
                 uint32_t gbuffer_wgt_levels = 0;
@@ -189,6 +246,21 @@ namespace sys {
                 /** Post-Processing Unit delay */
                 uint32_t ppu_delay = 0;
 
+                /** Post-process and write back the outputs as they are produced */
+                bool ppu_stream_writes = false;
+
+                /** Window-filter set sampling */
+                std::string sampling;
+
+                /** Fraction of window-filter sets simulated */
+                double sampling_rate = 0;
+
+                /** Confidence level for the sampled cycles */
+                double sampling_confidence = 0;
+
+                /** Search the memory policies and tiling of each convolutional layer */
+                bool mapping_search = false;
+
             };
 
             /** Batch number of the traces */
@@ -209,6 +281,24 @@ namespace sys {
             /** True if traces already quantised */
             bool quantised = false;
 
+            /** True if values are generated from the layer shapes instead of read from traces */
+            bool synthetic = false;
+
+            /** Fraction of zero synthetic activations */
+            double synthetic_act_sparsity = 0;
+
+            /** Fraction of zero synthetic weights */
+            double synthetic_wgt_sparsity = 0;
+
+            /** Number of synthetic input samples */
+            uint32_t synthetic_samples = 1;
+
+            /** True if experiments with the same dataflow stream share a single dataflow traversal */
+            bool cosimulate = false;
+
+            /** True if experiments that only change the memory timing replay the memory trace of the previous one */
+            bool memory_replay = false;
+
             /** Array of experiments */
             std::vector<Experiment> experiments;
         };
@@ -134,6 +134,31 @@ namespace sys {
         return get_max(maxs);
     }
 
+    /**
+     * Return the sample standard deviation of a 1D vector
+     * @tparam T Data type of the stat
+     * @param vector_stat 1D Vector with the stats
+     * @return Standard deviation of the vector
+     */
+    template <typename T>
+    double get_stdev(const std::vector<T> &vector_stat)
+    {
+        if (vector_stat.size() < 2) return 0;
+        double mean = accumulate(vector_stat.begin(), vector_stat.end(), 0.0) / vector_stat.size();
+        double sq_sum = 0;
+        for (const auto &value : vector_stat)
+            sq_sum += (value - mean) * (value - mean);
+        return sqrt(sq_sum / (vector_stat.size() - 1));
+    }
+
+    /**
+     * Return the two-sided critical value of the Student's t distribution
+     * @param confidence Confidence level (e.g. 0.95)
+     * @param dof Degrees of freedom
+     * @return Critical value
+     */
+    double get_t_value(double confidence, uint64_t dof);
+
     /**
     * Type of statistics
     */
@@ -231,6 +256,12 @@ namespace sys {
          */
         virtual std::string dist_to_string() = 0;
 
+        /**
+         * Change the number of samples per layer, keeping the first values
+         * @param _batch_size New number of samples
+         */
+        virtual void resize(uint64_t _batch_size) = 0;
+
     };
 
     /**
@@ -290,6 +321,12 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Change the number of samples per layer, keeping the first values
+         * @param _batch_size New number of samples
+         */
+        void resize(uint64_t _batch_size) override;
+
     };
 
     /**
@@ -348,6 +385,12 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Change the number of samples per layer, keeping the first values
+         * @param _batch_size New number of samples
+         */
+        void resize(uint64_t _batch_size) override;
+
     };
 
     /**
@@ -406,6 +449,12 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Change the number of samples per layer, keeping the first values
+         * @param _batch_size New number of samples
+         */
+        void resize(uint64_t _batch_size) override;
+
     };
 
     /**
@@ -477,6 +526,12 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Change the number of samples per layer, keeping the first values
+         * @param _batch_size New number of samples
+         */
+        void resize(uint64_t _batch_size) override;
+
     };
 
     /**
@@ -548,6 +603,12 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Change the number of samples per layer, keeping the first values
+         * @param _batch_size New number of samples
+         */
+        void resize(uint64_t _batch_size) override;
+
     };
 
     /**
@@ -677,6 +738,12 @@ namespace sys {
         std::shared_ptr<stat_double_dist_t> register_double_dist_t(const std::string &name, int64_t min_range,
                 int64_t max_range, double init_value, Measure measure, bool skip_first = false);
 
+        /**
+         * Change the number of samples of all registered stats, keeping the first values
+         * @param _batch_size New number of samples
+         */
+        void resize(uint64_t _batch_size);
+
         /**
          * Return all stats per sample in a csv file
          * @param network_name Name of the network
@@ -687,6 +754,17 @@ namespace sys {
         void dump_csv(const std::string &network_name, const std::vector<std::string> &layers_name,
                 const std::string &header, bool QUIET);
 
+        /**
+         * Return all stats per sample in a csv file inside a subfolder of the network results
+         * @param network_name Name of the network
+         * @param layers_name Name of the layers
+         * @param header Header for the results
+         * @param folder Subfolder inside results/<network_name>
+         * @param QUIET Avoid std::out messages
+         */
+        void dump_csv(const std::string &network_name, const std::vector<std::string> &layers_name,
+                const std::string &header, const std::string &folder, bool QUIET);
+
     };
 
 } //namespace sim
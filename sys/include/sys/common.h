@@ -7,6 +7,7 @@
 #include <list>
 #include <unordered_map>
 #include <set>
+#include <map>
 #include <string>
 #include <cmath>
 #include <memory>
@@ -19,6 +20,7 @@
 #include <numeric>
 #include <unistd.h>
 #include <iomanip>
+#include <random>
 //#include <math.h>
 
 #define INITIALISE_DATA_TYPES(name) \
@@ -71,6 +71,16 @@ namespace sys {
         simulate.network = simulate_proto.network();
         simulate.batch = simulate_proto.batch();
         simulate.quantised = simulate_proto.quantised();
+        simulate.synthetic = simulate_proto.synthetic();
+        simulate.synthetic_act_sparsity = simulate_proto.synthetic_act_sparsity();
+        simulate.synthetic_wgt_sparsity = simulate_proto.synthetic_wgt_sparsity();
+        simulate.synthetic_samples = simulate_proto.synthetic_samples() == 0 ? 1 : simulate_proto.synthetic_samples();
+        simulate.cosimulate = simulate_proto.cosimulate();
+        simulate.memory_replay = simulate_proto.memory_replay();
+
+        if (simulate.synthetic_act_sparsity < 0 || simulate.synthetic_act_sparsity >= 1 ||
+                simulate.synthetic_wgt_sparsity < 0 || simulate.synthetic_wgt_sparsity >= 1)
+            throw std::runtime_error("Synthetic sparsity must be in the range [0, 1).");
 
         const auto &model = simulate_proto.model();
         if(model  != "Caffe" && model != "CSV")
@@ -123,6 +133,64 @@ namespace sys {
                     experiment_proto.dram_conf();
             experiment.dram_conf = "ini/" + experiment.dram_conf + ".ini";
 
+            experiment.dram_backend = experiment_proto.dram_backend().empty() ? "DRAMSim2" :
+                    experiment_proto.dram_backend();
+
+            const auto &backend = experiment.dram_backend;
+            if (backend != "DRAMSim2" && backend != "Ideal" && backend != "Fixed" && backend != "Bank")
+                throw std::runtime_error("DRAM backend needs to be <DRAMSim2|Ideal|Fixed|Bank>.");
+
+            experiment.dram_latency = experiment_proto.dram_latency() < 1 ? 50 : experiment_proto.dram_latency();
+            experiment.dram_bandwidth = experiment_proto.dram_bandwidth() <= 0 ? 0.4 :
+                    experiment_proto.dram_bandwidth();
+            experiment.dram_row_miss_latency = experiment_proto.dram_row_miss_latency() < 1 ? 30 :
+                    experiment_proto.dram_row_miss_latency();
+            experiment.dram_banks = experiment_proto.dram_banks() < 1 ? 16 : experiment_proto.dram_banks();
+            experiment.dram_row_size = experiment_proto.dram_row_size() < 1 ? 8192 : experiment_proto.dram_row_size();
+            experiment.dram_vis_output = experiment_proto.dram_vis_output();
+            experiment.dram_transaction_log = experiment_proto.dram_transaction_log();
+            experiment.dram_trace_dir = experiment_proto.dram_trace_dir();
+            experiment.dram_prefetch = experiment_proto.dram_prefetch();
+            experiment.dram_compression = experiment_proto.dram_compression().empty() ? "None" :
+                    experiment_proto.dram_compression();
+
+            const auto &compression = experiment.dram_compression;
+            if (compression != "None" && compression != "ZeroRLE" && compression != "Bitmask" && compression != "CSR")
+                throw std::runtime_error("DRAM compression needs to be <None|ZeroRLE|Bitmask|CSR>.");
+
+            experiment.dram_packing = experiment_proto.dram_packing().empty() ? "None" :
+                    experiment_proto.dram_packing();
+
+            const auto &packing = experiment.dram_packing;
+            if (packing != "None" && packing != "Static" && packing != "Dynamic")
+                throw std::runtime_error("DRAM packing needs to be <None|Static|Dynamic>.");
+
+            experiment.dram_layout = experiment_proto.dram_layout().empty() ? "NHWC" : experiment_proto.dram_layout();
+
+            const auto &layout = experiment.dram_layout;
+            if (layout != "NHWC" && layout != "NCHW" && layout != "NCHWc" && layout != "Auto")
+                throw std::runtime_error("DRAM layout needs to be <NHWC|NCHW|NCHWc|Auto>.");
+            if (layout == "Auto" && backend != "Bank")
+                throw std::runtime_error("DRAM layout Auto aligns to the rows of the Bank backend, it needs "
+                                         "dram_backend Bank.");
+
+            experiment.dram_wgt_backend = experiment_proto.dram_wgt_backend();
+            const auto &wgt_backend = experiment.dram_wgt_backend;
+            if (!wgt_backend.empty() && wgt_backend != "DRAMSim2" && wgt_backend != "Ideal" &&
+                    wgt_backend != "Fixed" && wgt_backend != "Bank")
+                throw std::runtime_error("DRAM weight backend needs to be <DRAMSim2|Ideal|Fixed|Bank>.");
+
+            experiment.dram_wgt_conf = experiment_proto.dram_wgt_conf().empty() ? experiment.dram_conf :
+                    "ini/" + experiment_proto.dram_wgt_conf() + ".ini";
+            experiment.dram_wgt_latency = experiment_proto.dram_wgt_latency() < 1 ? experiment.dram_latency :
+                    experiment_proto.dram_wgt_latency();
+            experiment.dram_wgt_bandwidth = experiment_proto.dram_wgt_bandwidth() <= 0 ? experiment.dram_bandwidth :
+                    experiment_proto.dram_wgt_bandwidth();
+            experiment.dram_act_burst = experiment_proto.dram_act_burst() < 1 ? 16 :
+                    experiment_proto.dram_act_burst();
+            experiment.dram_wgt_burst = experiment_proto.dram_wgt_burst() < 1 ? 16 :
+                    experiment_proto.dram_wgt_burst();
+
             auto dram_range = log2(experiment.dram_size * pow(2, 20));
 
             auto dram_act_addr_range = log2(experiment.dram_start_act_address);
@@ -204,15 +272,15 @@ namespace sys {
                     experiment_proto.gbuffer_act_eviction_policy();
 
             const auto &act_policy = experiment.gbuffer_act_eviction_policy;
-            if (act_policy != "LRU" && act_policy != "FIFO")
-                throw std::runtime_error("Global Buffer activation eviction policy needs to be <LRU|FIFO>.");
+            if (act_policy != "LRU" && act_policy != "FIFO" && act_policy != "OPT")
+                throw std::runtime_error("Global Buffer activation eviction policy needs to be <LRU|FIFO|OPT>.");
 
             experiment.gbuffer_wgt_eviction_policy = experiment_proto.gbuffer_wgt_eviction_policy().empty() ? "LRU" :
                     experiment_proto.gbuffer_wgt_eviction_policy();
 
             const auto &wgt_policy = experiment.gbuffer_wgt_eviction_policy;
-            if (act_policy != "LRU" && act_policy != "FIFO")
-                throw std::runtime_error("Global Buffer weight eviction policy needs to be <LRU|FIFO>.");
+            if (wgt_policy != "LRU" && wgt_policy != "FIFO" && wgt_policy != "OPT")
+                throw std::runtime_error("Global Buffer weight eviction policy needs to be <LRU|FIFO|OPT>.");
 
             experiment.abuffer_rows = experiment_proto.abuffer_rows() < 1 ? 2 :
                     experiment_proto.abuffer_rows();
@@ -241,6 +309,27 @@ namespace sys {
 
             experiment.ppu_inputs = experiment_proto.ppu_inputs() < 1 ? 256 : experiment_proto.ppu_inputs();
             experiment.ppu_delay = experiment_proto.ppu_delay() < 1 ? 1 : experiment_proto.ppu_delay();
+            experiment.ppu_stream_writes = experiment_proto.ppu_stream_writes();
+
+            experiment.sampling = experiment_proto.sampling().empty() ? "None" : experiment_proto.sampling();
+            experiment.sampling_rate = experiment_proto.sampling_rate() <= 0 ? 0.1 : experiment_proto.sampling_rate();
+            experiment.sampling_confidence = experiment_proto.sampling_confidence() <= 0 ? 0.95 :
+                    experiment_proto.sampling_confidence();
+
+            const auto &sampling = experiment.sampling;
+            if (sampling != "None" && sampling != "Random" && sampling != "Stratified")
+                throw std::runtime_error("Sampling needs to be <None|Random|Stratified>.");
+
+            if (experiment.sampling_rate > 1)
+                throw std::runtime_error("Sampling rate needs to be between 0 and 1.");
+
+            if (experiment.sampling_confidence >= 1)
+                throw std::runtime_error("Sampling confidence needs to be between 0 and 1.");
+
+            if (sampling != "None" && (act_policy == "OPT" || wgt_policy == "OPT"))
+                throw std::runtime_error("Global Buffer OPT eviction policy can not be used with sampling.");
+
+            experiment.mapping_search = experiment_proto.mapping_search();
 
             // Generic parameters
             experiment.lanes = experiment_proto.lanes() < 1 ? 16 : experiment_proto.lanes();
@@ -4,6 +4,48 @@
 
 namespace sys {
 
+    /* Inverse of the standard normal CDF (Acklam's rational approximation) */
+    static double normal_quantile(double p) {
+        static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+        static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                6.680131188771972e+01, -1.328068155288572e+01};
+        static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+        static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                3.754408661907416e+00};
+
+        if (p < 0.02425) {
+            double q = sqrt(-2 * log(p));
+            return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                    ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        } else if (p > 1 - 0.02425) {
+            double q = sqrt(-2 * log(1 - p));
+            return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                    ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        } else {
+            double q = p - 0.5;
+            double r = q * q;
+            return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+                    (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+        }
+    }
+
+    double get_t_value(double confidence, uint64_t dof) {
+        if (confidence <= 0 || confidence >= 1)
+            throw std::runtime_error("Confidence level must be between 0 and 1.");
+
+        double z = normal_quantile(1 - (1 - confidence) / 2.);
+        if (dof == 0) return z;
+
+        // Cornish-Fisher expansion of the t quantile around the normal one
+        double v = dof;
+        double z2 = z * z, z3 = z2 * z, z5 = z3 * z2, z7 = z5 * z2, z9 = z7 * z2;
+        return z + (z3 + z) / (4 * v) + (5 * z5 + 16 * z3 + 3 * z) / (96 * v * v) +
+                (3 * z7 + 19 * z5 + 17 * z3 - 15 * z) / (384 * v * v * v) +
+                (79 * z9 + 776 * z7 + 1482 * z5 - 1920 * z3 - 945 * z) / (92160 * v * v * v * v);
+    }
+
     //stat_base_t
 
     stat_base_t::stat_base_t() : measure(No_Measure), special_value(0.0), skip_first(false) {}
@@ -38,6 +80,11 @@ namespace sys {
         throw std::runtime_error("Wrong stat type");
     }
 
+    void stat_string_t::resize(uint64_t _batch_size) {
+        for (auto &layer : value)
+            layer.resize(_batch_size);
+    }
+
     // stat_uint_t
 
     stat_uint_t::stat_uint_t(uint64_t _layers, uint64_t _batch_size, uint64_t _value, Measure _measure,
@@ -83,6 +130,11 @@ namespace sys {
         throw std::runtime_error("Wrong stat type");
     }
 
+    void stat_uint_t::resize(uint64_t _batch_size) {
+        for (auto &layer : value)
+            layer.resize(_batch_size);
+    }
+
     // stat_double_t
 
     stat_double_t::stat_double_t(uint64_t _layers, uint64_t _batch_size, double _value, Measure _measure,
@@ -128,6 +180,11 @@ namespace sys {
         throw std::runtime_error("Wrong stat type");
     }
 
+    void stat_double_t::resize(uint64_t _batch_size) {
+        for (auto &layer : value)
+            layer.resize(_batch_size);
+    }
+
     // stat_uint_dist_t
 
     stat_uint_dist_t::stat_uint_dist_t() : min_range(0), max_range(0) {}
@@ -198,6 +255,12 @@ namespace sys {
         return line;
     }
 
+    void stat_uint_dist_t::resize(uint64_t _batch_size) {
+        for (auto &_value : value)
+            for (auto &layer : _value)
+                layer.resize(_batch_size);
+    }
+
     // stat_double_dist_t
 
     stat_double_dist_t::stat_double_dist_t() : min_range(0), max_range(0) {}
@@ -267,6 +330,12 @@ namespace sys {
         return line;
     }
 
+    void stat_double_dist_t::resize(uint64_t _batch_size) {
+        for (auto &_value : value)
+            for (auto &layer : _value)
+                layer.resize(_batch_size);
+    }
+
     // Stats
 
     Stats::Stats(uint64_t _layers, uint64_t _batch_size, const std::string &_filename) : layers(_layers),
@@ -332,8 +401,19 @@ namespace sys {
         return std::dynamic_pointer_cast<stat_double_dist_t>(table.var);
     }
 
+    void Stats::resize(uint64_t _batch_size) {
+        batch_size = _batch_size;
+        for (auto &table : database)
+            table.var->resize(_batch_size);
+    }
+
     void Stats::dump_csv(const std::string &network_name, const std::vector<std::string> &layers_name,
             const std::string &header, bool QUIET) {
+        dump_csv(network_name, layers_name, header, "", QUIET);
+    }
+
+    void Stats::dump_csv(const std::string &network_name, const std::vector<std::string> &layers_name,
+            const std::string &header, const std::string &folder, bool QUIET) {
 
         std::ofstream o_file;
 
@@ -351,7 +431,18 @@ namespace sys {
                 throw std::runtime_error("Error creating folder results/" + network_name);
         }
 
-        std::string path = "results/" + network_name + "/" + filename + ".csv";
+        std::string results_path = "results/" + network_name;
+        if (!folder.empty()) {
+            results_path += "/" + folder;
+            try {
+                check_path(results_path);
+            } catch (const std::exception &exception) {
+                if (mkdir(results_path.c_str(), 0775) == -1)
+                    throw std::runtime_error("Error creating folder " + results_path);
+            }
+        }
+
+        std::string path = results_path + "/" + filename + ".csv";
         o_file.open (path);
 
         o_file << std::endl << header << std::endl;